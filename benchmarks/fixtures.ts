@@ -0,0 +1,60 @@
+/**
+ * Headless engine pieces for benchmarks: a Three.js scene, a renderer stand-in that only creates
+ * materials, and entity builders. No WebGL context and no physics world.
+ */
+import * as THREE from 'three';
+import { EntityManager } from '@/game/ecs/EntityManager';
+import { Entity } from '@/game/ecs/Entity';
+import { TransformComponent } from '@/game/ecs/components/TransformComponent';
+import { MeshRendererComponent } from '@/game/ecs/components/MeshRendererComponent';
+import { LightComponent } from '@/game/ecs/components/LightComponent';
+import type { RetroRenderer } from '@/game/renderer/RetroRenderer';
+import type { PhysicsWorld } from '@/game/physics/PhysicsWorld';
+
+export const headlessRenderer = {
+  createRetroStandardMaterial: (color: number) => new THREE.MeshLambertMaterial({ color }),
+} as unknown as RetroRenderer;
+
+export const noPhysics = null as unknown as PhysicsWorld;
+
+export function createEntityManager(): EntityManager {
+  return new EntityManager(new THREE.Scene(), headlessRenderer, noPhysics);
+}
+
+/**
+ * Deterministic pseudo-random numbers (mulberry32), so every run builds the same scene
+ */
+export function createRandom(seed: number = 1): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * Entities with mixed components: every entity has a transform, ~70% a mesh, ~5% a point light,
+ * the rest are empty transforms (spawn points, markers)
+ */
+export function populate(entityManager: EntityManager, count: number, seed: number = 1): Entity[] {
+  const random = createRandom(seed);
+  return entityManager.batch(() => {
+    const entities = entityManager.createEntities(Array.from({ length: count }, (_, i) => `Entity_${i}`));
+    entities.forEach((entity) => {
+      const position = new THREE.Vector3((random() - 0.5) * 200, random() * 10, (random() - 0.5) * 200);
+      entityManager.addComponent(entity, new TransformComponent(entity, position, new THREE.Euler(0, random() * Math.PI, 0)));
+
+      const kind = random();
+      if (kind < 0.7) {
+        const geometry = kind < 0.5 ? { type: 'box' as const, width: 1, height: 1, depth: 1 } : { type: 'sphere' as const, radius: 0.5, segments: 8 };
+        entityManager.addComponent(entity, new MeshRendererComponent(entity, geometry, Math.floor(random() * 0xffffff), headlessRenderer));
+      } else if (kind < 0.75) {
+        entityManager.addComponent(entity, new LightComponent(entity, { type: 'point', color: 0xffeedd, intensity: 1, distance: 10 }));
+      }
+    });
+    return entities;
+  });
+}
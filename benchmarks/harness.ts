@@ -0,0 +1,148 @@
+/**
+ * Benchmark harness - registers scenarios, times them and summarises the samples
+ * Each sample times a batch of iterations sized so the batch takes at least MIN_SAMPLE_MS;
+ * sampling continues until both minSamples and minTimeMs are reached.
+ */
+
+export interface BenchmarkOptions {
+  setup?: () => void | Promise<void>; // Before sampling (not timed)
+  teardown?: () => void | Promise<void>;
+  beforeEach?: () => void; // Before each sample (not timed), e.g. to reset state the scenario consumes
+  minSamples?: number;
+  minTimeMs?: number;
+  warmupMs?: number;
+  iterations?: number; // Fixed iterations per sample (scenarios that must not repeat within a sample)
+}
+
+export interface Benchmark {
+  name: string;
+  fn: () => unknown;
+  options: BenchmarkOptions;
+}
+
+export interface BenchmarkStats {
+  samples: number;
+  iterationsPerSample: number;
+  meanMs: number;
+  medianMs: number;
+  stddevMs: number;
+  minMs: number;
+  maxMs: number;
+  p95Ms: number;
+  rme: number; // Relative margin of error of the mean, % (95% confidence)
+  opsPerSec: number;
+}
+
+const MIN_SAMPLE_MS = 5;
+const MAX_SAMPLES = 500;
+const DEFAULT_MIN_SAMPLES = 30;
+const DEFAULT_MIN_TIME_MS = 1000;
+const DEFAULT_WARMUP_MS = 200;
+
+const benchmarks: Benchmark[] = [];
+let currentGroup = '';
+
+/**
+ * Group the benchmarks registered by fn under a name prefix ('ecs/...')
+ */
+export function group(name: string, fn: () => void): void {
+  const previous = currentGroup;
+  currentGroup = previous ? `${previous}/${name}` : name;
+  try {
+    fn();
+  } finally {
+    currentGroup = previous;
+  }
+}
+
+/**
+ * Register a benchmark (fn may return a promise, which is awaited)
+ */
+export function bench(name: string, fn: () => unknown, options: BenchmarkOptions = {}): void {
+  benchmarks.push({ name: currentGroup ? `${currentGroup}/${name}` : name, fn, options });
+}
+
+export function getBenchmarks(): Benchmark[] {
+  return benchmarks;
+}
+
+/**
+ * Run one benchmark and summarise its samples
+ */
+export async function runBenchmark(benchmark: Benchmark): Promise<BenchmarkStats> {
+  const { fn, options } = benchmark;
+  const minSamples = options.minSamples ?? DEFAULT_MIN_SAMPLES;
+  const minTimeMs = options.minTimeMs ?? DEFAULT_MIN_TIME_MS;
+  const warmupMs = options.warmupMs ?? DEFAULT_WARMUP_MS;
+
+  await options.setup?.();
+  try {
+    // Warm up (lets the JIT settle) and estimate the cost of one iteration
+    let warmupIterations = 0;
+    const warmupStart = performance.now();
+    do {
+      options.beforeEach?.();
+      await fn();
+      warmupIterations++;
+    } while (performance.now() - warmupStart < warmupMs);
+    const estimateMs = (performance.now() - warmupStart) / warmupIterations;
+    const iterations = options.iterations ?? Math.max(1, Math.ceil(MIN_SAMPLE_MS / Math.max(estimateMs, 1e-6)));
+
+    collectGarbage();
+    const samples: number[] = [];
+    const start = performance.now();
+    while (samples.length < MAX_SAMPLES && (samples.length < minSamples || performance.now() - start < minTimeMs)) {
+      options.beforeEach?.();
+      const sampleStart = performance.now();
+      for (let i = 0; i < iterations; i++) {
+        await fn();
+      }
+      samples.push((performance.now() - sampleStart) / iterations);
+    }
+
+    return summarize(samples, iterations);
+  } finally {
+    await options.teardown?.();
+    collectGarbage();
+  }
+}
+
+/**
+ * Statistical summary of per-iteration sample times (ms)
+ */
+export function summarize(samples: number[], iterationsPerSample: number): BenchmarkStats {
+  const sorted = [...samples].sort((a, b) => a - b);
+  const n = sorted.length;
+  const mean = sorted.reduce((sum, value) => sum + value, 0) / n;
+  const variance = n > 1 ? sorted.reduce((sum, value) => sum + (value - mean) ** 2, 0) / (n - 1) : 0;
+  const stddev = Math.sqrt(variance);
+  const standardError = stddev / Math.sqrt(n);
+
+  return {
+    samples: n,
+    iterationsPerSample,
+    meanMs: mean,
+    medianMs: quantile(sorted, 0.5),
+    stddevMs: stddev,
+    minMs: sorted[0],
+    maxMs: sorted[n - 1],
+    p95Ms: quantile(sorted, 0.95),
+    rme: mean > 0 ? (1.96 * standardError / mean) * 100 : 0,
+    opsPerSec: mean > 0 ? 1000 / mean : 0,
+  };
+}
+
+function quantile(sorted: number[], q: number): number {
+  const position = (sorted.length - 1) * q;
+  const lower = Math.floor(position);
+  const upper = Math.ceil(position);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+}
+
+/**
+ * Run a full GC between benchmarks when node was started with --expose-gc
+ */
+function collectGarbage(): void {
+  const gc = (globalThis as { gc?: () => void }).gc;
+  gc?.();
+}
@@ -0,0 +1,46 @@
+/**
+ * Module resolution for running the game sources directly in Node (benchmarks)
+ * Mirrors what the Next.js bundler does: the @/ alias, extensionless imports of .ts/.tsx files,
+ * and replaces modules that need a browser (Rapier's WebAssembly build) with stubs.
+ */
+import { statSync } from 'node:fs';
+import { dirname, resolve as resolvePath } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+
+const root = resolvePath(dirname(fileURLToPath(import.meta.url)), '..');
+const src = resolvePath(root, 'src');
+
+const STUBS = {
+  '@dimforge/rapier3d': resolvePath(root, 'benchmarks/stubs/rapier.mjs'),
+};
+
+const SOURCE_SUFFIXES = ['', '.ts', '.tsx', '/index.ts', '/index.tsx'];
+
+function isFile(path) {
+  try {
+    return statSync(path).isFile();
+  } catch {
+    return false;
+  }
+}
+
+export async function resolve(specifier, context, nextResolve) {
+  if (STUBS[specifier]) {
+    return { url: pathToFileURL(STUBS[specifier]).href, shortCircuit: true };
+  }
+
+  let base = null;
+  if (specifier.startsWith('@/')) {
+    base = resolvePath(src, specifier.slice(2));
+  } else if ((specifier.startsWith('./') || specifier.startsWith('../')) && context.parentURL?.startsWith('file:')) {
+    base = resolvePath(dirname(fileURLToPath(context.parentURL)), specifier);
+  }
+
+  if (base) {
+    const file = SOURCE_SUFFIXES.map(suffix => base + suffix).find(isFile);
+    if (file) {
+      return { url: pathToFileURL(file).href, shortCircuit: true };
+    }
+  }
+  return nextResolve(specifier, context);
+}
@@ -0,0 +1,222 @@
+/**
+ * Benchmark runner
+ *   npm run bench                       run every scenario, compare with benchmarks/baseline.json
+ *   npm run bench -- --filter ecs       only scenarios whose name contains "ecs"
+ *   npm run bench:baseline              run and store the results as the new baseline
+ * Options: --baseline <file>, --out <file>, --threshold <fraction> (default 0.1), --no-fail
+ * Results are written to benchmarks/results/latest.json. The process exits with code 1 when a
+ * scenario's median regressed by more than the threshold and beyond its measurement noise, or when
+ * a scenario logged warnings or errors (it may have timed a failure path).
+ */
+import { mkdirSync, readdirSync, readFileSync, writeFileSync, existsSync } from 'node:fs';
+import { cpus } from 'node:os';
+import { dirname, join, resolve } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+import { getBenchmarks, runBenchmark, type BenchmarkStats } from './harness';
+
+const RESULTS_VERSION = 1;
+
+interface BenchmarkResults {
+  version: number;
+  environment: {
+    node: string;
+    platform: string;
+    arch: string;
+    cpu: string;
+  };
+  results: Record<string, BenchmarkStats>;
+}
+
+interface Comparison {
+  name: string;
+  ratio: number; // Current median / baseline median
+  verdict: 'regression' | 'improvement' | 'same';
+}
+
+const benchDir = dirname(fileURLToPath(import.meta.url));
+
+function parseArgs(argv: string[]) {
+  const args = {
+    filter: '',
+    baseline: join(benchDir, 'baseline.json'),
+    out: join(benchDir, 'results', 'latest.json'),
+    threshold: 0.1,
+    saveBaseline: false,
+    fail: true,
+  };
+  for (let i = 0; i < argv.length; i++) {
+    switch (argv[i]) {
+      case '--filter': args.filter = argv[++i] || ''; break;
+      case '--baseline': args.baseline = resolve(argv[++i]); break;
+      case '--out': args.out = resolve(argv[++i]); break;
+      case '--threshold': args.threshold = Number(argv[++i]); break;
+      case '--save-baseline': args.saveBaseline = true; break;
+      case '--no-fail': args.fail = false; break;
+      default:
+        throw new Error(`Unknown option: ${argv[i]}`);
+    }
+  }
+  if (!(args.threshold >= 0)) {
+    throw new Error('--threshold must be a non-negative number');
+  }
+  return args;
+}
+
+async function loadScenarios(): Promise<void> {
+  const scenarioDir = join(benchDir, 'scenarios');
+  const files = readdirSync(scenarioDir).filter(file => file.endsWith('.bench.ts')).sort();
+  for (const file of files) {
+    await import(pathToFileURL(join(scenarioDir, file)).href);
+  }
+}
+
+/**
+ * Warnings and errors logged by the running scenario (counted, not printed)
+ */
+const consoleProblems = { count: 0, first: '' };
+
+/**
+ * Scenario code logs through console - keep the report readable
+ * Warnings and errors are counted instead: a scenario that hits one may be timing a failure path
+ */
+function silenceConsole(): void {
+  const noop = () => {};
+  console.log = noop;
+  console.info = noop;
+  console.debug = noop;
+  const record = (...args: unknown[]) => {
+    if (consoleProblems.count++ === 0) {
+      consoleProblems.first = args.map(arg => (arg instanceof Error ? arg.message : String(arg))).join(' ');
+    }
+  };
+  console.warn = record;
+  console.error = record;
+}
+
+function print(line: string = ''): void {
+  process.stdout.write(line + '\n');
+}
+
+/**
+ * Round to 4 significant digits so result files diff cleanly
+ */
+function roundStats(stats: BenchmarkStats): BenchmarkStats {
+  const round = (value: number) => (value === 0 ? 0 : Number(value.toPrecision(4)));
+  return Object.fromEntries(
+    Object.entries(stats).map(([key, value]) => [key, round(value)])
+  ) as unknown as BenchmarkStats;
+}
+
+function compare(name: string, current: BenchmarkStats, baseline: BenchmarkStats, threshold: number): Comparison {
+  const ratio = current.medianMs / baseline.medianMs;
+  const noise = (current.rme + baseline.rme) / 100;
+  const change = Math.abs(ratio - 1);
+  if (change <= threshold || change <= noise) {
+    return { name, ratio, verdict: 'same' };
+  }
+  return { name, ratio, verdict: ratio > 1 ? 'regression' : 'improvement' };
+}
+
+function formatMs(ms: number): string {
+  if (ms < 0.001) return `${(ms * 1e6).toFixed(1)} ns`;
+  if (ms < 1) return `${(ms * 1000).toFixed(2)} µs`;
+  return `${ms.toFixed(3)} ms`;
+}
+
+async function main(): Promise<void> {
+  const args = parseArgs(process.argv.slice(2));
+  await loadScenarios();
+  const selected = getBenchmarks().filter(benchmark => benchmark.name.includes(args.filter));
+  if (selected.length === 0) {
+    throw new Error(`No benchmark matches '${args.filter}'`);
+  }
+
+  const baseline: BenchmarkResults | null = !args.saveBaseline && existsSync(args.baseline)
+    ? JSON.parse(readFileSync(args.baseline, 'utf-8'))
+    : null;
+
+  silenceConsole();
+  const results: Record<string, BenchmarkStats> = {};
+  const comparisons: Comparison[] = [];
+  const flagged: string[] = []; // Scenarios that logged warnings or errors
+  const nameWidth = Math.max(...selected.map(benchmark => benchmark.name.length));
+
+  for (const benchmark of selected) {
+    consoleProblems.count = 0;
+    const stats = roundStats(await runBenchmark(benchmark));
+    results[benchmark.name] = stats;
+
+    let versus = '';
+    const previous = baseline?.results[benchmark.name];
+    if (previous) {
+      const comparison = compare(benchmark.name, stats, previous, args.threshold);
+      comparisons.push(comparison);
+      const percent = `${comparison.ratio >= 1 ? '+' : ''}${((comparison.ratio - 1) * 100).toFixed(1)}%`;
+      versus = comparison.verdict === 'same' ? `  ${percent}` : `  ${percent} ${comparison.verdict.toUpperCase()}`;
+    }
+    print(
+      `${benchmark.name.padEnd(nameWidth)}  ${formatMs(stats.medianMs).padStart(11)}  ±${stats.rme.toFixed(1).padStart(4)}%` +
+      `  ${Math.round(stats.opsPerSec).toLocaleString('en-US').padStart(12)} ops/s${versus}`
+    );
+    if (consoleProblems.count > 0) {
+      flagged.push(benchmark.name);
+      print(`  ${consoleProblems.count} warning(s)/error(s) logged, first: ${consoleProblems.first}`);
+    }
+  }
+  if (flagged.length > 0) {
+    print();
+    print(`${flagged.length} scenario(s) logged warnings or errors - their timings may not measure the intended work: ${flagged.join(', ')}`);
+    if (args.fail) process.exitCode = 1;
+  }
+
+  const output: BenchmarkResults = {
+    version: RESULTS_VERSION,
+    environment: {
+      node: process.version,
+      platform: process.platform,
+      arch: process.arch,
+      cpu: cpus()[0]?.model || 'unknown',
+    },
+    // Sorted so files from different runs diff line by line
+    results: Object.fromEntries(Object.keys(results).sort().map(name => [name, results[name]])),
+  };
+  const json = JSON.stringify(output, null, 2) + '\n';
+  mkdirSync(dirname(args.out), { recursive: true });
+  writeFileSync(args.out, json);
+  print();
+  print(`Results written to ${args.out}`);
+
+  if (args.saveBaseline) {
+    if (existsSync(args.baseline)) {
+      // Keep scenarios that were filtered out of this run
+      const existing: BenchmarkResults = JSON.parse(readFileSync(args.baseline, 'utf-8'));
+      output.results = Object.fromEntries(
+        Object.entries({ ...existing.results, ...output.results }).sort(([a], [b]) => a.localeCompare(b))
+      );
+    }
+    writeFileSync(args.baseline, JSON.stringify(output, null, 2) + '\n');
+    print(`Baseline saved to ${args.baseline}`);
+    return;
+  }
+
+  if (!baseline) {
+    print(`No baseline at ${args.baseline} (create one with npm run bench:baseline)`);
+    return;
+  }
+  if (baseline.environment.cpu !== output.environment.cpu || baseline.environment.node !== output.environment.node) {
+    print(`Baseline was recorded on ${baseline.environment.cpu} / node ${baseline.environment.node} - comparisons may not be meaningful`);
+  }
+
+  const regressions = comparisons.filter(comparison => comparison.verdict === 'regression');
+  if (regressions.length > 0) {
+    print(`${regressions.length} regression(s) beyond ${(args.threshold * 100).toFixed(0)}%: ${regressions.map(r => r.name).join(', ')}`);
+    if (args.fail) process.exitCode = 1;
+  } else {
+    print(`No regressions beyond ${(args.threshold * 100).toFixed(0)}% against the baseline`);
+  }
+}
+
+main().catch((error) => {
+  process.stderr.write(`${error instanceof Error ? error.stack : error}\n`);
+  process.exit(1);
+});
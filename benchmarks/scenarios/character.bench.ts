@@ -0,0 +1,20 @@
+import { bench, group } from '../harness';
+import { CharacterSheetManager } from '@/game/character/CharacterSheetManager';
+import { Competence } from '@/game/character/data/CompetenceData';
+
+group('character', () => {
+  let manager: CharacterSheetManager;
+  const setup = () => {
+    manager = new CharacterSheetManager();
+  };
+
+  bench('CharacterSheetManager.getState', () => manager.getState(), { setup });
+
+  // Marks accumulate until a competence levels up, so start every sample from a fresh sheet
+  const active = [Competence.ARME, Competence.DESARME, Competence.IMPROVISE, Competence.VISION];
+  bench('distributeMarksToActiveCompetences x1000', () => {
+    for (let i = 0; i < 1000; i++) {
+      manager.distributeMarksToActiveCompetences(active.slice(0, 1 + (i % active.length)), 1);
+    }
+  }, { setup, beforeEach: setup, iterations: 1 });
+});
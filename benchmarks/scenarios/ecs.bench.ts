@@ -0,0 +1,26 @@
+import { bench, group } from '../harness';
+import { createEntityManager, populate } from '../fixtures';
+import type { EntityManager } from '@/game/ecs/EntityManager';
+
+group('ecs', () => {
+  [1000, 10000, 50000].forEach((count) => {
+    let entityManager: EntityManager;
+    bench(`EntityManager.update ${count}`, () => entityManager.update(1 / 60), {
+      setup: () => {
+        entityManager = createEntityManager();
+        populate(entityManager, count);
+      },
+      teardown: () => entityManager.clearAll(),
+    });
+  });
+
+  let entityManager: EntityManager;
+  bench('populate + clear 1000', () => {
+    populate(entityManager, 1000);
+    entityManager.clearAll();
+  }, {
+    setup: () => {
+      entityManager = createEntityManager();
+    },
+  });
+});
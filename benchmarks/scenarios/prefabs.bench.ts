@@ -0,0 +1,67 @@
+import { bench, group } from '../harness';
+import { createEntityManager, createRandom, headlessRenderer, populate } from '../fixtures';
+import { PrefabManager } from '@/game/ecs/prefab/PrefabManager';
+import { LightComponent } from '@/game/ecs/components/LightComponent';
+import type { EntityManager } from '@/game/ecs/EntityManager';
+import type { Entity } from '@/game/ecs/Entity';
+
+const INSTANCE_COUNT = 1000;
+
+group('prefabs', () => {
+  let entityManager: EntityManager;
+  let prefabManager: PrefabManager;
+  let prefabId: string;
+  const random = createRandom(7);
+  const positions = Array.from({ length: INSTANCE_COUNT }, () => ({ x: random() * 100, y: 0, z: random() * 100 }));
+
+  const setup = () => {
+    entityManager = createEntityManager();
+    prefabManager = new PrefabManager();
+    prefabManager.setFactoryContext({ renderer: headlessRenderer });
+    const [template] = populate(entityManager, 1, 3);
+    prefabId = prefabManager.createPrefab('Bench', template, entityManager).id;
+    entityManager.clearAll();
+  };
+  const options = {
+    setup,
+    teardown: () => entityManager.clearAll(),
+    beforeEach: () => entityManager.clearAll(),
+    iterations: 1, // Instances accumulate - start each sample from an empty scene
+  };
+
+  bench(`PrefabManager.instantiatePrefab x${INSTANCE_COUNT}`, () => {
+    positions.forEach(position => prefabManager.instantiatePrefab(prefabId, entityManager, headlessRenderer, null, position));
+  }, options);
+
+  bench(`PrefabManager.instantiatePrefabs ${INSTANCE_COUNT}`, () => {
+    prefabManager.instantiatePrefabs(prefabId, entityManager, positions, headlessRenderer);
+  }, options);
+
+  // Editing a prefab: one instance is changed (a light added or removed) and pushed to the others
+  let edited: Entity;
+  let instances: Entity[];
+  const toggleLight = () => {
+    if (entityManager.getComponent(edited, 'LightComponent')) {
+      entityManager.removeComponent(edited, 'LightComponent');
+    } else {
+      entityManager.addComponent(edited, new LightComponent(edited, { type: 'point', color: 0xffeedd, intensity: 1, distance: 10 }));
+    }
+    prefabManager.updatePrefab(prefabId, edited, entityManager);
+    return prefabManager.flushPropagation(entityManager);
+  };
+
+  bench(`PrefabManager.updatePrefab + flushPropagation ${INSTANCE_COUNT}`, toggleLight, {
+    setup: () => {
+      setup();
+      instances = prefabManager.instantiatePrefabs(prefabId, entityManager, positions, headlessRenderer);
+      edited = instances[0];
+      // Not a benchmark if the edit does not reach the instances
+      const updated = toggleLight();
+      const missing = instances.filter(entity => !entityManager.getComponent(entity, 'LightComponent')).length;
+      if (updated !== INSTANCE_COUNT - 1 || missing > 0) {
+        throw new Error(`Prefab edit reached ${updated} of ${INSTANCE_COUNT - 1} instances (${missing} without the new light)`);
+      }
+    },
+    teardown: () => entityManager.clearAll(),
+  });
+});
@@ -0,0 +1,41 @@
+import { bench, group } from '../harness';
+import { createEntityManager, headlessRenderer, populate } from '../fixtures';
+import { SceneSerializer, type SerializedScene } from '@/game/ecs/serialization/SceneSerializer';
+import { BinarySceneDecoder, BinarySceneEncoder } from '@/game/ecs/serialization/BinarySceneFormat';
+import type { EntityManager } from '@/game/ecs/EntityManager';
+
+const ENTITY_COUNT = 10000;
+
+group('serialization', () => {
+  let source: EntityManager;
+  let target: EntityManager;
+  let scene: SerializedScene;
+  let binary: Uint8Array;
+
+  const setup = () => {
+    source = createEntityManager();
+    populate(source, ENTITY_COUNT);
+    scene = SceneSerializer.serialize(source, 'Benchmark');
+    binary = BinarySceneEncoder.encode(scene);
+    target = createEntityManager();
+  };
+  const teardown = () => {
+    source.clearAll();
+    target.clearAll();
+  };
+
+  bench(`SceneSerializer.serialize ${ENTITY_COUNT}`, () => SceneSerializer.serialize(source, 'Benchmark'), { setup, teardown });
+
+  bench(`SceneSerializer.deserializeEntities ${ENTITY_COUNT}`, () => {
+    SceneSerializer.deserializeEntities(target, scene.entities, { renderer: headlessRenderer });
+  }, {
+    setup,
+    teardown,
+    beforeEach: () => target.clearAll(),
+    iterations: 1, // Each iteration needs an empty entity manager
+  });
+
+  bench(`BinarySceneEncoder.encode ${ENTITY_COUNT}`, () => BinarySceneEncoder.encode(scene), { setup, teardown });
+  bench(`BinarySceneDecoder.decode ${ENTITY_COUNT}`, () => BinarySceneDecoder.decode(binary), { setup, teardown });
+  bench(`JSON.stringify ${ENTITY_COUNT}`, () => JSON.stringify(scene), { setup, teardown });
+});
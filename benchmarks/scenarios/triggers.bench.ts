@@ -0,0 +1,39 @@
+import { bench, group } from '../harness';
+import { Entity } from '@/game/ecs/Entity';
+import { TriggerComponent } from '@/game/ecs/components/TriggerComponent';
+import type { IScript } from '@/game/scripts/types';
+import type { ScriptLoader } from '@/game/scripts/ScriptLoader';
+
+const TRIGGER_COUNT = 1000;
+
+group('triggers', () => {
+  let triggers: TriggerComponent[] = [];
+  let fired = 0;
+  const script: IScript = {
+    onEnter: () => {
+      fired++;
+    },
+  };
+  // Scripts resolve immediately, as they do once the loader's cache is warm
+  const scriptLoader = { loadScript: async () => script } as unknown as ScriptLoader;
+
+  bench(`TriggerComponent.handleTrigger x${TRIGGER_COUNT}`, async () => {
+    for (const trigger of triggers) {
+      await trigger.handleTrigger('onEnter', 'player');
+    }
+  }, {
+    setup: async () => {
+      triggers = Array.from({ length: TRIGGER_COUNT }, (_, i) => new TriggerComponent(
+        new Entity(`Trigger_${i}`),
+        { shape: 'box', action: 'script', eventType: 'onEnter', actionData: { scriptPath: 'scripts/triggers/bench' } },
+        undefined,
+        scriptLoader
+      ));
+      // Let the scripts finish loading (started by the constructor)
+      await new Promise(resolve => setTimeout(resolve, 0));
+    },
+    teardown: () => {
+      if (fired === 0) throw new Error('Trigger scripts never ran');
+    },
+  });
+});
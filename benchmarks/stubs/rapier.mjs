@@ -0,0 +1,12 @@
+/**
+ * Stand-in for @dimforge/rapier3d (its WebAssembly build only loads through the bundler)
+ * Importing modules that reference Rapier works; using it fails loudly. Scenarios create
+ * entities without physics.
+ */
+const RAPIER = new Proxy({}, {
+  get(_target, name) {
+    throw new Error(`Rapier is not available in benchmarks (RAPIER.${String(name)})`);
+  },
+});
+
+export default RAPIER;
@@ -1,7 +1,20 @@
+// Log levels (see src/game/utils/debug.ts) - levels below DRD_LOG_LEVEL are compiled out
+const LOG_LEVELS = { trace: 0, debug: 1, info: 2, warn: 3, error: 4, off: 5 };
+
+// List the game's script modules for ScriptLoader (see tools/scriptManifest.js)
+require('./tools/scriptManifest').writeScriptManifest();
+
 /** @type {import('next').NextConfig} */
 const nextConfig = {
   reactStrictMode: true,
-  webpack: (config, { isServer }) => {
+  webpack: (config, { isServer, dev, webpack }) => {
+    // Build-time logging configuration, folded into constants so disabled logging is removed by the minifier
+    const logLevel = LOG_LEVELS[(process.env.DRD_LOG_LEVEL || '').toLowerCase()] ?? (dev ? LOG_LEVELS.debug : LOG_LEVELS.warn);
+    config.plugins.push(new webpack.DefinePlugin({
+      __DRD_LOG_LEVEL__: JSON.stringify(logLevel),
+      __DRD_LOG_CATEGORIES__: JSON.stringify(process.env.DRD_LOG_CATEGORIES || ''),
+    }));
+
     // Only enable WebAssembly on client side (browser)
     if (!isServer) {
       // Enable WebAssembly support for Rapier
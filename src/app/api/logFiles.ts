@@ -0,0 +1,18 @@
+import { mkdir } from 'fs/promises';
+import { join } from 'path';
+
+/**
+ * Session IDs end up in file names - keep them to safe characters
+ */
+export function sessionFileName(session: string | null, fallback: string): string {
+  return (session || fallback).replace(/[^\w-]/g, '-');
+}
+
+/**
+ * The project's logs folder (created on first use)
+ */
+export async function logsDirectory(): Promise<string> {
+  const logsDir = join(process.cwd(), 'logs');
+  await mkdir(logsDir, { recursive: true });
+  return logsDir;
+}
@@ -0,0 +1,114 @@
+import { NextRequest, NextResponse } from 'next/server';
+import { appendFile } from 'fs/promises';
+import { join } from 'path';
+import type { MetricsSnapshot } from '@/game/utils/Metrics';
+import { logsDirectory, sessionFileName } from '../logFiles';
+
+const MAX_SESSIONS = 16; // Latest snapshots kept in memory
+const DEFAULT_SESSION = 'default';
+
+// Latest snapshot per session (most recently updated last)
+const latest: Map<string, MetricsSnapshot> = new Map();
+
+/**
+ * API route exporting game metrics
+ * POST /api/metrics?session=<id> with a metrics snapshot (see Metrics.push) - kept as the session's
+ * latest snapshot and appended to logs/metrics-<session>.jsonl
+ * GET /api/metrics[?session=<id>] returns the latest snapshots as JSON, or in the Prometheus text
+ * format with &format=prometheus
+ */
+export async function POST(request: NextRequest) {
+  try {
+    const snapshot: MetricsSnapshot = await request.json();
+    if (!snapshot.counters || !snapshot.gauges || !snapshot.histograms) {
+      return NextResponse.json(
+        { error: 'Invalid request: counters, gauges and histograms are required' },
+        { status: 400 }
+      );
+    }
+
+    const session = sessionFileName(request.nextUrl.searchParams.get('session'), DEFAULT_SESSION);
+    latest.delete(session);
+    latest.set(session, snapshot);
+    if (latest.size > MAX_SESSIONS) {
+      latest.delete(latest.keys().next().value!);
+    }
+
+    const logsDir = await logsDirectory();
+    const filename = `metrics-${session}.jsonl`;
+    await appendFile(join(logsDir, filename), JSON.stringify(snapshot) + '\n', 'utf-8');
+
+    return NextResponse.json({ success: true, filename });
+  } catch (error) {
+    console.error('Error saving metrics:', error);
+    return NextResponse.json(
+      {
+        error: 'Failed to save metrics',
+        message: error instanceof Error ? error.message : 'Unknown error',
+      },
+      { status: 500 }
+    );
+  }
+}
+
+export async function GET(request: NextRequest) {
+  const session = request.nextUrl.searchParams.get('session');
+  const sessions = Array.from(latest.entries()).filter(([name]) => !session || name === sessionFileName(session, DEFAULT_SESSION));
+
+  if (request.nextUrl.searchParams.get('format') === 'prometheus') {
+    const text = toPrometheus(sessions);
+    return new NextResponse(text, { headers: { 'Content-Type': 'text/plain; version=0.0.4' } });
+  }
+  return NextResponse.json(Object.fromEntries(sessions));
+}
+
+/**
+ * Prometheus text exposition (histograms as summaries with their quantiles)
+ * Each metric family is written once - header, then one sample per session (session label).
+ */
+function toPrometheus(sessions: Array<[string, MetricsSnapshot]>): string {
+  const families: Map<string, { type: string; help?: string; samples: string[] }> = new Map();
+  const family = (name: string, metric: string, type: string, snapshot: MetricsSnapshot) => {
+    let entry = families.get(metric);
+    if (!entry) {
+      entry = { type, samples: [] };
+      families.set(metric, entry);
+    }
+    entry.help = entry.help || snapshot.help[name];
+    return entry.samples;
+  };
+
+  sessions.forEach(([session, snapshot]) => {
+    const label = `session="${session}"`;
+    Object.entries(snapshot.counters).forEach(([name, value]) => {
+      const metric = `drd_${metricName(name)}_total`;
+      family(name, metric, 'counter', snapshot).push(`${metric}{${label}} ${value}`);
+    });
+    Object.entries(snapshot.gauges).forEach(([name, value]) => {
+      const metric = `drd_${metricName(name)}`;
+      family(name, metric, 'gauge', snapshot).push(`${metric}{${label}} ${value}`);
+    });
+    Object.entries(snapshot.histograms).forEach(([name, histogram]) => {
+      const metric = `drd_${metricName(name)}`;
+      family(name, metric, 'summary', snapshot).push(
+        `${metric}{${label},quantile="0.5"} ${histogram.p50}`,
+        `${metric}{${label},quantile="0.9"} ${histogram.p90}`,
+        `${metric}{${label},quantile="0.99"} ${histogram.p99}`,
+        `${metric}_sum{${label}} ${histogram.sum}`,
+        `${metric}_count{${label}} ${histogram.count}`,
+      );
+    });
+  });
+
+  const lines: string[] = [];
+  families.forEach(({ type, help, samples }, metric) => {
+    if (help) lines.push(`# HELP ${metric} ${help}`);
+    lines.push(`# TYPE ${metric} ${type}`);
+    lines.push(...samples);
+  });
+  return lines.length > 0 ? lines.join('\n') + '\n' : '';
+}
+
+function metricName(name: string): string {
+  return name.replace(/[^a-zA-Z0-9_]/g, '_');
+}
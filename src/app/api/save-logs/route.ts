@@ -1,64 +1,92 @@
 import { NextRequest, NextResponse } from 'next/server';
-import { writeFile, appendFile, mkdir, access } from 'fs/promises';
+import { createWriteStream, existsSync, type WriteStream } from 'fs';
+import { writeFile } from 'fs/promises';
 import { join } from 'path';
-import { constants } from 'fs';
+import { gunzip } from 'zlib';
+import { promisify } from 'util';
+import { decodeLogBatch } from '@/game/utils/LogBatchFormat';
+import { logsDirectory, sessionFileName } from '../logFiles';
+
+interface SessionLog {
+  stream: WriteStream;
+  filename: string;
+  filepath: string;
+  lastWrite: number;
+}
+
+const gunzipAsync = promisify(gunzip);
+const STREAM_IDLE_MS = 5 * 60 * 1000; // Close a session's stream after 5 minutes without logs
+
+// One append stream per session, kept open across requests
+const sessions: Map<string, SessionLog> = new Map();
+let idleSweep: ReturnType<typeof setInterval> | null = null;
 
 /**
  * API route to save game logs to a file in the project folder
- * POST /api/save-logs
- * Supports appending to existing file for periodic auto-saves
+ * POST /api/save-logs?session=<id>[&encoding=gzip] with a binary log batch (see LogBatchFormat)
+ * POST /api/save-logs with JSON { logs, sessionStartTime } is still accepted
+ * Each session appends to its own file through one open write stream.
+ * POST /api/save-logs?kind=trace&session=<id> with Chrome trace JSON (see Tracer) writes a trace file
  */
 export async function POST(request: NextRequest) {
   try {
-    const body = await request.json();
-    const { logs, append = false, sessionStartTime } = body;
-
-    if (!logs || !Array.isArray(logs)) {
-      return NextResponse.json(
-        { error: 'Invalid request: logs array is required' },
-        { status: 400 }
-      );
+    if (request.nextUrl.searchParams.get('kind') === 'trace') {
+      return await saveTrace(request);
     }
 
-    // Create logs directory in project root if it doesn't exist
-    const logsDir = join(process.cwd(), 'logs');
-    try {
-      await mkdir(logsDir, { recursive: true });
-    } catch (error) {
-      // Directory might already exist, that's fine
-    }
+    let lines: string[];
+    let session: string | null;
+    let dropped = 0;
 
-    // Create filename - use sessionStartTime if provided (for append mode), otherwise use current timestamp
-    const timestamp = sessionStartTime || new Date().toISOString().replace(/[:.]/g, '-');
-    const filename = `game-logs-${timestamp}.txt`;
-    const filepath = join(logsDir, filename);
-
-    let fileExists = false;
-    try {
-      await access(filepath, constants.F_OK);
-      fileExists = true;
-    } catch {
-      // File doesn't exist yet
+    if (request.headers.get('content-type')?.includes('application/json')) {
+      const body = await request.json();
+      if (!body.logs || !Array.isArray(body.logs)) {
+        return NextResponse.json(
+          { error: 'Invalid request: logs array is required' },
+          { status: 400 }
+        );
+      }
+      lines = body.logs;
+      session = body.sessionStartTime || null;
+    } else {
+      session = request.nextUrl.searchParams.get('session');
+      let bytes: Uint8Array = new Uint8Array(await request.arrayBuffer());
+      if (request.nextUrl.searchParams.get('encoding') === 'gzip') {
+        bytes = await gunzipAsync(bytes);
+      }
+      const batch = decodeLogBatch(bytes);
+      lines = batch.records.map(record => record.text);
+      dropped = batch.dropped;
     }
 
-    if (append && fileExists) {
-      // Append mode: just append new logs
-      const content = logs.join('\n') + '\n';
-      await appendFile(filepath, content, 'utf-8');
-    } else {
-      // Create new file or overwrite with header
-      const header = `=== Game Logs ===\nGenerated: ${new Date().toISOString()}\nSession Start: ${sessionStartTime || new Date().toISOString()}\nTotal Logs: ${logs.length}\n\n`;
-      const content = header + logs.join('\n');
-      await writeFile(filepath, content, 'utf-8');
+    const log = await openSession(session);
+    if (dropped > 0) {
+      lines.push(`[${new Date().toISOString()}] [WARN] [save-logs] ${dropped} log entries dropped by the client (backpressure)`);
     }
+    if (lines.length > 0 && !log.stream.write(lines.join('\n') + '\n')) {
+      // Let the file catch up before accepting more (a failed stream rejects - the client resends)
+      await new Promise<void>((resolve, reject) => {
+        const onDrain = () => {
+          log.stream.off('error', onError);
+          resolve();
+        };
+        const onError = (error: Error) => {
+          log.stream.off('drain', onDrain);
+          reject(error);
+        };
+        log.stream.once('drain', onDrain);
+        log.stream.once('error', onError);
+      });
+    }
+    log.lastWrite = Date.now();
 
     return NextResponse.json({
       success: true,
-      message: append ? `Appended ${logs.length} log entries to ${filename}` : `Logs saved to ${filename}`,
-      filename,
-      path: filepath,
-      logCount: logs.length,
-      appended: append,
+      message: `Appended ${lines.length} log entries to ${log.filename}`,
+      filename: log.filename,
+      path: log.filepath,
+      logCount: lines.length,
+      appended: true,
     });
   } catch (error) {
     console.error('Error saving logs:', error);
@@ -72,3 +100,76 @@ export async function POST(request: NextRequest) {
   }
 }
 
+/**
+ * Write a Chrome trace (one file per save - load it in ui.perfetto.dev or chrome://tracing)
+ */
+async function saveTrace(request: NextRequest) {
+  const trace = await request.json();
+  if (!trace.traceEvents || !Array.isArray(trace.traceEvents)) {
+    return NextResponse.json(
+      { error: 'Invalid request: traceEvents array is required' },
+      { status: 400 }
+    );
+  }
+
+  const session = sessionFileName(request.nextUrl.searchParams.get('session'), new Date().toISOString());
+  const logsDir = await logsDirectory();
+  const filename = `trace-${session}-${Date.now()}.json`;
+  const filepath = join(logsDir, filename);
+  await writeFile(filepath, JSON.stringify(trace), 'utf-8');
+
+  return NextResponse.json({
+    success: true,
+    filename,
+    path: filepath,
+    eventCount: trace.traceEvents.length,
+  });
+}
+
+/**
+ * Get the open log file of a session, creating it (with a header) on first use
+ */
+async function openSession(session: string | null): Promise<SessionLog> {
+  const timestamp = sessionFileName(session, new Date().toISOString());
+  const existing = sessions.get(timestamp);
+  if (existing) return existing;
+
+  const logsDir = await logsDirectory();
+  const opened = sessions.get(timestamp); // By a concurrent request while waiting
+  if (opened) return opened;
+
+  const filename = `game-logs-${timestamp}.txt`;
+  const filepath = join(logsDir, filename);
+  const isNew = !existsSync(filepath);
+  const stream = createWriteStream(filepath, { flags: 'a', encoding: 'utf-8' });
+  stream.on('error', (error) => {
+    console.error(`Error writing ${filename}:`, error);
+    sessions.delete(timestamp);
+  });
+  if (isNew) {
+    stream.write(`=== Game Logs ===\nGenerated: ${new Date().toISOString()}\nSession Start: ${session || timestamp}\n\n`);
+  }
+
+  const log: SessionLog = { stream, filename, filepath, lastWrite: Date.now() };
+  sessions.set(timestamp, log);
+  startIdleSweep();
+  return log;
+}
+
+function startIdleSweep(): void {
+  if (idleSweep) return;
+  idleSweep = setInterval(() => {
+    const now = Date.now();
+    sessions.forEach((log, session) => {
+      if (now - log.lastWrite > STREAM_IDLE_MS) {
+        log.stream.end();
+        sessions.delete(session);
+      }
+    });
+    if (sessions.size === 0 && idleSweep) {
+      clearInterval(idleSweep);
+      idleSweep = null;
+    }
+  }, STREAM_IDLE_MS);
+  idleSweep.unref?.();
+}
@@ -25,6 +25,7 @@ interface CharacterSheetProps {
 /**
  * Custom hook to manage character sheet state updates
  * Simplifies the pattern of manager.setX() + setState(manager.getState())
+ * Also follows changes made elsewhere (game systems, console) - the manager notifies once per frame
  */
 function useCharacterSheet(manager: CharacterSheetManager) {
   const [state, setState] = useState(manager.getState());
@@ -33,6 +34,11 @@ function useCharacterSheet(manager: CharacterSheetManager) {
     setState(manager.getState());
   };
 
+  useEffect(() => {
+    setState(manager.getState());
+    return manager.subscribe(() => setState(manager.getState()));
+  }, [manager]);
+
   return { state, updateState };
 }
 
@@ -40,18 +46,6 @@ export default function CharacterSheet({ isOpen, onClose, manager: externalManag
   const [internalManager] = useState(() => new CharacterSheetManager());
   const manager = externalManager || internalManager;
   const { state, updateState } = useCharacterSheet(manager);
-  
-  // Update state periodically when using external manager (to sync with game state)
-  useEffect(() => {
-    if (!externalManager) return;
-    
-    // Poll for updates every 100ms when sheet is open
-    const interval = setInterval(() => {
-      updateState();
-    }, 100);
-    
-    return () => clearInterval(interval);
-  }, [externalManager, updateState]);
   const [expandedActions, setExpandedActions] = useState<Set<Action>>(new Set());
   const [expandedCompetences, setExpandedCompetences] = useState<Set<Competence>>(new Set());
   const [masterySelectionOpen, setMasterySelectionOpen] = useState<Competence | null>(null);
@@ -2,11 +2,13 @@
 
 import { useEffect, useRef, useState } from 'react';
 import { Debug } from '@/game/utils/debug';
+import { Metrics } from '@/game/utils/Metrics';
 import CharacterSheet from './CharacterSheet';
 import EventLog from './ui/EventLog';
 import Console from './ui/Console';
 import GameEditor from '@/editor/GameEditor';
 import ActiveCompetencesDisplay from './ui/ActiveCompetencesDisplay';
+import FrameProfilerOverlay from './ui/FrameProfilerOverlay';
 
 /**
  * React component that wraps the Three.js game canvas
@@ -22,6 +24,8 @@ export default function GameCanvas() {
   const [characterSheetManager, setCharacterSheetManager] = useState<any>(null);
   const [godMode, setGodMode] = useState<boolean>(true); // Default to true (god mode on by default)
   const [activeCTs, setActiveCTs] = useState<Array<{ competence: any; remainingTime: number }>>([]);
+  const [showProfiler, setShowProfiler] = useState<boolean>(false);
+  const [frameProfiler, setFrameProfiler] = useState<any>(null);
 
   // Handle console/editor open/close - disable controls when console or editor is open
   useEffect(() => {
@@ -70,6 +74,24 @@ export default function GameCanvas() {
     // This will clear previous logs and start fresh on each page refresh
     Debug.initialize();
 
+    const unsubscribers: Array<() => void> = [];
+
+    // Active CTs: refreshed when the tracker changes, then every 100ms while a countdown is shown
+    let countdownTimer: ReturnType<typeof setTimeout> | null = null;
+    const refreshActiveCTs = () => {
+      if (countdownTimer) {
+        clearTimeout(countdownTimer);
+        countdownTimer = null;
+      }
+      const tracker = gameRef.current?.getActiveCompetencesTracker();
+      if (!tracker) return;
+      const activeCTsWithTime = tracker.getActiveCompetencesWithRemainingTime();
+      setActiveCTs(activeCTsWithTime);
+      if (activeCTsWithTime.length > 0) {
+        countdownTimer = setTimeout(refreshActiveCTs, 100);
+      }
+    };
+
     // Dynamically import Game to ensure it only loads on client side
     // This prevents Rapier from being loaded during SSR
     const initGame = async () => {
@@ -105,6 +127,11 @@ export default function GameCanvas() {
         
         // Get character sheet manager from game
         setCharacterSheetManager(game.getCharacterSheetManager());
+        setFrameProfiler(game.getFrameProfiler());
+
+        // HUD values are pushed by the game (once per frame at most) rather than polled
+        unsubscribers.push(game.subscribeFps(setFps));
+        unsubscribers.push(game.getActiveCompetencesTracker().subscribe(refreshActiveCTs));
 
         Debug.log('GameCanvas', 'Game initialized successfully');
       } catch (err) {
@@ -116,61 +143,14 @@ export default function GameCanvas() {
 
     initGame();
 
-    // Setup intervals after game initialization
-    const fpsInterval = setInterval(() => {
-      if (gameRef.current) {
-        setFps(gameRef.current.getFPS());
-      }
-    }, 1000);
-
-    // Auto-save logs every second (append mode)
-    const logSaveInterval = setInterval(() => {
-      Debug.saveLogs(true).catch(() => {
-        // Silently fail on periodic saves - not critical
-      });
-    }, 1000);
-
-    // Update active CTs display (update more frequently for smooth countdown)
-    const activeCTsInterval = setInterval(() => {
-      if (gameRef.current) {
-        try {
-          const tracker = gameRef.current.getActiveCompetencesTracker();
-          if (tracker) {
-            const activeCTsWithTime = tracker.getActiveCompetencesWithRemainingTime();
-            setActiveCTs(activeCTsWithTime);
-          }
-        } catch (error) {
-          // Silently fail if tracker is not available yet
-        }
-      }
-    }, 100); // Update 10 times per second for smooth countdown
-
-    // Initial save - create the log file with all current logs
-    Debug.saveLogs(false).catch(() => {
-      // Silently fail on initial save - not critical
-    });
+    // Stream logs to logs/ in batches (buffered, flushed by size or time)
+    Debug.startLogStream();
+    // Export metrics snapshots to /api/metrics (also appended to logs/)
+    Metrics.startExport(Debug.getSessionStartTime());
 
-    // Final save on page unload (append any remaining logs)
+    // Final flush on page unload (beacon - survives the page going away)
     const handleBeforeUnload = () => {
-      // Save any remaining unsaved logs using append mode
-      // Use fetch with keepalive for reliable delivery during page unload
-      const newLogs = Debug.getNewLogs();
-      if (newLogs.length > 0) {
-        fetch('/api/save-logs', {
-          method: 'POST',
-          headers: {
-            'Content-Type': 'application/json',
-          },
-          body: JSON.stringify({
-            logs: newLogs,
-            append: true,
-            sessionStartTime: Debug.getSessionStartTime(),
-          }),
-          keepalive: true, // Ensures request completes even if page unloads
-        }).catch(() => {
-          // Silently fail - page is unloading anyway
-        });
-      }
+      Debug.flushLogsOnUnload();
     };
 
     window.addEventListener('beforeunload', handleBeforeUnload);
@@ -178,6 +158,10 @@ export default function GameCanvas() {
     return () => {
       // Cleanup
       window.removeEventListener('beforeunload', handleBeforeUnload);
+      unsubscribers.forEach(unsubscribe => unsubscribe());
+      if (countdownTimer) clearTimeout(countdownTimer);
+      Debug.stopLogStream();
+      Metrics.stopExport();
     };
   }, []);
 
@@ -221,6 +205,22 @@ export default function GameCanvas() {
         });
       }
       
+      // F3 for frame profiler overlay
+      if (event.code === 'F3' && !event.repeat) {
+        event.preventDefault();
+        setShowProfiler((prev) => !prev);
+      }
+
+      // F5 / F9 for quick-save / quick-load (not while editing)
+      if ((event.code === 'F5' || event.code === 'F9') && !event.repeat && !showConsole && !showEditor) {
+        event.preventDefault();
+        if (event.code === 'F5') {
+          gameRef.current?.quickSave();
+        } else {
+          gameRef.current?.quickLoad();
+        }
+      }
+
       // 'L' key (with Ctrl/Cmd) to save logs
       if ((event.ctrlKey || event.metaKey) && event.code === 'KeyL' && !event.repeat) {
         event.preventDefault();
@@ -268,6 +268,7 @@ export default function GameCanvas() {
         manager={characterSheetManager}
         godMode={godMode}
       />
+      <FrameProfilerOverlay profiler={frameProfiler} isOpen={showProfiler} />
       <EventLog maxVisible={10} />
       {godMode && (
         <ActiveCompetencesDisplay activeCompetencesWithTime={activeCTs} />
@@ -7,6 +7,9 @@ import { Attribute } from '@/game/character/data/AttributeData';
 import { getCompetenceName } from '@/game/character/data/CompetenceData';
 import { getAttributeName } from '@/game/character/data/AttributeData';
 import { debugLogger, DebugLog } from '@/editor/utils/debugLogger';
+import { Debug, LogLevel, BUILD_LOG_LEVEL } from '@/game/utils/debug';
+import { Tracer } from '@/game/utils/Tracer';
+import { Metrics } from '@/game/utils/Metrics';
 
 interface ConsoleProps {
   isOpen: boolean;
@@ -114,6 +117,20 @@ export default function Console({ isOpen, onClose, manager, godMode, setGodMode,
         case 'god':
           result = handleGodMode(args, godMode, setGodMode);
           break;
+        case 'loglevel':
+        case 'log':
+          result = handleLogLevel(args);
+          break;
+        case 'trace':
+          result = handleTrace(args, (text, type) => {
+            setHistory((prev) => [...prev, { type, text, timestamp: Date.now() }]);
+          });
+          break;
+        case 'metrics':
+          result = handleMetrics(args, (text, type) => {
+            setHistory((prev) => [...prev, { type, text, timestamp: Date.now() }]);
+          });
+          break;
         case 'help':
           result = getHelpText();
           break;
@@ -581,6 +598,74 @@ function handleGodMode(args: string[], godMode: boolean, setGodMode: (enabled: b
   }
 }
 
+const LOG_LEVEL_NAMES = Object.keys(LogLevel).map(name => name.toLowerCase());
+
+function handleLogLevel(args: string[]): string {
+  const buildLevel = LOG_LEVEL_NAMES[BUILD_LOG_LEVEL];
+  if (args.length === 0) {
+    return `Log level: ${LOG_LEVEL_NAMES[Debug.getLevel()]} (lowest level in this build: ${buildLevel})`;
+  }
+
+  const name = args[0].toLowerCase();
+  const category = args[1];
+  if (name === 'reset' && category) {
+    Debug.setCategoryLevel(category, null);
+    return `${category} uses the global log level again`;
+  }
+
+  const level = LogLevel[name.toUpperCase() as keyof typeof LogLevel];
+  if (level === undefined) {
+    return `Error: Usage: loglevel [${LOG_LEVEL_NAMES.join('|')}] [category]. Use 'loglevel reset <category>' to clear a category level.`;
+  }
+
+  const note = level < BUILD_LOG_LEVEL ? ` (levels below ${buildLevel} are compiled out of this build)` : '';
+  if (category) {
+    Debug.setCategoryLevel(category, level);
+    return `${category} log level set to ${name}${note}`;
+  }
+  Debug.setLevel(level);
+  return `Log level set to ${name}${note}`;
+}
+
+function handleTrace(args: string[], onSaved: (text: string, type: 'success' | 'error') => void): string {
+  const action = (args[0] || '').toLowerCase();
+  switch (action) {
+    case '':
+      return `Tracing is ${Tracer.isRecording ? 'ON' : 'OFF'} (${Tracer.eventCount} events buffered)`;
+    case 'start':
+      Tracer.start();
+      return 'Tracing started';
+    case 'stop':
+      Tracer.stop();
+      return `Tracing stopped (${Tracer.eventCount} events buffered)`;
+    case 'clear':
+      Tracer.clear();
+      return 'Trace buffer cleared';
+    case 'save':
+      Tracer.save(Debug.getSessionStartTime())
+        .then(result => onSaved(`Saved ${result.eventCount} trace events to ${result.path} (open in ui.perfetto.dev)`, 'success'))
+        .catch(error => onSaved(`Error: ${error instanceof Error ? error.message : 'Failed to save trace'}`, 'error'));
+      return `Saving ${Tracer.eventCount} trace events...`;
+    default:
+      return 'Error: Usage: trace [start|stop|save|clear]. Use without arguments to check status.';
+  }
+}
+
+function handleMetrics(args: string[], onPushed: (text: string, type: 'success' | 'error') => void): string {
+  const action = args[0] || '';
+  if (action === 'reset') {
+    Metrics.reset();
+    return 'Counters and histograms reset';
+  }
+  if (action === 'push') {
+    Metrics.push(Debug.getSessionStartTime())
+      .then(() => onPushed('Metrics exported to /api/metrics', 'success'))
+      .catch(error => onPushed(`Error: ${error instanceof Error ? error.message : 'Failed to export metrics'}`, 'error'));
+    return 'Exporting metrics...';
+  }
+  return Metrics.format(action) || `No metrics starting with '${action}'`;
+}
+
 function getHelpText(): string {
   return `Available commands:
   gainXP <competence> <amount> [eternal]  - Add marks to a compétence
@@ -590,6 +675,9 @@ function getHelpText(): string {
   reveal <competence>                      - Reveal a hidden compétence
   godmode [on|off]                         - Toggle God mode (enables editing all CS fields)
   debug [on|off|clear]                     - Toggle debug logs display (editor debugging)
+  loglevel [level] [category]              - Show or set the game log level (trace|debug|info|warn|error|off)
+  trace [start|stop|save|clear]            - Record timeline events, save them as a Chrome/Perfetto trace in logs/
+  metrics [prefix|reset|push]              - Show runtime metrics (e.g. 'metrics ecs'), reset or export them
   help                                     - Show this help
 
 Examples:
@@ -600,6 +688,8 @@ Examples:
   setCompetence VISION 5  - Set VISION compétence to 5 degrees
   reveal INVESTIGATION
   godmode on
-  debug on  - Enable debug logs for editor operations`;
+  debug on  - Enable debug logs for editor operations
+  loglevel warn PhysicsWorld  - Only warnings and errors from the physics world
+  trace save  - Write logs/trace-<session>.json`;
 }
 
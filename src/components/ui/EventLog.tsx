@@ -29,12 +29,10 @@ export default function EventLog({ maxVisible = 10 }: EventLogProps) {
     const initialEvents = eventLog.getRecentEvents(maxVisible);
     setEvents(initialEvents);
 
-    // Subscribe to new events
-    const unsubscribe = eventLog.subscribe((event) => {
-      setEvents((prev) => {
-        const newEvents = [event, ...prev].slice(0, maxVisible);
-        return newEvents;
-      });
+    // Subscribe to new events (one batch per frame, oldest first)
+    const unsubscribe = eventLog.subscribe((batch) => {
+      const newest = batch.slice(-maxVisible).reverse();
+      setEvents((prev) => [...newest, ...prev].slice(0, maxVisible));
     });
 
     subscriptionRef.current = unsubscribe;
@@ -0,0 +1,162 @@
+'use client';
+
+import { useEffect, useRef, useState } from 'react';
+import { FRAME_BUDGET_MS, type FrameProfiler, type FrameProfilerStats, type FramePhase } from '@/game/utils/FrameProfiler';
+
+interface FrameProfilerOverlayProps {
+  profiler: FrameProfiler | null;
+  isOpen: boolean;
+}
+
+const PHASE_COLORS: Record<FramePhase, string> = {
+  physics: '#e06c4c',
+  character: '#e0b84c',
+  camera: '#8bc34a',
+  sceneSync: '#4cc3e0',
+  ecs: '#9c6ce0',
+  scripts: '#6c8ce0',
+  render: '#e04ca8',
+};
+
+const GRAPH_FRAMES = 240;
+const GRAPH_WIDTH = GRAPH_FRAMES;
+const GRAPH_HEIGHT = 80;
+const GRAPH_MAX_MS = FRAME_BUDGET_MS * 2;
+const REFRESH_MS = 250;
+
+/**
+ * Frame Profiler Overlay
+ * Stacked per-phase frame times with the 16.6ms budget line, GPU time, percentiles and recent spikes
+ * Toggled with F3
+ */
+export default function FrameProfilerOverlay({ profiler, isOpen }: FrameProfilerOverlayProps) {
+  const canvasRef = useRef<HTMLCanvasElement>(null);
+  const [stats, setStats] = useState<FrameProfilerStats | null>(null);
+
+  useEffect(() => {
+    if (!isOpen || !profiler) return;
+
+    const refresh = () => {
+      setStats(profiler.getStats());
+      drawGraph(canvasRef.current, profiler);
+    };
+    refresh();
+    const interval = setInterval(refresh, REFRESH_MS);
+    return () => clearInterval(interval);
+  }, [isOpen, profiler]);
+
+  if (!isOpen || !profiler) {
+    return null;
+  }
+
+  const format = (ms: number) => ms.toFixed(2);
+
+  return (
+    <div
+      className="fixed top-16 right-4 bg-black/80 border border-gray-700 rounded px-3 py-2 text-gray-200 font-mono text-xs pointer-events-none"
+      style={{ zIndex: 45 }}
+    >
+      <canvas ref={canvasRef} width={GRAPH_WIDTH} height={GRAPH_HEIGHT} className="block mb-2 bg-black/60" />
+      {stats && (
+        <>
+          <table className="w-full">
+            <thead>
+              <tr className="text-gray-400">
+                <th className="text-left pr-2">phase</th>
+                <th className="text-right pr-2">p50</th>
+                <th className="text-right pr-2">p95</th>
+                <th className="text-right pr-2">p99</th>
+                <th className="text-right">max</th>
+              </tr>
+            </thead>
+            <tbody>
+              {(Object.keys(stats.phases) as FramePhase[]).map((phase) => (
+                <tr key={phase}>
+                  <td className="pr-2" style={{ color: PHASE_COLORS[phase] }}>{phase}</td>
+                  <td className="text-right pr-2">{format(stats.phases[phase].p50)}</td>
+                  <td className="text-right pr-2">{format(stats.phases[phase].p95)}</td>
+                  <td className="text-right pr-2">{format(stats.phases[phase].p99)}</td>
+                  <td className="text-right">{format(stats.phases[phase].max)}</td>
+                </tr>
+              ))}
+              <tr className="border-t border-gray-700">
+                <td className="pr-2">cpu total</td>
+                <td className="text-right pr-2">{format(stats.total.p50)}</td>
+                <td className="text-right pr-2">{format(stats.total.p95)}</td>
+                <td className="text-right pr-2">{format(stats.total.p99)}</td>
+                <td className="text-right">{format(stats.total.max)}</td>
+              </tr>
+              <tr>
+                <td className="pr-2 text-white">gpu</td>
+                {stats.gpu ? (
+                  <>
+                    <td className="text-right pr-2">{format(stats.gpu.p50)}</td>
+                    <td className="text-right pr-2">{format(stats.gpu.p95)}</td>
+                    <td className="text-right pr-2">{format(stats.gpu.p99)}</td>
+                    <td className="text-right">{format(stats.gpu.max)}</td>
+                  </>
+                ) : (
+                  <td colSpan={4} className="text-right text-gray-500">unsupported</td>
+                )}
+              </tr>
+            </tbody>
+          </table>
+          <div className="mt-2 text-gray-400">
+            Spikes &gt; {format(stats.budgetMs)}ms: {stats.spikes.length} / {stats.frameCount} frames
+          </div>
+          {stats.spikes.slice(0, 5).map((spike) => (
+            <div key={spike.frame} className="text-red-400">
+              #{spike.frame} {format(spike.totalMs)}ms - {spike.worstPhase} {format(spike.worstPhaseMs)}ms
+            </div>
+          ))}
+        </>
+      )}
+    </div>
+  );
+}
+
+/**
+ * Stacked bar per frame (one pixel column), budget line, GPU time as dots, spikes marked on top
+ */
+function drawGraph(canvas: HTMLCanvasElement | null, profiler: FrameProfiler): void {
+  const ctx = canvas?.getContext('2d');
+  if (!canvas || !ctx) return;
+
+  const history = profiler.getHistory(GRAPH_FRAMES);
+  const phaseCount = history.phases.length;
+  const scale = GRAPH_HEIGHT / GRAPH_MAX_MS;
+  const offset = GRAPH_WIDTH - history.frameCount;
+
+  ctx.clearRect(0, 0, GRAPH_WIDTH, GRAPH_HEIGHT);
+
+  for (let frame = 0; frame < history.frameCount; frame++) {
+    const x = offset + frame;
+    let y = GRAPH_HEIGHT;
+    let total = 0;
+
+    for (let phase = 0; phase < phaseCount; phase++) {
+      const ms = history.samples[frame * phaseCount + phase];
+      const height = ms * scale;
+      ctx.fillStyle = PHASE_COLORS[history.phases[phase]];
+      ctx.fillRect(x, y - height, 1, height);
+      y -= height;
+      total += ms;
+    }
+
+    if (total > FRAME_BUDGET_MS) {
+      ctx.fillStyle = '#ff0000';
+      ctx.fillRect(x, 0, 1, 3);
+    }
+
+    const gpuMs = history.gpu[frame];
+    if (!Number.isNaN(gpuMs)) {
+      ctx.fillStyle = '#ffffff';
+      ctx.fillRect(x, GRAPH_HEIGHT - Math.min(gpuMs * scale, GRAPH_HEIGHT), 1, 1);
+    }
+  }
+
+  // 16.6ms budget line
+  const budgetY = GRAPH_HEIGHT - FRAME_BUDGET_MS * scale;
+  ctx.fillStyle = 'rgba(255, 255, 255, 0.5)';
+  ctx.fillRect(0, budgetY, GRAPH_WIDTH, 1);
+}
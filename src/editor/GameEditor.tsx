@@ -12,6 +12,7 @@ import Console from '@/components/ui/Console';
 import * as THREE from 'three';
 import { EditorCore, EngineAdapter } from './core';
 import { TransformMode } from './gizmos/TransformGizmo';
+import type { SceneMetadata, SceneSortKey } from '@/game/ecs/storage/SceneStorage';
 
 interface GameEditorProps {
   isOpen: boolean;
@@ -24,6 +25,8 @@ interface GameEditorProps {
 
 type PanelTab = 'hierarchy' | 'inspector' | 'assets' | 'console';
 
+const SCENES_PER_PAGE = 20;
+
 /**
  * Game Editor Component - Similar to Creation Engine
  * Refactored to use EditorCore for state management and EngineAdapter for engine access
@@ -53,6 +56,18 @@ export default function GameEditor({
     return editorCoreRef.current;
   }, []);
 
+  // Viewport only needs to redraw every frame while the simulation runs
+  useEffect(() => {
+    if (!gameInstance) return;
+    const scheduler = editorCore.getRenderScheduler();
+    scheduler.setContinuous('simulation', !!gameInstance.isRunning?.());
+    const unsubscribe = gameInstance.subscribeRunning?.((running: boolean) => scheduler.setContinuous('simulation', running));
+    return () => {
+      unsubscribe?.();
+      scheduler.setContinuous('simulation', false);
+    };
+  }, [gameInstance, editorCore]);
+
   // Pause/resume game when editor opens/closes
   useEffect(() => {
     if (!gameInstance) return;
@@ -88,7 +103,10 @@ export default function GameEditor({
   const [showSaveDialog, setShowSaveDialog] = useState(false);
   const [showLoadDialog, setShowLoadDialog] = useState(false);
   const [sceneName, setSceneName] = useState('Scene 1');
-  const [availableScenes, setAvailableScenes] = useState<Array<{ id: string; name: string; createdAt: number; updatedAt: number }>>([]);
+  const [availableScenes, setAvailableScenes] = useState<SceneMetadata[]>([]);
+  const [sceneSort, setSceneSort] = useState<SceneSortKey>('updatedAt');
+  const [scenePage, setScenePage] = useState(0);
+  const [sceneTotal, setSceneTotal] = useState(0);
   const [showAddMenu, setShowAddMenu] = useState(false);
 
   // Initialize engine adapter and set it on EditorCore
@@ -206,26 +224,43 @@ export default function GameEditor({
     }
   };
 
+  // Fetch one page of scene metadata (payloads are not read until a scene is loaded)
+  const fetchScenePage = useCallback(async (page: number, sortBy: SceneSortKey) => {
+    const storage = editorCore.getEngine()?.getSceneStorage();
+    if (!storage) {
+      console.error('Scene storage not available');
+      return false;
+    }
+
+    const result = await storage.listScenePage({
+      sortBy,
+      offset: page * SCENES_PER_PAGE,
+      limit: SCENES_PER_PAGE,
+    });
+    setAvailableScenes(result.scenes);
+    setSceneTotal(result.total);
+    setScenePage(page);
+    setSceneSort(sortBy);
+    return true;
+  }, [editorCore]);
+
   // Handle load scene button click
   const handleLoadClick = async () => {
-    const engine = editorCore.getEngine();
-    if (!engine) return;
-
     try {
-      const storage = engine.getSceneStorage();
-      if (!storage) {
-        console.error('Scene storage not available');
-        return;
+      if (await fetchScenePage(0, sceneSort)) {
+        setShowLoadDialog(true);
       }
-
-      const scenes = await storage.listScenes();
-      setAvailableScenes(scenes);
-      setShowLoadDialog(true);
     } catch (error) {
       console.error('Failed to load scene list:', error);
     }
   };
 
+  const handleScenePageChange = (page: number, sortBy: SceneSortKey = sceneSort) => {
+    fetchScenePage(page, sortBy).catch((error) => {
+      console.error('Failed to load scene list:', error);
+    });
+  };
+
   // Handle load scene (after dialog selection)
   const handleLoadScene = async (sceneId: string) => {
     setLoading(true);
@@ -250,6 +285,8 @@ export default function GameEditor({
     // Update physics body if object has one
     if (object instanceof THREE.Mesh) {
       editorCore.updatePhysicsBody(object);
+    } else {
+      editorCore.notifyObjectChanged(object);
     }
     
     // Force hierarchy refresh
@@ -892,7 +929,18 @@ export default function GameEditor({
       {showLoadDialog && (
         <div className="fixed inset-0 bg-black/50 flex items-center justify-center z-50">
           <div className="bg-gray-800 border border-gray-700 rounded-lg p-4 min-w-[500px] max-w-[600px] max-h-[600px] flex flex-col">
-            <div className="text-white font-mono text-sm font-semibold mb-3">Load Scene</div>
+            <div className="flex items-center justify-between mb-3">
+              <div className="text-white font-mono text-sm font-semibold">Load Scene</div>
+              <select
+                value={sceneSort}
+                onChange={(e) => handleScenePageChange(0, e.target.value as SceneSortKey)}
+                className="bg-gray-700 border border-gray-600 text-white text-xs font-mono rounded px-2 py-1"
+              >
+                <option value="updatedAt">Last updated</option>
+                <option value="createdAt">Created</option>
+                <option value="name">Name</option>
+              </select>
+            </div>
             <div className="flex-1 overflow-auto mb-4">
               {availableScenes.length === 0 ? (
                 <div className="text-gray-400 text-xs font-mono text-center py-8">
@@ -906,19 +954,49 @@ export default function GameEditor({
                       onClick={() => handleLoadScene(scene.id)}
                       className="p-3 bg-gray-700 hover:bg-gray-650 border border-gray-600 rounded cursor-pointer transition-colors"
                     >
-                      <div className="text-white font-semibold text-xs font-mono">{scene.name}</div>
-                      <div className="text-gray-400 text-xs font-mono mt-1">
-                        Updated: {new Date(scene.updatedAt).toLocaleString()}
-                      </div>
-                      <div className="text-gray-500 text-xs font-mono mt-1">
-                        ID: {scene.id.substring(0, 12)}...
+                      <div className="flex gap-3">
+                        {scene.thumbnail && (
+                          <img src={scene.thumbnail} alt="" className="w-20 h-auto rounded border border-gray-600" />
+                        )}
+                        <div>
+                          <div className="text-white font-semibold text-xs font-mono">{scene.name}</div>
+                          <div className="text-gray-400 text-xs font-mono mt-1">
+                            Updated: {new Date(scene.updatedAt).toLocaleString()}
+                          </div>
+                          <div className="text-gray-500 text-xs font-mono mt-1">
+                            {scene.entityCount} entities, {(scene.byteSize / 1024).toFixed(1)} KB
+                            {scene.author ? ` - ${scene.author}` : ''}
+                          </div>
+                          <div className="text-gray-500 text-xs font-mono mt-1">
+                            ID: {scene.id.substring(0, 12)}...
+                          </div>
+                        </div>
                       </div>
                     </div>
                   ))}
                 </div>
               )}
             </div>
-            <div className="flex justify-end">
+            <div className="flex justify-between items-center">
+              <div className="flex items-center gap-2">
+                <button
+                  onClick={() => handleScenePageChange(scenePage - 1)}
+                  disabled={scenePage === 0}
+                  className="px-2 py-1 bg-gray-700 hover:bg-gray-600 text-white text-xs font-mono rounded transition-colors disabled:opacity-50 disabled:cursor-not-allowed"
+                >
+                  Prev
+                </button>
+                <span className="text-gray-400 text-xs font-mono">
+                  {sceneTotal === 0 ? 0 : scenePage * SCENES_PER_PAGE + 1}-{Math.min((scenePage + 1) * SCENES_PER_PAGE, sceneTotal)} of {sceneTotal}
+                </span>
+                <button
+                  onClick={() => handleScenePageChange(scenePage + 1)}
+                  disabled={(scenePage + 1) * SCENES_PER_PAGE >= sceneTotal}
+                  className="px-2 py-1 bg-gray-700 hover:bg-gray-600 text-white text-xs font-mono rounded transition-colors disabled:opacity-50 disabled:cursor-not-allowed"
+                >
+                  Next
+                </button>
+              </div>
               <button
                 onClick={() => setShowLoadDialog(false)}
                 className="px-3 py-1.5 bg-gray-700 hover:bg-gray-600 text-white text-xs font-mono rounded transition-colors"
@@ -11,8 +11,12 @@ import {
   createDeleteObjectAction,
 } from '../history/actions/EditorActions';
 import { TransformMode } from '../gizmos/TransformGizmo';
+import { RenderScheduler } from './RenderScheduler';
+import type { SceneLoadOptions } from '@/game/ecs/serialization/SceneLoader';
 import { logEditor, logScene, logHistory } from '../utils/debugLogger';
 
+const AUTOSAVE_DELAY_MS = 1000;
+
 /**
  * Editor Core - Manages editor state, selection, and operations
  */
@@ -22,6 +26,10 @@ export class EditorCore {
   private selectedObjects: Set<THREE.Object3D> = new Set();
   private selectedObject: THREE.Object3D | null = null;
   private transformMode: TransformMode = 'translate';
+  private renderScheduler: RenderScheduler = new RenderScheduler();
+  private unsubscribeHistory: (() => void) | null = null;
+  private autosaveEnabled: boolean = true;
+  private autosaveTimer: ReturnType<typeof setTimeout> | null = null;
 
   // Selection listeners
   private selectionListeners: Set<(objects: Set<THREE.Object3D>, primary: THREE.Object3D | null) => void> = new Set();
@@ -31,6 +39,11 @@ export class EditorCore {
 
   constructor(maxHistorySize: number = 100) {
     this.historyManager = new HistoryManager(maxHistorySize);
+    // Undo/redo changes the scene
+    this.unsubscribeHistory = this.historyManager.subscribe(() => {
+      this.requestRender();
+      this.scheduleAutosave();
+    });
   }
 
   /**
@@ -47,6 +60,20 @@ export class EditorCore {
     return this.engine;
   }
 
+  /**
+   * Get viewport render scheduler (render-on-demand)
+   */
+  getRenderScheduler(): RenderScheduler {
+    return this.renderScheduler;
+  }
+
+  /**
+   * Request a viewport redraw (call after changing anything visible)
+   */
+  requestRender(): void {
+    this.renderScheduler.invalidate();
+  }
+
   /**
    * Get history manager
    */
@@ -277,11 +304,56 @@ export class EditorCore {
           transform.rotation.copy(mesh.rotation);
           transform.scale.copy(mesh.scale);
         }
+        entityManager.markDirty(entity);
       }
     }
     
     // Update physics body
     this.engine.updatePhysicsBodyForMesh(mesh);
+    this.requestRender();
+    this.scheduleAutosave();
+  }
+
+  /**
+   * Record an edit made to an object (e.g. from the inspector), so autosave picks it up
+   */
+  notifyObjectChanged(object: THREE.Object3D): void {
+    const entityManager = this.engine?.getEntityManager();
+    const entity = entityManager?.getEntityFromObject3D(object);
+    if (entity) {
+      entityManager!.markDirty(entity);
+    }
+    this.requestRender();
+    this.scheduleAutosave();
+  }
+
+  /**
+   * Enable/disable autosaving edits into the last saved or loaded scene
+   */
+  setAutosaveEnabled(enabled: boolean): void {
+    this.autosaveEnabled = enabled;
+    if (!enabled) this.cancelAutosave();
+  }
+
+  /**
+   * Autosave shortly after the last edit (edits in quick succession are written together)
+   */
+  scheduleAutosave(): void {
+    if (!this.autosaveEnabled || !this.engine) return;
+    this.cancelAutosave();
+    this.autosaveTimer = setTimeout(() => {
+      this.autosaveTimer = null;
+      this.engine?.autosaveScene().catch((error) => {
+        logScene('autosave: Failed', { error: error instanceof Error ? error.message : String(error) });
+      });
+    }, AUTOSAVE_DELAY_MS);
+  }
+
+  private cancelAutosave(): void {
+    if (this.autosaveTimer !== null) {
+      clearTimeout(this.autosaveTimer);
+      this.autosaveTimer = null;
+    }
   }
 
   /**
@@ -324,7 +396,7 @@ export class EditorCore {
   /**
    * Load scene
    */
-  async loadScene(sceneId: string): Promise<boolean> {
+  async loadScene(sceneId: string, options: SceneLoadOptions = {}): Promise<boolean> {
     if (!this.engine) {
       logScene('loadScene: Engine not available');
       return false;
@@ -336,7 +408,15 @@ export class EditorCore {
     });
 
     try {
-      const success = await this.engine.loadScene(sceneId);
+      // Redraw as slices land (the viewport only renders on demand)
+      const success = await this.engine.loadScene(sceneId, {
+        ...options,
+        onProgress: (progress) => {
+          this.requestRender();
+          options.onProgress?.(progress);
+        },
+      });
+      this.requestRender();
       if (success) {
         logScene('loadScene: Scene loaded successfully', {
           sceneId,
@@ -386,6 +466,7 @@ export class EditorCore {
     this.selectionListeners.forEach((listener) => {
       listener(selection.objects, selection.primary);
     });
+    this.requestRender();
   }
 
   /**
@@ -395,15 +476,20 @@ export class EditorCore {
     this.transformModeListeners.forEach((listener) => {
       listener(this.transformMode);
     });
+    this.requestRender();
   }
 
   /**
    * Cleanup
    */
   dispose(): void {
+    this.cancelAutosave();
     this.clearSelection();
     this.selectionListeners.clear();
     this.transformModeListeners.clear();
+    this.unsubscribeHistory?.();
+    this.unsubscribeHistory = null;
+    this.renderScheduler.dispose();
     this.engine = null;
   }
 }
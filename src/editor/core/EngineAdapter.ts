@@ -4,6 +4,7 @@
  */
 
 import { IEngine } from './IEngine';
+import type { SceneLoadOptions } from '@/game/ecs/serialization/SceneLoader';
 import * as THREE from 'three';
 
 /**
@@ -54,9 +55,16 @@ export class EngineAdapter implements IEngine {
     return null;
   }
 
-  async loadScene(sceneId: string): Promise<boolean> {
+  async autosaveScene(): Promise<boolean> {
+    if (this.game.autosaveScene) {
+      return await this.game.autosaveScene();
+    }
+    return false;
+  }
+
+  async loadScene(sceneId: string, options?: SceneLoadOptions): Promise<boolean> {
     if (this.game.loadScene) {
-      return await this.game.loadScene(sceneId);
+      return await this.game.loadScene(sceneId, options);
     }
     return false;
   }
@@ -8,6 +8,7 @@ import { EntityManager } from '@/game/ecs/EntityManager';
 import { EntityFactory } from '@/game/ecs/factories/EntityFactory';
 import { PrefabManager } from '@/game/ecs/prefab/PrefabManager';
 import { SceneStorage } from '@/game/ecs/storage/SceneStorage';
+import type { SceneLoadOptions } from '@/game/ecs/serialization/SceneLoader';
 
 /**
  * Interface for engine operations needed by the editor
@@ -55,9 +56,14 @@ export interface IEngine {
   saveScene(sceneName: string, author?: string): Promise<string | null>;
 
   /**
-   * Load scene from storage
+   * Save edits into the last saved/loaded scene (only changed entities when possible)
    */
-  loadScene(sceneId: string): Promise<boolean>;
+  autosaveScene(): Promise<boolean>;
+
+  /**
+   * Load scene from storage (time-sliced, resolves false if cancelled)
+   */
+  loadScene(sceneId: string, options?: SceneLoadOptions): Promise<boolean>;
 
   /**
    * Pause the game (pause physics simulation)
@@ -0,0 +1,97 @@
+/**
+ * Render Scheduler - Render-on-demand for the editor viewport
+ * Draws a frame only after something invalidated the view (camera move, gizmo drag,
+ * selection change, transform edit...) or while a continuous source (e.g. running
+ * simulation) is active. An idle editor renders nothing.
+ */
+export class RenderScheduler {
+  private frameId: number | null = null;
+  private dirty: boolean = false;
+  private continuousSources: Set<string> = new Set();
+  private renderCallback: (() => void) | null = null;
+  private framesRendered: number = 0;
+
+  /**
+   * Set the function that draws one frame (null detaches the viewport)
+   */
+  setRenderCallback(callback: (() => void) | null): void {
+    this.renderCallback = callback;
+    if (callback) {
+      this.invalidate(); // New viewport needs a first frame
+    } else {
+      this.cancel();
+    }
+  }
+
+  /**
+   * Request a redraw on the next animation frame (coalesced)
+   */
+  invalidate(): void {
+    this.dirty = true;
+    this.schedule();
+  }
+
+  /**
+   * Keep rendering every frame while a source is active
+   * @param source Name of the source (e.g. 'simulation'), so several can overlap
+   */
+  setContinuous(source: string, active: boolean): void {
+    if (active) {
+      this.continuousSources.add(source);
+      this.schedule();
+    } else if (this.continuousSources.delete(source)) {
+      this.invalidate(); // Draw the final state
+    }
+  }
+
+  /**
+   * Check if the scheduler is currently rendering every frame
+   */
+  isContinuous(): boolean {
+    return this.continuousSources.size > 0;
+  }
+
+  /**
+   * Number of frames drawn so far (for diagnostics)
+   */
+  getFramesRendered(): number {
+    return this.framesRendered;
+  }
+
+  /**
+   * Cleanup
+   */
+  dispose(): void {
+    this.cancel();
+    this.renderCallback = null;
+    this.continuousSources.clear();
+  }
+
+  private schedule(): void {
+    if (this.frameId !== null || !this.renderCallback) return;
+    this.frameId = requestAnimationFrame(this.tick);
+  }
+
+  private cancel(): void {
+    if (this.frameId !== null) {
+      cancelAnimationFrame(this.frameId);
+      this.frameId = null;
+    }
+  }
+
+  private tick = (): void => {
+    this.frameId = null;
+    if (!this.renderCallback) return;
+
+    if (this.dirty || this.continuousSources.size > 0) {
+      // Clear first, so invalidations made while rendering schedule another frame
+      this.dirty = false;
+      this.renderCallback();
+      this.framesRendered++;
+    }
+
+    if (this.dirty || this.continuousSources.size > 0) {
+      this.schedule();
+    }
+  };
+}
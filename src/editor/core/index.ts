@@ -5,4 +5,5 @@
 export type { IEngine } from './IEngine';
 export { EditorCore } from './EditorCore';
 export { EngineAdapter } from './EngineAdapter';
+export { RenderScheduler } from './RenderScheduler';
 
@@ -2,6 +2,7 @@
  * History Manager - Manages undo/redo functionality for the editor
  * Tracks all actions and allows jumping to any point in history
  */
+import { Channel } from '@/game/utils/EventBus';
 
 export interface HistoryAction {
   id: string;
@@ -24,7 +25,8 @@ export interface HistoryState {
  */
 export class HistoryManager {
   private state: HistoryState;
-  private listeners: Set<(state: HistoryState) => void> = new Set();
+  private changes: Channel<number> = new Channel('history'); // Current index after each change
+  private snapshot: HistoryState | null = null; // getState() copy, rebuilt after a change
 
   constructor(maxHistorySize: number = 100) {
     this.state = {
@@ -130,10 +132,13 @@ export class HistoryManager {
    * Get current history state
    */
   getState(): HistoryState {
-    return {
-      ...this.state,
-      actions: [...this.state.actions], // Return copy
-    };
+    if (!this.snapshot) {
+      this.snapshot = {
+        ...this.state,
+        actions: [...this.state.actions], // Return copy (shared until the next change - treat as read-only)
+      };
+    }
+    return this.snapshot;
   }
 
   /**
@@ -163,21 +168,18 @@ export class HistoryManager {
   }
 
   /**
-   * Subscribe to history changes
+   * Subscribe to history changes (called at most once per frame, with the latest state)
    */
   subscribe(listener: (state: HistoryState) => void): () => void {
-    this.listeners.add(listener);
-    return () => {
-      this.listeners.delete(listener);
-    };
+    return this.changes.subscribe(() => listener(this.getState()));
   }
 
   /**
    * Notify all listeners of state change
    */
   private notifyListeners(): void {
-    const state = this.getState();
-    this.listeners.forEach(listener => listener(state));
+    this.snapshot = null;
+    this.changes.publish(this.state.currentIndex);
   }
 }
 
@@ -1,13 +1,13 @@
 'use client';
 
-import { useEffect, useRef, useState, useCallback } from 'react';
+import { useEffect, useRef, useState, useCallback, useMemo } from 'react';
 import * as THREE from 'three';
 import { GAME_CONFIG } from '@/lib/constants';
 import { TransformGizmo, TransformMode } from '@/editor/gizmos/TransformGizmo';
 import { logGizmo, logTransform, logGeneral } from '@/editor/utils/debugLogger';
 import { HistoryManager } from '../history/HistoryManager';
 import { createTransformObjectAction } from '../history/actions/EditorActions';
-import { EditorCore } from '../core';
+import { EditorCore, RenderScheduler } from '../core';
 
 interface GameViewportProps {
   scene: THREE.Scene | null;
@@ -30,7 +30,6 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
   const canvasRef = useRef<HTMLCanvasElement | null>(null);
   const rendererRef = useRef<THREE.WebGLRenderer | null>(null);
   const editorCameraRef = useRef<THREE.PerspectiveCamera | THREE.OrthographicCamera | null>(null);
-  const animationFrameRef = useRef<number | null>(null);
   const raycasterRef = useRef<THREE.Raycaster>(new THREE.Raycaster());
   const mouseRef = useRef<THREE.Vector2>(new THREE.Vector2());
   const [isPanning, setIsPanning] = useState(false);
@@ -40,6 +39,15 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
   const orbitDistanceRef = useRef(10);
   const orbitAngleRef = useRef({ horizontal: Math.PI / 4, vertical: Math.PI / 3 });
   const orbitTargetRef = useRef<THREE.Vector3>(new THREE.Vector3(0, 0, 0));
+
+  // Render-on-demand: the viewport only redraws after something invalidates it
+  const renderScheduler = useMemo(() => editorCore?.getRenderScheduler() ?? new RenderScheduler(), [editorCore]);
+  const renderSchedulerRef = useRef(renderScheduler);
+  renderSchedulerRef.current = renderScheduler;
+  const requestRender = useCallback(() => renderSchedulerRef.current.invalidate(), []);
+  const selectedObjectRef = useRef(selectedObject);
+  selectedObjectRef.current = selectedObject;
+  const hoveredAxisRef = useRef<string | null>(null);
   
   // View mode state (perspective, top, front, side)
   type ViewMode = 'perspective' | 'top' | 'front' | 'side';
@@ -100,7 +108,8 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
 
     camera.position.set(x, y, z);
     camera.lookAt(target);
-  }, []);
+    requestRender();
+  }, [requestRender]);
 
   // Update orthographic camera for 2D views
   const updateOrthographicCamera = useCallback((mode: ViewMode) => {
@@ -141,7 +150,8 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
         camera.up.set(0, 1, 0);
         break;
     }
-  }, []);
+    requestRender();
+  }, [requestRender]);
 
   // Initialize grid
   useEffect(() => {
@@ -152,6 +162,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
     grid.position.y = 0;
     scene.add(grid);
     gridRef.current = grid;
+    requestRender();
 
     return () => {
       if (grid && scene) {
@@ -159,8 +170,9 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
         grid.dispose();
       }
       gridRef.current = null;
+      requestRender();
     };
-  }, [scene, gridSize, gridScale]);
+  }, [scene, gridSize, gridScale, requestRender]);
 
   // Initialize gizmo
   useEffect(() => {
@@ -168,12 +180,13 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
 
     const gizmo = new TransformGizmo(scene);
     gizmoRef.current = gizmo;
+    requestRender();
 
     return () => {
       gizmo.dispose();
       gizmoRef.current = null;
     };
-  }, [scene]);
+  }, [scene, requestRender]);
 
   // Update gizmo when selection or mode changes
   useEffect(() => {
@@ -182,7 +195,9 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
     gizmoRef.current.setCamera(editorCameraRef.current);
     gizmoRef.current.setSelectedObject(selectedObject);
     gizmoRef.current.setMode(transformMode);
-  }, [selectedObject, transformMode]);
+    hoveredAxisRef.current = null;
+    requestRender();
+  }, [selectedObject, transformMode, requestRender]);
 
   // Initialize editor camera and renderer
   useEffect(() => {
@@ -230,6 +245,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
             editorCameraRef.current.updateProjectionMatrix();
           }
         }
+        requestRender();
       }
     };
 
@@ -276,13 +292,11 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
     const resizeObserver = new ResizeObserver(updateSize);
     resizeObserver.observe(container);
 
+    requestRender();
+
     // Cleanup
     return () => {
       resizeObserver.disconnect();
-      if (animationFrameRef.current) {
-        cancelAnimationFrame(animationFrameRef.current);
-        animationFrameRef.current = null;
-      }
       if (canvas && container.contains(canvas)) {
         container.removeChild(canvas);
       }
@@ -291,7 +305,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
       editorCameraRef.current = null;
       canvasRef.current = null;
     };
-  }, [scene, updateCameraPosition, viewMode, updateOrthographicCamera]);
+  }, [scene, updateCameraPosition, viewMode, updateOrthographicCamera, requestRender]);
 
   // Handle click to select object (gizmo detection is now in handleMouseDown)
   const handleClick = useCallback((e: React.MouseEvent) => {
@@ -496,17 +510,22 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
 
     const gizmoGroup = gizmoRef.current.getGizmoGroup();
     if (gizmoGroup) {
+      let hoveredAxis: string | null = null;
       const intersects = raycasterRef.current.intersectObjects(gizmoGroup.children, true);
       if (intersects.length > 0) {
         const axis = intersects[0].object.userData.axis;
         if (axis && intersects[0].object.userData.type === transformMode) {
-          gizmoRef.current.highlightAxis(axis);
-          return;
+          hoveredAxis = axis;
         }
       }
-      gizmoRef.current.highlightAxis(null);
+      gizmoRef.current.highlightAxis(hoveredAxis);
+      // Only redraw when the highlight actually changes
+      if (hoveredAxis !== hoveredAxisRef.current) {
+        hoveredAxisRef.current = hoveredAxis;
+        requestRender();
+      }
     }
-  }, [scene, transformMode, isDraggingGizmo]);
+  }, [scene, transformMode, isDraggingGizmo, requestRender]);
 
   // Handle gizmo dragging with document-level event listeners
   useEffect(() => {
@@ -757,6 +776,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
       if (currentGizmo) {
         currentGizmo.updatePosition();
       }
+      requestRender();
 
       if (onObjectChange) {
         onObjectChange(currentObject);
@@ -867,7 +887,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
       document.removeEventListener('mousemove', handleGizmoDrag);
       document.removeEventListener('mouseup', handleGizmoDragEnd);
     };
-  }, [isDraggingGizmo, draggingAxis, selectedObject, selectedObjects, transformMode, onObjectChange, editorCore, historyManager]);
+  }, [isDraggingGizmo, draggingAxis, selectedObject, selectedObjects, transformMode, onObjectChange, editorCore, historyManager, requestRender]);
 
   const handleMouseMove = useCallback((e: React.MouseEvent) => {
     if (!containerRef.current || !editorCameraRef.current || !scene) return;
@@ -935,6 +955,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
         editorCameraRef.current.bottom = -size;
         editorCameraRef.current.updateProjectionMatrix();
       }
+      requestRender();
       return;
     }
     
@@ -954,7 +975,7 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
       orbitDistanceRef.current = Math.max(1, Math.min(100, orbitDistanceRef.current + delta));
       updateCameraPosition();
     }
-  }, [updateCameraPosition, zoomSpeed, viewMode]);
+  }, [updateCameraPosition, zoomSpeed, viewMode, requestRender]);
 
 
   // Update gizmo position in render loop
@@ -962,33 +983,40 @@ export default function GameViewport({ scene, selectedObject, selectedObjects, t
     if (gizmoRef.current && selectedObject) {
       gizmoRef.current.updatePosition();
     }
-  }, [selectedObject?.position.x, selectedObject?.position.y, selectedObject?.position.z,
+    requestRender();
+  }, [requestRender, selectedObject?.position.x, selectedObject?.position.y, selectedObject?.position.z,
       selectedObject?.rotation.x, selectedObject?.rotation.y, selectedObject?.rotation.z]);
 
-  // Render loop
+  // Render on demand (the scheduler only calls this after an invalidation or while simulating)
   useEffect(() => {
-    if (!scene || !editorCameraRef.current || !rendererRef.current) return;
+    if (!scene) return;
 
-    const render = () => {
-      if (!scene || !editorCameraRef.current || !rendererRef.current) return;
+    renderScheduler.setRenderCallback(() => {
+      if (!editorCameraRef.current || !rendererRef.current) return;
 
-      // Update gizmo position during dragging
-      if (gizmoRef.current && selectedObject) {
+      // Keep gizmo attached to the selected object
+      if (gizmoRef.current && selectedObjectRef.current) {
         gizmoRef.current.updatePosition();
       }
 
       rendererRef.current.render(scene, editorCameraRef.current);
-      animationFrameRef.current = requestAnimationFrame(render);
-    };
+    });
 
-    animationFrameRef.current = requestAnimationFrame(render);
+    // Safety net for edits made outside the viewport (inspector fields, panels, shortcuts)
+    const handleExternalEdit = () => renderScheduler.invalidate();
+    const editEvents = ['input', 'change', 'pointerup', 'keyup'];
+    editEvents.forEach(type => window.addEventListener(type, handleExternalEdit, true));
+
+    // Textures finish loading asynchronously - redraw once they are on their materials
+    const materialLibrary = editorCore?.getEngine()?.getMaterialLibrary?.();
+    const unsubscribeTextures = materialLibrary?.subscribeTextureChanges?.(() => renderScheduler.invalidate());
 
     return () => {
-      if (animationFrameRef.current) {
-        cancelAnimationFrame(animationFrameRef.current);
-      }
+      renderScheduler.setRenderCallback(null);
+      editEvents.forEach(type => window.removeEventListener(type, handleExternalEdit, true));
+      unsubscribeTextures?.();
     };
-  }, [scene, selectedObject]);
+  }, [scene, renderScheduler, editorCore]);
 
   // Update orbit target to focus on selected objects (focus on first selected)
   // REMOVED: Auto-focus/zoom on selection - user can manually orbit if needed
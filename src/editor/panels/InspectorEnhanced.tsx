@@ -10,6 +10,7 @@ import { PhysicsComponent } from '@/game/ecs/components/PhysicsComponent';
 import { LightComponent } from '@/game/ecs/components/LightComponent';
 import { TriggerComponent } from '@/game/ecs/components/TriggerComponent';
 import { MaterialComponent } from '@/game/ecs/components/MaterialComponent';
+import { ScriptLoader } from '@/game/scripts/ScriptLoader';
 import { CharacterSheetManager } from '@/game/character/CharacterSheetManager';
 import { HistoryManager } from '../history/HistoryManager';
 import { createTransformObjectAction, createPropertyChangeAction } from '../history/actions/EditorActions';
@@ -748,8 +749,12 @@ export default function InspectorEnhanced({ object, entityManager, manager, hist
                       handlePropertyChange();
                     }}
                     placeholder="scripts/triggers/door"
+                    list="trigger-script-paths"
                     className="flex-1 px-2 py-1 bg-gray-700 border border-gray-600 rounded text-white text-xs font-mono focus:outline-none focus:border-blue-500"
                   />
+                  <datalist id="trigger-script-paths">
+                    {ScriptLoader.getAvailableScripts().map(path => <option key={path} value={path} />)}
+                  </datalist>
                   {triggerScriptPath && (
                     <button
                       onClick={() => {
@@ -28,9 +28,16 @@ export default function Prefabs({ prefabManager, entityManager, entityFactory, s
 
   // Load prefabs
   useEffect(() => {
-    if (prefabManager) {
-      setPrefabs(prefabManager.getAllPrefabs());
-    }
+    if (!prefabManager) return;
+    let cancelled = false;
+    setPrefabs(prefabManager.getAllPrefabs());
+    // Stored prefabs load asynchronously from IndexedDB
+    prefabManager.whenReady().then(() => {
+      if (!cancelled) setPrefabs(prefabManager.getAllPrefabs());
+    });
+    return () => {
+      cancelled = true;
+    };
   }, [prefabManager]);
 
   // Filter prefabs by search
@@ -47,15 +54,12 @@ export default function Prefabs({ prefabManager, entityManager, entityFactory, s
     }
 
     try {
-      // Note: instantiatePrefab needs renderer and physicsWorld
-      // These should be passed from the parent component
-      // For now, we'll pass null and let the system handle it
-      // TODO: Pass renderer and physicsWorld from GameEditor
+      // Renderer and physics world come from the manager's factory context (set by Game)
       const entity = prefabManager.instantiatePrefab(
         prefabId,
         entityManager,
-        null as any, // renderer - should be passed from parent
-        null as any, // physicsWorld - should be passed from parent
+        null,
+        null,
         { x: 0, y: 1, z: 0 }
       );
 
@@ -71,11 +75,29 @@ export default function Prefabs({ prefabManager, entityManager, entityFactory, s
     }
   };
 
+  // Prefab instance currently selected in the scene (its edits can be applied to the prefab)
+  const selectedEntity = selectedObject?.userData?.entityId
+    ? entityManager?.getEntity(selectedObject.userData.entityId)
+    : undefined;
+  const selectedInstanceOf: string | undefined = selectedEntity?.metadata.prefabId;
+
+  // Handle apply instance changes to prefab (propagates to all linked instances)
+  const handleApply = (prefabId: string) => {
+    if (!prefabManager || !entityManager || !selectedEntity) return;
+
+    if (prefabManager.updatePrefab(prefabId, selectedEntity, entityManager)) {
+      prefabManager.flushPropagation(entityManager);
+      setPrefabs(prefabManager.getAllPrefabs());
+    } else {
+      alert('Failed to apply changes to prefab');
+    }
+  };
+
   // Handle delete prefab
   const handleDelete = (prefabId: string) => {
     if (!prefabManager) return;
     
-    if (confirm('Delete this prefab? This cannot be undone.')) {
+    if (confirm('Delete this prefab? It can no longer be placed; scenes and prefabs that use it keep working.')) {
       prefabManager.deletePrefab(prefabId);
       setPrefabs(prefabManager.getAllPrefabs());
     }
@@ -193,9 +215,14 @@ export default function Prefabs({ prefabManager, entityManager, entityFactory, s
                     <div className="text-gray-500 text-xs font-mono mt-1">
                       {new Date(prefab.updatedAt).toLocaleString()}
                     </div>
-                    {prefab.entity.components.length > 0 && (
+                    {prefab.entity.prefab && (
+                      <div className="text-gray-500 text-xs font-mono mt-1">
+                        Based on: {prefabManager.getPrefab(prefab.entity.prefab.id)?.name || 'missing prefab'}
+                      </div>
+                    )}
+                    {(prefabManager.getPrefabComponents(prefab.id)?.length ?? 0) > 0 && (
                       <div className="text-gray-500 text-xs font-mono mt-1">
-                        Components: {prefab.entity.components.map(c => c.type).join(', ')}
+                        Components: {prefabManager.getPrefabComponents(prefab.id)!.map(c => c.component.type).join(', ')}
                       </div>
                     )}
                   </div>
@@ -209,6 +236,15 @@ export default function Prefabs({ prefabManager, entityManager, entityFactory, s
                   >
                     Instantiate
                   </button>
+                  {selectedInstanceOf === prefab.id && (
+                    <button
+                      onClick={() => handleApply(prefab.id)}
+                      className="px-3 py-1.5 bg-green-600 hover:bg-green-700 text-white text-xs font-mono rounded transition-colors"
+                      title="Apply the selected instance's changes to this prefab and all its instances"
+                    >
+                      Apply
+                    </button>
+                  )}
                   <button
                     onClick={() => handleDelete(prefab.id)}
                     className="px-3 py-1.5 bg-red-600 hover:bg-red-700 text-white text-xs font-mono rounded transition-colors"
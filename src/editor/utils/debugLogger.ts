@@ -2,6 +2,7 @@
  * Debug Logger - Centralized logging system for the editor
  * Logs can be displayed in the Console component
  */
+import { Channel } from '@/game/utils/EventBus';
 
 export type DebugLogType = 'gizmo' | 'selection' | 'transform' | 'camera' | 'general' | 'editor' | 'scene' | 'history';
 
@@ -14,7 +15,8 @@ export interface DebugLog {
 
 class DebugLogger {
   private logs: DebugLog[] = [];
-  private listeners: Set<(logs: DebugLog[]) => void> = new Set();
+  private changes: Channel<number> = new Channel('debugLogger'); // Log count after each change
+  private snapshot: DebugLog[] | null = null; // getLogs() copy, rebuilt after a change
   private enabled: boolean = true;
   private maxLogs: number = 500; // Keep last 500 logs
 
@@ -35,34 +37,34 @@ class DebugLogger {
 
     // Limit log count
     if (this.logs.length > this.maxLogs) {
-      this.logs = this.logs.slice(-this.maxLogs);
+      this.logs.splice(0, this.logs.length - this.maxLogs);
     }
 
     // Also log to browser console
     console.log(`[${type.toUpperCase()}] ${message}`, data || '');
 
-    // Notify listeners
-    this.notifyListeners();
+    this.snapshot = null;
+    this.changes.publish(this.logs.length);
   }
 
   /**
-   * Subscribe to log updates
+   * Subscribe to log updates (called now, then at most once per frame with all logs)
    */
   subscribe(callback: (logs: DebugLog[]) => void): () => void {
-    this.listeners.add(callback);
+    const unsubscribe = this.changes.subscribe(() => callback(this.getLogs()));
     // Immediately call with current logs
-    callback([...this.logs]);
-    // Return unsubscribe function
-    return () => {
-      this.listeners.delete(callback);
-    };
+    callback(this.getLogs());
+    return unsubscribe;
   }
 
   /**
-   * Get all logs
+   * Get all logs (shared copy until the next log - treat as read-only)
    */
   getLogs(): DebugLog[] {
-    return [...this.logs];
+    if (!this.snapshot) {
+      this.snapshot = [...this.logs];
+    }
+    return this.snapshot;
   }
 
   /**
@@ -70,7 +72,8 @@ class DebugLogger {
    */
   clear(): void {
     this.logs = [];
-    this.notifyListeners();
+    this.snapshot = null;
+    this.changes.publish(0);
   }
 
   /**
@@ -86,19 +89,6 @@ class DebugLogger {
   isEnabled(): boolean {
     return this.enabled;
   }
-
-  /**
-   * Notify all listeners
-   */
-  private notifyListeners(): void {
-    this.listeners.forEach(callback => {
-      try {
-        callback([...this.logs]);
-      } catch (error) {
-        console.error('Error in debug log listener:', error);
-      }
-    });
-  }
 }
 
 // Export singleton instance
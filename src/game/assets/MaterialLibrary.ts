@@ -1,6 +1,8 @@
 import * as THREE from 'three';
 import { MaterialDefinition } from './types';
+import { TextureAtlas, AtlasTileSource } from './TextureAtlas';
 import { Debug } from '../utils/debug';
+import { Channel } from '../utils/EventBus';
 
 /**
  * Material Library - Loads and manages material definitions from JSON files
@@ -10,7 +12,10 @@ export class MaterialLibrary {
   private materials: Map<string, MaterialDefinition> = new Map();
   private materialInstances: Map<string, THREE.Material> = new Map();
   private textureCache: Map<string, THREE.Texture> = new Map();
+  private atlas: TextureAtlas | null = null;
+  private atlasMaterial: THREE.MeshStandardMaterial | null = null;
   private loaded: boolean = false;
+  private textureChanges: Channel<string> = new Channel('materialLibrary.textures'); // Material ID after each texture is applied
 
   /**
    * Initialize material library by loading all material JSON files
@@ -52,6 +57,13 @@ export class MaterialLibrary {
 
       this.loaded = true;
       Debug.log('MaterialLibrary', `Material library initialized with ${this.materials.size} materials`);
+
+      // Atlas is optional - per-face materials fall back to one material per face without it
+      try {
+        await this.buildAtlas();
+      } catch (error) {
+        Debug.warn('MaterialLibrary', 'Failed to build texture atlas. Per-face materials will not be batched.', error);
+      }
     } catch (error) {
       Debug.error('MaterialLibrary', 'Failed to initialize material library', error as Error);
       throw error;
@@ -122,6 +134,13 @@ export class MaterialLibrary {
     return material;
   }
 
+  /**
+   * Subscribe to textures arriving on materials (once per frame, with the IDs of the updated materials)
+   */
+  subscribeTextureChanges(listener: (materialIds: readonly string[]) => void): () => void {
+    return this.textureChanges.subscribe(listener);
+  }
+
   /**
    * Load textures for a material
    * Textures are optional - if a texture fails to load, the material will still work with just colors
@@ -135,6 +154,7 @@ export class MaterialLibrary {
         const texture = await this.loadTexture(materialDef.textures.diffuse);
         if (texture) {
           material.map = texture;
+          this.textureChanges.publish(materialDef.id);
         }
       } catch (error) {
         // Texture failed to load - use color only
@@ -148,6 +168,7 @@ export class MaterialLibrary {
         const texture = await this.loadTexture(materialDef.textures.normal);
         if (texture) {
           material.normalMap = texture;
+          this.textureChanges.publish(materialDef.id);
         }
       } catch (error) {
         // Normal map failed to load - continue without it
@@ -161,6 +182,7 @@ export class MaterialLibrary {
         const texture = await this.loadTexture(materialDef.textures.roughness);
         if (texture) {
           material.roughnessMap = texture;
+          this.textureChanges.publish(materialDef.id);
         }
       } catch (error) {
         // Roughness map failed to load - continue without it
@@ -174,6 +196,7 @@ export class MaterialLibrary {
         const texture = await this.loadTexture(materialDef.textures.metalness);
         if (texture) {
           material.metalnessMap = texture;
+          this.textureChanges.publish(materialDef.id);
         }
       } catch (error) {
         // Metalness map failed to load - continue without it
@@ -223,6 +246,61 @@ export class MaterialLibrary {
     }
   }
 
+  /**
+   * Build the texture atlas from all loaded material definitions
+   * Each material becomes one tile: its diffuse texture tinted by its diffuse color, or a flat color
+   */
+  async buildAtlas(): Promise<TextureAtlas | null> {
+    const sources: AtlasTileSource[] = [];
+
+    for (const materialDef of Array.from(this.materials.values())) {
+      // Same rule as createMaterial: a non-hex diffuse is a texture path, rendered white
+      const color = materialDef.diffuse.startsWith('#') ? materialDef.diffuse : '#ffffff';
+      const texture = materialDef.textures?.diffuse ? await this.loadTexture(materialDef.textures.diffuse) : null;
+      sources.push({ id: materialDef.id, image: (texture?.image as AtlasTileSource['image']) || undefined, color });
+    }
+
+    this.disposeAtlas();
+    this.atlas = TextureAtlas.build(sources);
+    if (!this.atlas) return null;
+
+    // Roughness is averaged and metalness dropped - the atlas material is shared by all tiles
+    const definitions = Array.from(this.materials.values());
+    const roughness = definitions.reduce((sum, def) => sum + (def.roughness ?? 0.5), 0) / definitions.length;
+    this.atlasMaterial = new THREE.MeshStandardMaterial({
+      map: this.atlas.texture,
+      color: 0xffffff,
+      roughness,
+      metalness: 0,
+    });
+    this.atlasMaterial.name = 'material_atlas';
+    this.atlasMaterial.userData.shared = true;
+
+    return this.atlas;
+  }
+
+  /**
+   * Get the texture atlas (null until built)
+   */
+  getAtlas(): TextureAtlas | null {
+    return this.atlas;
+  }
+
+  /**
+   * Get the shared material sampling the atlas (null until built)
+   * Meshes using it must have their UVs remapped into atlas regions
+   */
+  getAtlasMaterial(): THREE.MeshStandardMaterial | null {
+    return this.atlasMaterial;
+  }
+
+  private disposeAtlas(): void {
+    this.atlasMaterial?.dispose();
+    this.atlasMaterial = null;
+    this.atlas?.dispose();
+    this.atlas = null;
+  }
+
   /**
    * Get material by ID (returns cached instance or creates new one)
    */
@@ -253,6 +331,8 @@ export class MaterialLibrary {
     });
     this.textureCache.clear();
 
+    this.disposeAtlas();
+
     Debug.log('MaterialLibrary', 'Cleared material cache');
   }
 
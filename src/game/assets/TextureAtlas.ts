@@ -0,0 +1,159 @@
+import * as THREE from 'three';
+import { Debug } from '../utils/debug';
+
+/**
+ * Normalized UV rectangle of a tile inside the atlas
+ */
+export interface AtlasRegion {
+  u0: number;
+  v0: number;
+  u1: number;
+  v1: number;
+}
+
+/**
+ * Source for one atlas tile - an image, a flat color, or an image tinted by a color
+ */
+export interface AtlasTileSource {
+  id: string;
+  image?: CanvasImageSource & { width: number; height: number };
+  color?: string; // CSS color (multiplied over the image when both are set)
+}
+
+const DEFAULT_TILE_SIZE = 64;
+const MAX_ATLAS_SIZE = 4096;
+
+/**
+ * Texture Atlas - Packs retro textures into a single texture
+ * Lets multi-material brushes render with one shared material (one draw call)
+ * by remapping their UVs into the atlas at geometry build time.
+ *
+ * Tiles are packed on a uniform grid sized by the largest source image, which
+ * suits retro texture sets (same-sized, power-of-two tiles).
+ */
+export class TextureAtlas {
+  public readonly texture: THREE.CanvasTexture;
+  private regions: Map<string, AtlasRegion> = new Map();
+
+  private constructor(texture: THREE.CanvasTexture, regions: Map<string, AtlasRegion>) {
+    this.texture = texture;
+    this.regions = regions;
+  }
+
+  /**
+   * Pack tile sources into a new atlas
+   * Returns null if there is nothing to pack or the tiles don't fit
+   */
+  static build(sources: AtlasTileSource[]): TextureAtlas | null {
+    if (sources.length === 0) return null;
+
+    const tileSize = sources.reduce((size, source) => {
+      if (!source.image) return size;
+      return Math.max(size, THREE.MathUtils.ceilPowerOfTwo(Math.max(source.image.width, source.image.height)));
+    }, 0) || DEFAULT_TILE_SIZE;
+
+    // Smallest power-of-two square grid holding all tiles
+    const columns = THREE.MathUtils.ceilPowerOfTwo(Math.ceil(Math.sqrt(sources.length)));
+    const size = columns * tileSize;
+    if (size > MAX_ATLAS_SIZE) {
+      Debug.warn('TextureAtlas', `Atlas would be ${size}px (max ${MAX_ATLAS_SIZE}px) - not building`);
+      return null;
+    }
+
+    const canvas = document.createElement('canvas');
+    canvas.width = size;
+    canvas.height = size;
+    const ctx = canvas.getContext('2d');
+    if (!ctx) {
+      Debug.warn('TextureAtlas', '2D canvas context unavailable - not building');
+      return null;
+    }
+    ctx.imageSmoothingEnabled = false; // Keep texels crisp when scaling smaller images up
+
+    const regions = new Map<string, AtlasRegion>();
+    // Inset by half a texel so nearest filtering never samples a neighbouring tile
+    const inset = 0.5 / size;
+
+    sources.forEach((source, index) => {
+      const x = (index % columns) * tileSize;
+      const y = Math.floor(index / columns) * tileSize;
+
+      if (source.image) {
+        ctx.drawImage(source.image, x, y, tileSize, tileSize);
+        if (source.color) {
+          ctx.globalCompositeOperation = 'multiply';
+          ctx.fillStyle = source.color;
+          ctx.fillRect(x, y, tileSize, tileSize);
+          ctx.globalCompositeOperation = 'source-over';
+        }
+      } else {
+        ctx.fillStyle = source.color || '#ffffff';
+        ctx.fillRect(x, y, tileSize, tileSize);
+      }
+
+      // Canvas y grows downwards, texture v grows upwards (flipY)
+      regions.set(source.id, {
+        u0: x / size + inset,
+        v0: 1 - (y + tileSize) / size + inset,
+        u1: (x + tileSize) / size - inset,
+        v1: 1 - y / size - inset,
+      });
+    });
+
+    const texture = new THREE.CanvasTexture(canvas);
+    texture.colorSpace = THREE.SRGBColorSpace;
+    texture.minFilter = THREE.NearestFilter;
+    texture.magFilter = THREE.NearestFilter;
+    texture.generateMipmaps = false;
+
+    Debug.log('TextureAtlas', `Packed ${sources.length} tiles into ${size}x${size} atlas (${tileSize}px tiles)`);
+    return new TextureAtlas(texture, regions);
+  }
+
+  /**
+   * Get the atlas region of a tile
+   */
+  getRegion(id: string): AtlasRegion | null {
+    return this.regions.get(id) || null;
+  }
+
+  /**
+   * Check if all given tile IDs are packed in this atlas
+   */
+  hasAll(ids: Iterable<string>): boolean {
+    for (const id of ids) {
+      if (!this.regions.has(id)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Remap UVs of a vertex range into a tile region
+   * @param sourceUVs Original (0..1) UVs - kept separately so remapping can be redone
+   */
+  static remapUVs(
+    uv: THREE.BufferAttribute,
+    sourceUVs: ArrayLike<number>,
+    start: number,
+    count: number,
+    region: AtlasRegion
+  ): void {
+    const du = region.u1 - region.u0;
+    const dv = region.v1 - region.v0;
+    for (let i = start; i < start + count; i++) {
+      // Clamp: atlas tiles can't repeat, so tiling > 1 is not supported here
+      const u = THREE.MathUtils.clamp(sourceUVs[i * 2], 0, 1);
+      const v = THREE.MathUtils.clamp(sourceUVs[i * 2 + 1], 0, 1);
+      uv.setXY(i, region.u0 + u * du, region.v0 + v * dv);
+    }
+    uv.needsUpdate = true;
+  }
+
+  /**
+   * Cleanup
+   */
+  dispose(): void {
+    this.texture.dispose();
+    this.regions.clear();
+  }
+}
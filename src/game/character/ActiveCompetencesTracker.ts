@@ -1,4 +1,5 @@
 import { Competence } from './data/CompetenceData';
+import { Channel } from '../utils/EventBus';
 
 /**
  * Tracks competences that are actively being used within their XP timeframes
@@ -24,6 +25,7 @@ import { Competence } from './data/CompetenceData';
 export class ActiveCompetencesTracker {
   private activeCompetences: Map<Competence, number>; // competence -> timestamp when it was last marked active
   private xpTimeframe: number; // XP timeframe in milliseconds - each CT can gain XP for this duration after being used
+  private changes: Channel<number> = new Channel('activeCompetences'); // Active CT count after each change
 
   constructor(xpTimeframe: number = 2000) {
     // Default 2 seconds - each CT can gain XP for 2 seconds after being used
@@ -54,6 +56,7 @@ export class ActiveCompetencesTracker {
     // If already active, this extends/resets the timer to another xpTimeframe milliseconds
     this.activeCompetences.set(competence, timestamp);
     this.cleanupOld(timestamp);
+    this.changed();
   }
 
   /**
@@ -71,6 +74,7 @@ export class ActiveCompetencesTracker {
       this.activeCompetences.set(comp, timestamp);
     });
     this.cleanupOld(timestamp);
+    this.changed();
   }
 
   /**
@@ -91,6 +95,18 @@ export class ActiveCompetencesTracker {
    */
   clear(): void {
     this.activeCompetences.clear();
+    this.changed();
+  }
+
+  /**
+   * Subscribe to changes (competences marked, cleared or restored - not expiry); at most once per frame
+   */
+  subscribe(listener: () => void): () => void {
+    return this.changes.subscribe(() => listener());
+  }
+
+  private changed(): void {
+    this.changes.publish(this.activeCompetences.size);
   }
 
   /**
@@ -113,6 +129,7 @@ export class ActiveCompetencesTracker {
    */
   setXpTimeframe(ms: number): void {
     this.xpTimeframe = ms;
+    this.changed();
   }
 
   /**
@@ -143,5 +160,25 @@ export class ActiveCompetencesTracker {
     
     return result;
   }
-}
 
+  /**
+   * Capture the active competences for a save game
+   * Stored as remaining time rather than timestamps, so timers resume where they were after a reload
+   */
+  getSnapshot(currentTime: number = Date.now()): Array<[Competence, number]> {
+    return this.getActiveCompetencesWithRemainingTime(currentTime).map(({ competence, remainingTime }) => [competence, remainingTime]);
+  }
+
+  /**
+   * Restore the active competences from a save game snapshot
+   */
+  restoreSnapshot(snapshot: Array<[Competence, number]>, currentTime: number = Date.now()): void {
+    this.activeCompetences.clear();
+    snapshot.forEach(([competence, remainingTime]) => {
+      if (remainingTime > 0) {
+        this.activeCompetences.set(competence, currentTime - (this.xpTimeframe - remainingTime));
+      }
+    });
+    this.changed();
+  }
+}
@@ -3,6 +3,7 @@ import { Aptitude, getAptitudeAttributes } from './data/AptitudeData';
 import { Competence } from './data/CompetenceData';
 import { Souffrance } from './data/SouffranceData';
 import { getMasteries } from './data/MasteryRegistry';
+import { Channel } from '../utils/EventBus';
 
 /**
  * Character Sheet State Manager
@@ -52,8 +53,40 @@ export interface SouffranceData {
   eternalMarkIndices: number[];
 }
 
+/**
+ * Compact character sheet state for save games
+ * Mark arrays are bitsets (100 marks = 4 words) instead of boolean[100]; aptitudes are recalculated on restore
+ */
+export interface CharacterSheetSnapshot {
+  attributes: Record<Attribute, number>;
+  competences: Partial<Record<Competence, Omit<CompetenceData, 'marks'> & { marks: Uint32Array }>>;
+  souffrances: Partial<Record<Souffrance, Omit<SouffranceData, 'marks'> & { marks: Uint32Array }>>;
+  freeMarks: number;
+}
+
+/**
+ * Pack a mark array into a bitset (bit i of word i >> 5 = mark i)
+ */
+function packMarks(marks: boolean[]): Uint32Array {
+  const bits = new Uint32Array(Math.ceil(marks.length / 32));
+  marks.forEach((marked, i) => {
+    if (marked) bits[i >> 5] |= 1 << (i & 31);
+  });
+  return bits;
+}
+
+function unpackMarks(bits: Uint32Array, count: number): boolean[] {
+  const marks = new Array<boolean>(count);
+  for (let i = 0; i < count; i++) {
+    marks[i] = i >> 5 < bits.length && (bits[i >> 5] & (1 << (i & 31))) !== 0;
+  }
+  return marks;
+}
+
 export class CharacterSheetManager {
   private state: CharacterSheetState;
+  private changes: Channel<number> = new Channel('characterSheet'); // Revision after each change
+  private revision: number = 0;
 
   constructor() {
     this.state = this.createInitialState();
@@ -120,6 +153,17 @@ export class CharacterSheetManager {
     };
   }
 
+  /**
+   * Subscribe to sheet changes (at most once per frame, however many changes it had)
+   */
+  subscribe(listener: () => void): () => void {
+    return this.changes.subscribe(() => listener());
+  }
+
+  private changed(): void {
+    this.changes.publish(++this.revision);
+  }
+
   getState(): CharacterSheetState {
     // Create new objects for nested structures to ensure React detects changes
     const competences: Record<Competence, CompetenceData> = {} as Record<Competence, CompetenceData>;
@@ -154,6 +198,7 @@ export class CharacterSheetManager {
   }
 
   setAttribute(attribute: Attribute, value: number): void {
+    this.changed();
     this.state.attributes[attribute] = Math.max(-50, Math.min(50, value));
     this.recalculateAptitudes();
   }
@@ -206,6 +251,7 @@ export class CharacterSheetManager {
   }
 
   setCompetenceDegree(competence: Competence, degreeCount: number): void {
+    this.changed();
     const comp = this.state.competences[competence];
     const oldDegreeCount = comp.degreeCount;
     const oldLevel = this.getCompetenceLevel(competence);
@@ -232,10 +278,12 @@ export class CharacterSheetManager {
   }
 
   revealCompetence(competence: Competence): void {
+    this.changed();
     this.state.competences[competence].isRevealed = true;
   }
 
   addCompetenceMark(competence: Competence, isEternal: boolean = false): void {
+    this.changed();
     const comp = this.state.competences[competence];
     for (let i = 0; i < 100; i++) {
       if (!comp.marks[i]) {
@@ -257,6 +305,7 @@ export class CharacterSheetManager {
    * @param isEternal Whether these are eternal marks
    */
   addPartialMarks(competence: Competence, amount: number, isEternal: boolean = false): void {
+    this.changed();
     const comp = this.state.competences[competence];
     
     // Add to partial marks accumulator
@@ -355,6 +404,7 @@ export class CharacterSheetManager {
 
   realizeCompetence(competence: Competence): void {
     if (!this.isCompetenceEprouvee(competence)) return;
+    this.changed();
     
     const comp = this.state.competences[competence];
     const oldDegreeCount = comp.degreeCount;
@@ -386,10 +436,12 @@ export class CharacterSheetManager {
   }
 
   addFreeMarks(amount: number): void {
+    this.changed();
     this.state.freeMarks += amount;
   }
 
   spendFreeMarks(amount: number): boolean {
+    this.changed();
     if (this.state.freeMarks >= amount) {
       this.state.freeMarks -= amount;
       return true;
@@ -402,6 +454,7 @@ export class CharacterSheetManager {
   }
 
   setSouffranceDegree(souffrance: Souffrance, degreeCount: number): void {
+    this.changed();
     this.state.souffrances[souffrance].degreeCount = Math.max(0, degreeCount);
   }
 
@@ -415,6 +468,7 @@ export class CharacterSheetManager {
    * These are the R[Souffrance] compétences used to resist damage
    */
   addSouffranceMark(souffrance: Souffrance, isEternal: boolean = false): void {
+    this.changed();
     const souf = this.state.souffrances[souffrance];
     for (let i = 0; i < 100; i++) {
       if (!souf.marks[i]) {
@@ -468,6 +522,7 @@ export class CharacterSheetManager {
    * This is separate from souffrance degree count - only increases on realization normally
    */
   setResistanceDegreeCount(souffrance: Souffrance, degreeCount: number): void {
+    this.changed();
     this.state.souffrances[souffrance].resistanceDegreeCount = Math.max(0, degreeCount);
   }
 
@@ -509,6 +564,7 @@ export class CharacterSheetManager {
    */
   realizeSouffrance(souffrance: Souffrance): void {
     if (!this.isSouffranceEprouvee(souffrance)) return;
+    this.changed();
     
     const souf = this.state.souffrances[souffrance];
     const oldResistanceDegreeCount = souf.resistanceDegreeCount;
@@ -544,6 +600,7 @@ export class CharacterSheetManager {
    * @returns true if successful, false if insufficient points or invalid mastery
    */
   unlockMastery(competence: Competence, masteryName: string): boolean {
+    this.changed();
     const comp = this.state.competences[competence];
     
     // Check if we have mastery points available
@@ -614,6 +671,7 @@ export class CharacterSheetManager {
    * @returns true if successful, false if insufficient points or invalid mastery
    */
   upgradeMastery(competence: Competence, masteryName: string): boolean {
+    this.changed();
     const comp = this.state.competences[competence];
     
     // Check if we have mastery points available
@@ -646,6 +704,7 @@ export class CharacterSheetManager {
    * @param masteryName The name of the mastery to remove
    */
   removeMastery(competence: Competence, masteryName: string): boolean {
+    this.changed();
     const comp = this.state.competences[competence];
     const index = comp.masteries.findIndex(m => m.name === masteryName);
     
@@ -659,5 +718,75 @@ export class CharacterSheetManager {
     
     return true;
   }
-}
 
+  /**
+   * Capture the sheet for a save game
+   */
+  getSnapshot(): CharacterSheetSnapshot {
+    const competences: CharacterSheetSnapshot['competences'] = {};
+    Object.entries(this.state.competences).forEach(([key, comp]) => {
+      competences[key as Competence] = {
+        ...comp,
+        marks: packMarks(comp.marks),
+        eternalMarkIndices: [...comp.eternalMarkIndices],
+        masteries: comp.masteries.map(m => ({ ...m })),
+      };
+    });
+
+    const souffrances: CharacterSheetSnapshot['souffrances'] = {};
+    Object.entries(this.state.souffrances).forEach(([key, souf]) => {
+      souffrances[key as Souffrance] = {
+        ...souf,
+        marks: packMarks(souf.marks),
+        eternalMarkIndices: [...souf.eternalMarkIndices],
+      };
+    });
+
+    return {
+      attributes: { ...this.state.attributes },
+      competences,
+      souffrances,
+      freeMarks: this.state.freeMarks,
+    };
+  }
+
+  /**
+   * Replace the sheet with a save game snapshot (entries missing from the snapshot start fresh)
+   */
+  restoreSnapshot(snapshot: CharacterSheetSnapshot): void {
+    this.changed();
+    const state = this.createInitialState();
+
+    Object.keys(state.attributes).forEach((key) => {
+      const value = snapshot.attributes[key as Attribute];
+      if (typeof value === 'number') state.attributes[key as Attribute] = value;
+    });
+
+    Object.keys(state.competences).forEach((key) => {
+      const saved = snapshot.competences[key as Competence];
+      if (!saved) return;
+      const comp = state.competences[key as Competence];
+      state.competences[key as Competence] = {
+        ...saved,
+        marks: unpackMarks(saved.marks, comp.marks.length),
+        eternalMarkIndices: [...saved.eternalMarkIndices],
+        masteries: saved.masteries.map(m => ({ ...m })),
+      };
+    });
+
+    Object.keys(state.souffrances).forEach((key) => {
+      const saved = snapshot.souffrances[key as Souffrance];
+      if (!saved) return;
+      const souf = state.souffrances[key as Souffrance];
+      state.souffrances[key as Souffrance] = {
+        ...saved,
+        marks: unpackMarks(saved.marks, souf.marks.length),
+        eternalMarkIndices: [...saved.eternalMarkIndices],
+      };
+    });
+
+    state.freeMarks = snapshot.freeMarks;
+    this.state = state;
+    this.recalculateAptitudes();
+  }
+}
@@ -10,16 +10,35 @@ import { SouffranceHealthSystem } from '../character/SouffranceHealthSystem';
 import { ActiveCompetencesTracker } from '../character/ActiveCompetencesTracker';
 import { GAME_CONFIG } from '@/lib/constants';
 import { Debug } from '../utils/debug';
+import { FrameProfiler, FRAME_BUDGET_MS } from '../utils/FrameProfiler';
+import { Metrics } from '../utils/Metrics';
+import { Channel } from '../utils/EventBus';
 import { EntityManager } from '../ecs/EntityManager';
 import { EntityFactory } from '../ecs/factories/EntityFactory';
 import { PrefabManager } from '../ecs/prefab/PrefabManager';
+import { PrefabPool } from '../ecs/prefab/PrefabPool';
 import { SceneStorage } from '../ecs/storage/SceneStorage';
-import { SceneSerializer } from '../ecs/serialization/SceneSerializer';
+import { SceneSerializer, SerializedScene } from '../ecs/serialization/SceneSerializer';
+import { SceneLoader, type SceneLoadOptions } from '../ecs/serialization/SceneLoader';
 import { Entity } from '../ecs/Entity';
 import { logScene } from '@/editor/utils/debugLogger';
 import { ScriptLoader } from '../scripts/ScriptLoader';
+import { ScriptSystem } from '../scripts/ScriptSystem';
+import { ScriptWorkerHost } from '../scripts/ScriptWorkerHost';
+import type { GameApi } from '../scripts/types';
 import { TriggerComponent } from '../ecs/components/TriggerComponent';
 import { MaterialLibrary } from '../assets/MaterialLibrary';
+import { LightBaker, type LightBakeOptions, type LightBakeResult } from '../renderer/LightBaker';
+import { SaveGameState, SAVE_GAME_VERSION, type SaveGame } from './SaveGame';
+import { LevelStreamer } from './LevelStreamer';
+
+const AUTOSAVE_COMPACT_INTERVAL = 50; // Delta saves between full snapshots
+const THUMBNAIL_WIDTH = 160;
+const QUICK_SAVE_SLOT = 'quicksave';
+
+const frameInterval = Metrics.histogram('frame.interval_ms', 'Time between frame starts');
+const frameWork = Metrics.histogram('frame.work_ms', 'Update + render CPU time per frame');
+const gcSuspects = Metrics.counter('frame.gc_suspects', 'Long frames not explained by update/render work (likely GC pauses)');
 
 /**
  * Main game class that orchestrates all game systems
@@ -35,14 +54,39 @@ export class Game {
   private frameCount: number = 0;
   private lastFpsUpdate: number = 0;
   private fps: number = 0;
+  private fpsChanges: Channel<number> = new Channel('game.fps'); // Published once per second
+  private runningChanges: Channel<boolean> = new Channel('game.running'); // Published when the loop starts or stops
+  private profiler: FrameProfiler = new FrameProfiler();
+  private frameStart: number = 0;
+  private lastFrameWorkMs: number = 0;
+  private removeMetricsCollector: (() => void) | null = null;
+  private metricComponentTypes: Set<string> = new Set(); // Component types reported so far
   private characterSheetManager: CharacterSheetManager;
   private healthSystem: SouffranceHealthSystem;
   private entityManager: EntityManager | null = null;
   private entityFactory: EntityFactory | null = null;
   private prefabManager: PrefabManager | null = null;
+  private prefabPool: PrefabPool | null = null;
   private sceneStorage: SceneStorage | null = null;
+  private levelStreamer: LevelStreamer | null = null;
+  private gameApi: GameApi;
   private scriptLoader: ScriptLoader | null = null;
+  private scriptSystem: ScriptSystem | null = null;
+  private scriptWorker: ScriptWorkerHost | null = null;
   private materialLibrary: MaterialLibrary | null = null;
+  private sceneLoadController: AbortController | null = null;
+  private sceneUnload: Promise<void> = Promise.resolve(); // Previous scene's entities still being removed
+  // Scene that autosave writes into (last saved or loaded)
+  private currentSceneId: string | null = null;
+  private currentSceneName: string = 'Scene';
+  private deltaBaseline: boolean = false; // Stored snapshot has the current entity IDs, so deltas apply
+  private deltaSavesSinceSnapshot: number = 0;
+  private autosaveQueue: Promise<boolean> = Promise.resolve(true);
+  // Loaded entities get fresh IDs - saves keep writing the stored IDs, so save games and the entity
+  // IDs in component data (trigger targets) stay valid across reloads
+  private storedEntityIds: Map<string, string> = new Map(); // Live ID -> stored ID
+  private liveEntityIds: Map<string, string> = new Map(); // Stored ID -> live ID
+  private quickSaveGame: SaveGame | null = null;
 
   constructor(canvas: HTMLCanvasElement) {
     Debug.startMeasure('Game.constructor');
@@ -60,6 +104,9 @@ export class Game {
       Debug.log('Game', 'Initializing renderer...');
       this.renderer = new RetroRenderer(canvas);
       Debug.log('Game', 'Renderer initialized');
+      if (this.profiler.attachGpuTimer(this.renderer.renderer.getContext())) {
+        Debug.log('Game', 'GPU timer queries available for frame profiling');
+      }
 
       // Initialize physics world
       Debug.log('Game', 'Initializing physics world...');
@@ -110,6 +157,9 @@ export class Game {
       
       // Initialize script loader first (needed for entity factory)
       this.scriptLoader = new ScriptLoader();
+      this.gameApi = this.createGameApi();
+      this.scriptWorker = new ScriptWorkerHost(this.entityManager, this.gameApi);
+      this.scriptSystem = new ScriptSystem(this.entityManager, this.scriptLoader, { worker: this.scriptWorker, game: this.gameApi });
       
       // Initialize material library
       Debug.log('Game', 'Initializing material library...');
@@ -120,7 +170,22 @@ export class Game {
       
       this.entityFactory = new EntityFactory(this.entityManager, this.renderer, this.physicsWorld, this.scriptLoader);
       this.prefabManager = new PrefabManager();
+      this.prefabManager.setFactoryContext({
+        renderer: this.renderer,
+        physicsWorld: this.physicsWorld,
+        scriptLoader: this.scriptLoader,
+        materialLibrary: this.materialLibrary,
+      });
+      this.prefabPool = new PrefabPool(this.prefabManager, this.entityManager, this.renderer, this.physicsWorld);
+      // Scenes store prefab instances as overrides of their prefab
+      SceneSerializer.setPrefabSource(this.prefabManager);
       this.sceneStorage = new SceneStorage();
+      // Levels read ahead also fetch their scripts
+      this.levelStreamer = new LevelStreamer(this.sceneStorage, {
+        onFetched: (_levelId, serialized) => {
+          this.scriptSystem?.preload(ScriptSystem.collectScriptPaths(serialized));
+        },
+      });
       // Initialize storage asynchronously
       this.sceneStorage.initialize().catch(err => {
         Debug.warn('Game', 'Failed to initialize scene storage', err);
@@ -134,6 +199,8 @@ export class Game {
       
       Debug.log('Game', 'ECS system initialized');
 
+      this.removeMetricsCollector = Metrics.addCollector(() => this.collectMetrics());
+
       // Setup game loop
       Debug.log('Game', 'Setting up game loop...');
       this.gameLoop = new GameLoop(
@@ -156,7 +223,7 @@ export class Game {
   start(): void {
     try {
       Debug.log('Game', 'Starting game...');
-      this.gameLoop.start();
+      this.setLoopRunning(true);
       this.handleResize();
       window.addEventListener('resize', this.handleResize);
       this.lastFpsUpdate = performance.now();
@@ -171,7 +238,7 @@ export class Game {
    * Stop the game
    */
   stop(): void {
-    this.gameLoop.stop();
+    this.setLoopRunning(false);
     window.removeEventListener('resize', this.handleResize);
   }
 
@@ -179,18 +246,14 @@ export class Game {
    * Pause the game (pause physics simulation)
    */
   pause(): void {
-    if (this.gameLoop.getRunning()) {
-      this.gameLoop.stop();
-    }
+    this.setLoopRunning(false);
   }
 
   /**
    * Resume the game (resume physics simulation)
    */
   resume(): void {
-    if (!this.gameLoop.getRunning()) {
-      this.gameLoop.start();
-    }
+    this.setLoopRunning(true);
   }
 
   /**
@@ -200,35 +263,66 @@ export class Game {
     return this.gameLoop.getRunning();
   }
 
+  /**
+   * Subscribe to the game loop starting and stopping (pause/resume)
+   */
+  subscribeRunning(listener: (running: boolean) => void): () => void {
+    return this.runningChanges.subscribeLatest(listener);
+  }
+
+  private setLoopRunning(running: boolean): void {
+    if (this.gameLoop.getRunning() === running) return;
+    if (running) {
+      this.gameLoop.start();
+    } else {
+      this.gameLoop.stop();
+    }
+    this.runningChanges.publish(running);
+  }
+
   /**
    * Update game state
    */
   private update(deltaTime: number): void {
     try {
+      const now = performance.now();
+      this.recordFrameInterval(now);
+      this.profiler.beginFrame();
+
       // Step physics simulation
+      this.profiler.beginPhase('physics');
       this.physicsWorld.step(deltaTime);
 
       // Update character controller
+      this.profiler.beginPhase('character');
       this.characterController.update(deltaTime);
 
       // Update camera (handles movement input)
+      this.profiler.beginPhase('camera');
       this.camera.update(deltaTime);
 
       // Sync dynamic objects with physics
+      this.profiler.beginPhase('sceneSync');
       this.scene.update(deltaTime);
 
       // Update ECS entities
+      this.profiler.beginPhase('ecs');
       if (this.entityManager) {
         this.entityManager.update(deltaTime);
       }
+
+      // Run entity scripts (budgeted - see ScriptSystem)
+      this.profiler.beginPhase('scripts');
+      this.scriptSystem?.update(deltaTime);
+      this.profiler.endPhase();
       
       // Calculate FPS every second
       this.frameCount++;
-      const now = performance.now();
       if (now - this.lastFpsUpdate >= 1000) {
         this.fps = this.frameCount;
         this.frameCount = 0;
         this.lastFpsUpdate = now;
+        this.fpsChanges.publish(this.fps);
         
         if (this.fps < 30) {
           Debug.warn('Game', `Low FPS detected: ${this.fps} fps`);
@@ -244,9 +338,58 @@ export class Game {
    */
   private render(): void {
     try {
+      this.profiler.beginPhase('render');
+      this.profiler.beginGpu();
       this.renderer.renderer.render(this.scene.scene, this.camera.camera);
+      this.profiler.endGpu();
     } catch (error) {
       Debug.error('Game', 'Error in render loop', error as Error);
+    } finally {
+      this.profiler.endFrame();
+      this.lastFrameWorkMs = performance.now() - this.frameStart;
+      frameWork.record(this.lastFrameWorkMs);
+    }
+  }
+
+  private recordFrameInterval(now: number): void {
+    if (this.frameStart > 0) {
+      const interval = now - this.frameStart;
+      frameInterval.record(interval);
+      // A long gap after a cheap frame is time spent outside the game (GC, or the browser);
+      // gaps over a second are a hidden tab, not a pause
+      if (interval > 2 * FRAME_BUDGET_MS && interval < 1000 && this.lastFrameWorkMs < FRAME_BUDGET_MS) {
+        gcSuspects.inc();
+      }
+    }
+    this.frameStart = now;
+  }
+
+  /**
+   * Update gauges read on demand (runs when a metrics snapshot is taken)
+   */
+  private collectMetrics(): void {
+    const info = this.renderer.renderer.info;
+    Metrics.gauge('render.draw_calls', 'Draw calls in the last frame').set(info.render.calls);
+    Metrics.gauge('render.triangles', 'Triangles drawn in the last frame').set(info.render.triangles);
+    Metrics.gauge('render.geometries', 'Geometries on the GPU').set(info.memory.geometries);
+    Metrics.gauge('render.textures', 'Textures on the GPU').set(info.memory.textures);
+
+    const world = this.physicsWorld.world;
+    Metrics.gauge('physics.bodies', 'Rapier rigid bodies').set(world.bodies.len());
+    Metrics.gauge('physics.colliders', 'Rapier colliders').set(world.colliders.len());
+
+    if (this.entityManager) {
+      Metrics.gauge('ecs.entities', 'Entities').set(this.entityManager.getEntityCount());
+      const counts = this.entityManager.getComponentCounts();
+      counts.forEach((_count, type) => this.metricComponentTypes.add(type));
+      this.metricComponentTypes.forEach((type) => {
+        Metrics.gauge(`ecs.components.${type}`).set(counts.get(type) || 0);
+      });
+    }
+
+    const memory = (performance as Performance & { memory?: { usedJSHeapSize: number } }).memory;
+    if (memory) {
+      Metrics.gauge('js.heap_bytes', 'Used JS heap (Chromium only)').set(memory.usedJSHeapSize);
     }
   }
 
@@ -257,6 +400,20 @@ export class Game {
     return this.fps;
   }
 
+  /**
+   * Subscribe to the FPS counter (updated once per second)
+   */
+  subscribeFps(listener: (fps: number) => void): () => void {
+    return this.fpsChanges.subscribeLatest(listener);
+  }
+
+  /**
+   * Get frame profiler (per-phase timings of recent frames)
+   */
+  getFrameProfiler(): FrameProfiler {
+    return this.profiler;
+  }
+
   /**
    * Get character sheet manager (for UI integration)
    */
@@ -387,6 +544,13 @@ export class Game {
     return this.sceneStorage;
   }
 
+  /**
+   * Get ScriptSystem (for script profiling)
+   */
+  getScriptSystem(): ScriptSystem | null {
+    return this.scriptSystem;
+  }
+
   /**
    * Get ScriptLoader (for script operations)
    */
@@ -409,7 +573,40 @@ export class Game {
   }
 
   /**
-   * Set script loader for all existing trigger components
+   * Engine API for scripts, trigger actions and worker script commands
+   */
+  getGameApi(): GameApi {
+    return this.gameApi;
+  }
+
+  /**
+   * Get the pool used by GameApi spawns
+   */
+  getPrefabPool(): PrefabPool | null {
+    return this.prefabPool;
+  }
+
+  private createGameApi(): GameApi {
+    return {
+      getEntity: id => this.getEntityByStoredId(id),
+      setEntityEnabled: (entityId, enabled) => {
+        const entity = this.getEntityByStoredId(entityId);
+        if (entity) this.entityManager!.setEntityEnabled(entity, enabled);
+      },
+      spawnEntity: (prefabId, position) => this.prefabPool?.acquire(prefabId, position) || null,
+      despawnEntity: (entityId) => {
+        const entity = this.getEntityByStoredId(entityId);
+        if (entity) this.prefabPool?.release(entity);
+      },
+      preloadLevel: (levelId) => {
+        this.levelStreamer?.preload(levelId);
+      },
+      loadLevel: levelId => this.loadScene(levelId),
+    };
+  }
+
+  /**
+   * Set script loader, worker and game API for all existing trigger components
    */
   private setScriptLoaderForTriggers(): void {
     if (!this.entityManager || !this.scriptLoader) return;
@@ -419,6 +616,8 @@ export class Game {
       const triggerComponent = this.entityManager!.getComponent<TriggerComponent>(entity, 'TriggerComponent');
       if (triggerComponent) {
         triggerComponent.setScriptLoader(this.scriptLoader!);
+        if (this.scriptWorker) triggerComponent.setScriptWorker(this.scriptWorker);
+        triggerComponent.setGameApi(this.gameApi);
       }
     });
   }
@@ -459,6 +658,7 @@ export class Game {
     }
 
     try {
+      await this.sceneUnload; // The previous scene's entities must not end up in the snapshot
       const entityCount = this.entityManager.getAllEntities().length;
       const allEntities = this.entityManager.getAllEntities();
       logScene('saveScene: Serializing scene', {
@@ -468,7 +668,8 @@ export class Game {
         entityIds: allEntities.map(e => ({ id: e.id, name: e.name })),
       });
 
-      const serialized = SceneSerializer.serialize(this.entityManager, sceneName, author);
+      const serialized = SceneSerializer.serialize(this.entityManager, sceneName, author, { entityId: this.toStoredId });
+      this.entityManager.takeChanges(); // Everything up to here is in the snapshot
       console.log('[Game] saveScene: Scene serialized', {
         sceneName,
         entityCount: serialized.entities.length,
@@ -476,8 +677,9 @@ export class Game {
         metadata: serialized.metadata,
       });
 
-      const id = await this.sceneStorage.saveScene(serialized);
+      const id = await this.sceneStorage.saveScene(serialized, undefined, { thumbnail: this.captureThumbnail() });
       if (id) {
+        this.setCurrentScene(id, sceneName, true);
         Debug.log('Game', `Scene saved: ${sceneName} (${id})`);
         console.log('[Game] saveScene: Scene saved successfully', {
           sceneName,
@@ -490,6 +692,7 @@ export class Game {
       }
       return id;
     } catch (error) {
+      this.deltaBaseline = false; // Changes were taken for the failed snapshot
       Debug.error('Game', 'Failed to save scene', error as Error);
       console.error('[Game] saveScene: Error saving scene', {
         sceneName,
@@ -501,9 +704,236 @@ export class Game {
   }
 
   /**
-   * Load scene from storage
+   * Render the current view into a small JPEG data URL (for the scene browser)
+   */
+  private captureThumbnail(): string | undefined {
+    try {
+      const canvas = document.createElement('canvas');
+      canvas.width = THUMBNAIL_WIDTH;
+      canvas.height = Math.round(THUMBNAIL_WIDTH * this.canvas.height / Math.max(1, this.canvas.width));
+      const ctx = canvas.getContext('2d');
+      if (!ctx) return undefined;
+      // The drawing buffer is only valid right after a render
+      this.renderer.renderer.render(this.scene.scene, this.camera.camera);
+      ctx.drawImage(this.renderer.renderer.domElement, 0, 0, canvas.width, canvas.height);
+      return canvas.toDataURL('image/jpeg', 0.7);
+    } catch (error) {
+      Debug.warn('Game', 'Failed to capture scene thumbnail', error);
+      return undefined;
+    }
+  }
+
+  /**
+   * Save edits into the current scene (the last one saved or loaded)
+   * Writes only changed entities; a full snapshot compacts the deltas now and then
+   */
+  autosaveScene(): Promise<boolean> {
+    // Serialize writes - a delta must not land before the snapshot it applies to;
+    // none starts while the previous scene is still being removed
+    this.autosaveQueue = this.autosaveQueue.then(() => this.sceneUnload).then(() => this.writeAutosave());
+    return this.autosaveQueue;
+  }
+
+  /**
+   * Get the ID of the scene autosave writes into (null until a scene is saved or loaded)
+   */
+  getCurrentSceneId(): string | null {
+    return this.currentSceneId;
+  }
+
+  private setCurrentScene(id: string | null, name: string, deltaBaseline: boolean): void {
+    this.currentSceneId = id;
+    this.currentSceneName = name;
+    this.deltaBaseline = deltaBaseline;
+    this.deltaSavesSinceSnapshot = 0;
+  }
+
+  /**
+   * Record how stored scene entity IDs map to live entities (empty = identical)
+   */
+  private setEntityIdMap(storedToLive: Map<string, string>): void {
+    this.liveEntityIds = storedToLive;
+    this.storedEntityIds = new Map();
+    storedToLive.forEach((liveId, storedId) => this.storedEntityIds.set(liveId, storedId));
+  }
+
+  /**
+   * Stored scene ID of a live entity (entities created since the load keep their own ID)
+   */
+  private toStoredId = (id: string): string => this.storedEntityIds.get(id) || id;
+
+  /**
+   * Find a live entity by the ID it has in the stored scene, or by its live ID
+   */
+  private getEntityByStoredId(id: string): Entity | null {
+    return this.entityManager?.getEntity(this.liveEntityIds.get(id) || id) || null;
+  }
+
+  /**
+   * Capture the full runtime state (world, player, character sheet) as a save game
+   * Synchronous and allocation-light, so it fits in a frame
+   */
+  captureSaveGame(): SaveGame | null {
+    if (!this.entityManager) {
+      Debug.error('Game', 'ECS system not initialized');
+      return null;
+    }
+
+    const orientation = this.camera.camera.quaternion;
+    return {
+      version: SAVE_GAME_VERSION,
+      savedAt: Date.now(),
+      sceneId: this.currentSceneId,
+      sceneName: this.currentSceneName,
+      player: {
+        position: this.characterController.getPosition(),
+        verticalVelocity: this.characterController.getVerticalVelocity(),
+        orientation: { x: orientation.x, y: orientation.y, z: orientation.z, w: orientation.w },
+      },
+      world: SaveGameState.captureWorld(this.entityManager, this.toStoredId),
+      character: this.characterSheetManager.getSnapshot(),
+      activeCompetences: this.getActiveCompetencesTracker().getSnapshot(),
+    };
+  }
+
+  /**
+   * Restore a save game onto the current scene (synchronous)
+   * The save must have been taken in the loaded scene - see loadGame for switching scenes
    */
-  async loadScene(sceneId: string): Promise<boolean> {
+  applySaveGame(save: SaveGame): boolean {
+    if (!this.entityManager) {
+      Debug.error('Game', 'ECS system not initialized');
+      return false;
+    }
+    if (save.version > SAVE_GAME_VERSION) {
+      Debug.error('Game', `Save game version ${save.version} is newer than supported (${SAVE_GAME_VERSION})`);
+      return false;
+    }
+
+    const { restored, missing } = SaveGameState.restoreWorld(
+      this.entityManager,
+      save.world,
+      id => this.liveEntityIds.get(id) || id
+    );
+    if (missing > 0) {
+      Debug.warn('Game', `Save game: ${missing} saved entities are no longer in the scene`);
+    }
+
+    const { position, verticalVelocity, orientation } = save.player;
+    this.characterController.restoreMotion(new THREE.Vector3(position.x, position.y, position.z), verticalVelocity);
+    this.camera.camera.quaternion.set(orientation.x, orientation.y, orientation.z, orientation.w);
+    this.characterSheetManager.restoreSnapshot(save.character);
+    this.getActiveCompetencesTracker().restoreSnapshot(save.activeCompetences);
+
+    Debug.log('Game', `Save game restored: ${restored} entities`);
+    return true;
+  }
+
+  /**
+   * Quick-save: capture within the frame, then write to storage in the background
+   */
+  quickSave(): boolean {
+    const start = performance.now();
+    const save = this.captureSaveGame();
+    if (!save) return false;
+
+    this.quickSaveGame = save;
+    Debug.log('Game', `Quick-saved in ${(performance.now() - start).toFixed(2)}ms`);
+
+    this.sceneStorage?.saveGame(QUICK_SAVE_SLOT, save).catch((error) => {
+      Debug.error('Game', 'Failed to write quick-save', error as Error);
+    });
+    return true;
+  }
+
+  /**
+   * Quick-load: restore the last quick-save (from memory, or storage after a reload)
+   * Restoring is synchronous; only a save from another scene waits for that scene to load
+   */
+  async quickLoad(): Promise<boolean> {
+    try {
+      const save = this.quickSaveGame || await this.sceneStorage?.loadGame(QUICK_SAVE_SLOT) || null;
+      if (!save) {
+        Debug.warn('Game', 'No quick-save to load');
+        return false;
+      }
+      return await this.loadGame(save);
+    } catch (error) {
+      Debug.error('Game', 'Quick-load failed', error as Error);
+      return false;
+    }
+  }
+
+  /**
+   * Load a save game, switching to its scene first if needed
+   */
+  async loadGame(save: SaveGame): Promise<boolean> {
+    if (save.sceneId && save.sceneId !== this.currentSceneId) {
+      if (!await this.loadScene(save.sceneId)) return false;
+    }
+
+    const start = performance.now();
+    const applied = this.applySaveGame(save);
+    if (applied) {
+      this.quickSaveGame = save;
+      Debug.log('Game', `Save game applied in ${(performance.now() - start).toFixed(2)}ms`);
+    }
+    return applied;
+  }
+
+  private async writeAutosave(): Promise<boolean> {
+    const sceneId = this.currentSceneId;
+    if (!this.entityManager || !this.sceneStorage || !sceneId) return false;
+    if (!this.entityManager.hasChanges()) return true;
+    // A load in progress holds the half-built entities of the next scene, which must not end up in
+    // the current scene's copy. Changes stay tracked: a cancelled load saves them next time
+    if (this.isSceneLoading()) {
+      logScene('autosave: Skipped during scene load', { sceneId });
+      return true;
+    }
+
+    try {
+      const { dirty, removed } = this.entityManager.takeChanges();
+      const entityCount = this.entityManager.getAllEntities().length;
+      const compact = !this.deltaBaseline
+        || this.deltaSavesSinceSnapshot >= AUTOSAVE_COMPACT_INTERVAL
+        || dirty.length > entityCount / 2;
+
+      if (compact) {
+        const serialized = SceneSerializer.serialize(this.entityManager, this.currentSceneName, undefined, { entityId: this.toStoredId });
+        await this.sceneStorage.saveScene(serialized, sceneId);
+        this.levelStreamer?.invalidate(sceneId);
+        this.deltaBaseline = true;
+        this.deltaSavesSinceSnapshot = 0;
+        logScene('autosave: Snapshot written', { sceneId, entityCount });
+      } else {
+        // Despawned (pooled) instances are saved as removed
+        const changed = dirty.filter(entity => !entity.metadata.pooled)
+          .map(entity => SceneSerializer.serializeEntity(this.entityManager!, entity, { entityId: this.toStoredId }));
+        dirty.forEach((entity) => {
+          if (entity.metadata.pooled) removed.push(entity.id);
+        });
+        const removedIds = removed.map(this.toStoredId);
+        await this.sceneStorage.saveSceneDelta(sceneId, { changed, removed: removedIds, entityCount });
+        this.levelStreamer?.invalidate(sceneId);
+        this.deltaSavesSinceSnapshot++;
+        logScene('autosave: Delta written', { sceneId, changed: changed.length, removed: removedIds.length });
+      }
+      return true;
+    } catch (error) {
+      // The taken changes are lost from tracking - fall back to a full snapshot next time
+      this.deltaBaseline = false;
+      Debug.error('Game', 'Autosave failed', error as Error);
+      return false;
+    }
+  }
+
+  /**
+   * Load a level - a scene from storage or a scene asset URL (see LevelStreamer)
+   * A preloaded level skips the read. Deserialization and the removal of the old scene are
+   * time-sliced across frames (see SceneLoader); resolves false if cancelled. URL levels are not autosaved.
+   */
+  async loadScene(sceneId: string, options: SceneLoadOptions = {}): Promise<boolean> {
     logScene('loadScene: Starting load', {
       sceneId,
       hasEntityManager: !!this.entityManager,
@@ -512,7 +942,7 @@ export class Game {
       currentSceneChildrenCount: this.scene.scene.children.length,
     });
 
-    if (!this.entityManager || !this.sceneStorage) {
+    if (!this.entityManager || !this.sceneStorage || !this.levelStreamer) {
       Debug.error('Game', 'ECS system or storage not initialized');
       logScene('loadScene: ECS system or storage not initialized', {
         entityManager: !!this.entityManager,
@@ -531,7 +961,11 @@ export class Game {
         beforeLoadSceneChildren,
       });
 
-      const serialized = await this.sceneStorage.loadScene(sceneId);
+      // Prefab instances resolve against the prefab library, which loads asynchronously
+      const [serialized] = await Promise.all([
+        this.levelStreamer.take(sceneId),
+        this.prefabManager?.whenReady(),
+      ]);
       if (!serialized) {
         Debug.error('Game', `Scene not found: ${sceneId}`);
         logScene('loadScene: Scene not found in storage', { sceneId });
@@ -546,30 +980,66 @@ export class Game {
         metadata: serialized.metadata,
       });
 
-      // Clear existing entities before loading new scene
-      Debug.log('Game', 'Clearing existing entities before loading scene...');
-      logScene('loadScene: Clearing existing entities', {
-        beforeClearEntityCount: this.entityManager.getAllEntities().length,
-        beforeClearSceneChildren: this.scene.scene.children.length,
-      });
-      this.entityManager.clearAll();
-      const afterClearSceneChildren = this.scene.scene.children.length;
-      logScene('loadScene: Entities cleared', {
-        afterClearEntityCount: this.entityManager.getAllEntities().length,
-        afterClearSceneChildren,
-      });
+      // Cancel a load still in flight - only the latest request wins
+      this.cancelSceneLoad();
+      const controller = new AbortController();
+      this.sceneLoadController = controller;
+      const abortLoad = () => controller.abort();
+      if (options.signal?.aborted) controller.abort();
+      options.signal?.addEventListener('abort', abortLoad, { once: true });
 
-      // Deserialize the new scene
+      // Deserialize across frames (atomic: the current scene stays until the new one is complete)
+      const mode = options.mode || 'atomic';
       logScene('loadScene: Deserializing scene', {
         entityCount: serialized.entities.length,
+        beforeLoadEntityCount: this.entityManager.getAllEntities().length,
+        mode,
       });
-      SceneSerializer.deserialize(this.entityManager, serialized, this.renderer, this.physicsWorld);
-      
+      // Fetch the scene's scripts while its entities are built
+      const scriptsReady = this.scriptSystem
+        ? this.scriptSystem.preload(ScriptSystem.collectScriptPaths(serialized))
+        : Promise.resolve(0);
+      const result = await SceneLoader.load(
+        this.entityManager,
+        serialized,
+        { renderer: this.renderer, physicsWorld: this.physicsWorld },
+        {
+          ...options,
+          mode,
+          origin: options.origin || (mode === 'progressive' ? this.characterController.getPosition() : undefined),
+          signal: controller.signal,
+        }
+      ).finally(() => {
+        // The caller's signal may outlive this load - don't keep the finished loader reachable from it
+        options.signal?.removeEventListener('abort', abortLoad);
+      });
+      if (this.sceneLoadController === controller) {
+        this.sceneLoadController = null;
+      }
+      if (result.status === 'cancelled') {
+        Debug.log('Game', `Scene load cancelled: ${serialized.metadata.name}`);
+        return false;
+      }
+
+      // Loaded entities get fresh IDs, so the first autosave writes a full snapshot
+      this.entityManager.takeChanges();
+      this.setCurrentScene(LevelStreamer.isUrl(sceneId) ? null : sceneId, serialized.metadata.name, false);
+      this.setEntityIdMap(result.idMap);
+      this.sceneUnload = result.unloaded;
+      // Worker scripts start over with the new scene (queued calls and state refer to the old one)
+      this.scriptWorker?.reset();
+      this.prefabPool?.clear();
+
       // Set script loader for all triggers after deserialization
       this.setScriptLoaderForTriggers();
       
       // Set material library for all material components after deserialization
       this.setMaterialLibraryForComponents();
+
+      // Compile shader programs now rather than on first view
+      await this.warmupShaders(serialized);
+      await scriptsReady;
+      await result.unloaded;
       
       const afterLoadEntityCount = this.entityManager.getAllEntities().length;
       const afterLoadSceneChildren = this.scene.scene.children.length;
@@ -599,6 +1069,90 @@ export class Game {
     }
   }
 
+  /**
+   * Cancel the scene load in progress (atomic loads keep the current scene)
+   */
+  cancelSceneLoad(): void {
+    if (this.sceneLoadController) {
+      this.sceneLoadController.abort();
+      this.sceneLoadController = null;
+    }
+  }
+
+  /**
+   * Check if a scene is currently being loaded
+   */
+  isSceneLoading(): boolean {
+    return this.sceneLoadController !== null;
+  }
+
+  /**
+   * Precompile the material/light shader variants of a freshly loaded scene
+   * Three.js compiles programs synchronously on first draw, which hitches when entering a level
+   */
+  private async warmupShaders(serialized: SerializedScene): Promise<void> {
+    const variants = this.collectShaderVariants(serialized);
+    logScene('loadScene: Warming up shaders', variants);
+
+    try {
+      const { newPrograms, durationMs } = await this.renderer.precompile(this.scene.scene, this.camera.camera);
+      Debug.log('Game', `Shaders precompiled: ${newPrograms} new programs in ${durationMs.toFixed(1)}ms`);
+      logScene('loadScene: Shaders precompiled', {
+        newPrograms,
+        totalPrograms: this.renderer.renderer.info.programs?.length || 0,
+        compileTimeMs: Math.round(durationMs * 10) / 10,
+      });
+    } catch (error) {
+      // Not fatal - programs will compile lazily on first draw
+      Debug.warn('Game', 'Shader warmup failed', error);
+    }
+  }
+
+  /**
+   * Enumerate material and light variants in a serialized scene
+   * Each distinct material kind and light setup maps to a separate shader program
+   */
+  private collectShaderVariants(serialized: SerializedScene): { materials: string[]; lights: Record<string, number> } {
+    const materials = new Set<string>();
+    const lights: Record<string, number> = {};
+
+    serialized.entities.forEach((entity) => {
+      SceneSerializer.resolveComponents(entity).forEach(({ type, data }) => {
+        if (type === 'MeshRendererComponent') {
+          if (data.bakedLighting) {
+            materials.add('basic+vertexColors');
+          } else {
+            materials.add(data.faceMaterialMap ? 'standard+perFace' : 'standard');
+          }
+        } else if (type === 'MaterialComponent') {
+          if (data.properties?.materialId) materials.add(`library:${data.properties.materialId}`);
+        } else if (type === 'LightComponent' && data.enabled !== false) {
+          const lightType = data.properties?.type || 'point';
+          lights[lightType] = (lights[lightType] || 0) + 1;
+        }
+      });
+    });
+
+    return { materials: Array.from(materials), lights };
+  }
+
+  /**
+   * Bake static lights into static brushes (per-vertex, replaces dynamic lighting on those meshes)
+   */
+  bakeLighting(options: LightBakeOptions = {}): LightBakeResult | null {
+    if (!this.entityManager) {
+      Debug.error('Game', 'ECS system not initialized');
+      return null;
+    }
+
+    try {
+      return LightBaker.bakeEntities(this.entityManager, options);
+    } catch (error) {
+      Debug.error('Game', 'Failed to bake lighting', error as Error);
+      return null;
+    }
+  }
+
   /**
    * Disable all game controls (for UI overlays like console)
    */
@@ -635,11 +1189,16 @@ export class Game {
    * Cleanup all resources
    */
   dispose(): void {
+    this.cancelSceneLoad();
+    SceneSerializer.setPrefabSource(null);
     this.stop();
     this.characterController.dispose();
     this.camera.dispose();
     this.scene.dispose();
     this.physicsWorld.dispose();
+    this.scriptWorker?.dispose();
+    this.profiler.dispose();
+    this.removeMetricsCollector?.();
     this.renderer.dispose();
   }
 }
@@ -0,0 +1,127 @@
+import type { SceneStorage } from '../ecs/storage/SceneStorage';
+import type { SerializedScene } from '../ecs/serialization/SceneSerializer';
+import { BinarySceneDecoder, BINARY_SCENE_MAGIC } from '../ecs/serialization/BinarySceneFormat';
+import { Debug } from '../utils/debug';
+import { Metrics } from '../utils/Metrics';
+import { Tracer } from '../utils/Tracer';
+
+export interface LevelStreamerOptions {
+  maxCached?: number; // Preloaded levels kept before the oldest is dropped
+  onFetched?: (levelId: string, serialized: SerializedScene) => void; // Start dependent loads (scripts)
+}
+
+const DEFAULT_MAX_CACHED = 4;
+
+const fetchTime = Metrics.histogram('level.fetch_ms', 'Time to read or download a level');
+const cacheHits = Metrics.counter('level.preload_hits', 'Level loads served by a preload');
+
+/**
+ * Level Streamer - reads levels ahead of use
+ * A level is a scene ID in SceneStorage or an asset URL (JSON or binary scene). preload() starts
+ * the read in the background and keeps the result (or the read in flight) until the level is
+ * taken, so a transition only has to build the scene. Failed reads are not kept.
+ */
+export class LevelStreamer {
+  private sceneStorage: SceneStorage;
+  private maxCached: number;
+  private onFetched: LevelStreamerOptions['onFetched'];
+  private levels: Map<string, Promise<SerializedScene | null>> = new Map(); // Insertion order = age
+
+  constructor(sceneStorage: SceneStorage, options: LevelStreamerOptions = {}) {
+    this.sceneStorage = sceneStorage;
+    this.maxCached = options.maxCached ?? DEFAULT_MAX_CACHED;
+    this.onFetched = options.onFetched;
+  }
+
+  /**
+   * Level IDs that are asset URLs rather than stored scenes
+   */
+  static isUrl(levelId: string): boolean {
+    return /^(https?:)?\/\//.test(levelId) || levelId.startsWith('/') || levelId.startsWith('./') || /\.(json|drds)$/i.test(levelId);
+  }
+
+  /**
+   * Start reading a level (shares a read already started)
+   */
+  preload(levelId: string): Promise<SerializedScene | null> {
+    const cached = this.levels.get(levelId);
+    if (cached) return cached;
+
+    const promise = this.fetch(levelId).then((serialized) => {
+      if (!serialized) this.levels.delete(levelId);
+      return serialized;
+    });
+    this.levels.set(levelId, promise);
+    while (this.levels.size > this.maxCached) {
+      this.levels.delete(this.levels.keys().next().value!);
+    }
+    return promise;
+  }
+
+  /**
+   * Get a level for loading - the preloaded copy if there is one (dropped from the cache, so the
+   * next visit reads the saved state again)
+   */
+  take(levelId: string): Promise<SerializedScene | null> {
+    const cached = this.levels.get(levelId);
+    if (cached) {
+      this.levels.delete(levelId);
+      cacheHits.inc();
+      return cached;
+    }
+    return this.fetch(levelId);
+  }
+
+  isPreloaded(levelId: string): boolean {
+    return this.levels.has(levelId);
+  }
+
+  /**
+   * Drop preloaded levels (all of them without an ID), e.g. after the stored scene changed
+   */
+  invalidate(levelId?: string): void {
+    if (levelId === undefined) {
+      this.levels.clear();
+    } else {
+      this.levels.delete(levelId);
+    }
+  }
+
+  private async fetch(levelId: string): Promise<SerializedScene | null> {
+    const start = performance.now();
+    const span = Tracer.asyncBegin(`level.fetch ${levelId}`, 'scene');
+    try {
+      const serialized = LevelStreamer.isUrl(levelId)
+        ? await this.download(levelId)
+        : await this.sceneStorage.loadScene(levelId);
+      if (!serialized) {
+        Debug.warn('LevelStreamer', `Level not found: ${levelId}`);
+        return null;
+      }
+      fetchTime.record(performance.now() - start);
+      this.onFetched?.(levelId, serialized);
+      return serialized;
+    } catch (error) {
+      Debug.error('LevelStreamer', `Failed to read level ${levelId}`, error as Error);
+      return null;
+    } finally {
+      Tracer.asyncEnd(span);
+    }
+  }
+
+  private async download(url: string): Promise<SerializedScene> {
+    const response = await fetch(url);
+    if (!response.ok) {
+      throw new Error(`HTTP ${response.status}`);
+    }
+    const bytes = new Uint8Array(await response.arrayBuffer());
+    const isBinary = bytes.length >= 4 && new DataView(bytes.buffer, bytes.byteOffset, 4).getUint32(0, true) === BINARY_SCENE_MAGIC;
+    const serialized: SerializedScene = isBinary
+      ? BinarySceneDecoder.decode(bytes)
+      : JSON.parse(new TextDecoder().decode(bytes));
+    if (!Array.isArray(serialized?.entities)) {
+      throw new Error('Not a scene');
+    }
+    return serialized;
+  }
+}
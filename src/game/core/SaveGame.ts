@@ -0,0 +1,181 @@
+import { Competence } from '../character/data/CompetenceData';
+import type { CharacterSheetSnapshot } from '../character/CharacterSheetManager';
+import { EntityManager } from '../ecs/EntityManager';
+import { TransformComponent } from '../ecs/components/TransformComponent';
+import { PhysicsComponent } from '../ecs/components/PhysicsComponent';
+import { TriggerComponent } from '../ecs/components/TriggerComponent';
+
+export const SAVE_GAME_VERSION = 1;
+
+// Per-entity flags in WorldSnapshot.flags
+const FLAG_ACTIVE = 1 << 0;
+const FLAG_TRANSFORM = 1 << 1;
+const FLAG_BODY = 1 << 2;
+const FLAG_SLEEPING = 1 << 3;
+const FLAG_TRIGGER = 1 << 4;
+const FLAG_TRIGGERED = 1 << 5;
+
+const TRANSFORM_STRIDE = 9; // position, rotation (euler), scale
+const BODY_STRIDE = 13; // translation, rotation (quaternion), linear velocity, angular velocity
+
+/**
+ * Runtime state of the scene entities, packed into flat typed arrays (entity i at i * stride)
+ * Entity IDs are the IDs in the stored scene, so a save survives reloading the scene
+ */
+export interface WorldSnapshot {
+  entityIds: string[];
+  flags: Uint8Array;
+  transforms: Float32Array;
+  bodies: Float32Array;
+}
+
+export interface PlayerSnapshot {
+  position: { x: number; y: number; z: number };
+  verticalVelocity: number;
+  orientation: { x: number; y: number; z: number; w: number }; // Camera quaternion
+}
+
+/**
+ * Save game - everything needed to resume play, on top of the scene it was taken in
+ */
+export interface SaveGame {
+  version: number;
+  savedAt: number;
+  sceneId: string | null;
+  sceneName: string;
+  player: PlayerSnapshot;
+  world: WorldSnapshot;
+  character: CharacterSheetSnapshot;
+  activeCompetences: Array<[Competence, number]>; // Competence -> remaining XP timeframe (ms)
+}
+
+/**
+ * Capture and restore the runtime state SceneSerializer leaves out
+ * (rigid-body velocities and sleep state, fired triggers, simulated transforms)
+ */
+export class SaveGameState {
+  /**
+   * Capture the runtime state of all entities
+   * @param toStoredId Maps a live entity ID to its ID in the stored scene
+   */
+  static captureWorld(entityManager: EntityManager, toStoredId: (id: string) => string = id => id): WorldSnapshot {
+    const entities = entityManager.getAllEntities();
+    const count = entities.length;
+    const world: WorldSnapshot = {
+      entityIds: new Array(count),
+      flags: new Uint8Array(count),
+      transforms: new Float32Array(count * TRANSFORM_STRIDE),
+      bodies: new Float32Array(count * BODY_STRIDE),
+    };
+
+    entities.forEach((entity, i) => {
+      let flags = entity.active ? FLAG_ACTIVE : 0;
+      world.entityIds[i] = toStoredId(entity.id);
+
+      const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+      if (transform) {
+        flags |= FLAG_TRANSFORM;
+        const t = i * TRANSFORM_STRIDE;
+        world.transforms.set([
+          transform.position.x, transform.position.y, transform.position.z,
+          transform.rotation.x, transform.rotation.y, transform.rotation.z,
+          transform.scale.x, transform.scale.y, transform.scale.z,
+        ], t);
+      }
+
+      const body = entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent')?.rigidBody;
+      if (body) {
+        flags |= FLAG_BODY;
+        if (body.isSleeping()) flags |= FLAG_SLEEPING;
+        const translation = body.translation();
+        const rotation = body.rotation();
+        const linvel = body.linvel();
+        const angvel = body.angvel();
+        world.bodies.set([
+          translation.x, translation.y, translation.z,
+          rotation.x, rotation.y, rotation.z, rotation.w,
+          linvel.x, linvel.y, linvel.z,
+          angvel.x, angvel.y, angvel.z,
+        ], i * BODY_STRIDE);
+      }
+
+      const trigger = entityManager.getComponent<TriggerComponent>(entity, 'TriggerComponent');
+      if (trigger) {
+        flags |= FLAG_TRIGGER;
+        if (trigger.isTriggered()) flags |= FLAG_TRIGGERED;
+      }
+
+      world.flags[i] = flags;
+    });
+
+    return world;
+  }
+
+  /**
+   * Restore a world snapshot onto the live entities
+   * Entities that did not exist when the snapshot was taken (e.g. spawned since) are removed
+   * @param toLiveId Maps a stored scene entity ID to the live entity ID
+   * @returns Number of entities restored and snapshot entities no longer in the scene
+   */
+  static restoreWorld(
+    entityManager: EntityManager,
+    world: WorldSnapshot,
+    toLiveId: (id: string) => string = id => id
+  ): { restored: number; missing: number } {
+    const snapshotIds = new Set<string>();
+    let restored = 0;
+    let missing = 0;
+
+    world.entityIds.forEach((storedId, i) => {
+      const liveId = toLiveId(storedId);
+      snapshotIds.add(liveId);
+      const entity = entityManager.getEntity(liveId);
+      if (!entity) {
+        missing++;
+        return;
+      }
+
+      const flags = world.flags[i];
+      const active = (flags & FLAG_ACTIVE) !== 0;
+      if (entity.active !== active) {
+        entityManager.setEntityEnabled(entity, active);
+      }
+
+      const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+      if (transform && flags & FLAG_TRANSFORM) {
+        const t = i * TRANSFORM_STRIDE;
+        const v = world.transforms;
+        transform.position.set(v[t], v[t + 1], v[t + 2]);
+        transform.rotation.set(v[t + 3], v[t + 4], v[t + 5]);
+        transform.scale.set(v[t + 6], v[t + 7], v[t + 8]);
+      }
+
+      const body = entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent')?.rigidBody;
+      if (body && flags & FLAG_BODY) {
+        const b = i * BODY_STRIDE;
+        const v = world.bodies;
+        const sleeping = (flags & FLAG_SLEEPING) !== 0;
+        body.setTranslation({ x: v[b], y: v[b + 1], z: v[b + 2] }, !sleeping);
+        body.setRotation({ x: v[b + 3], y: v[b + 4], z: v[b + 5], w: v[b + 6] }, !sleeping);
+        if (body.isDynamic()) {
+          body.setLinvel({ x: v[b + 7], y: v[b + 8], z: v[b + 9] }, !sleeping);
+          body.setAngvel({ x: v[b + 10], y: v[b + 11], z: v[b + 12] }, !sleeping);
+        }
+        if (sleeping) body.sleep();
+      }
+
+      const trigger = entityManager.getComponent<TriggerComponent>(entity, 'TriggerComponent');
+      if (trigger && flags & FLAG_TRIGGER) {
+        trigger.reset(); // Occupancy is rebuilt by the next collision events
+        trigger.setTriggered((flags & FLAG_TRIGGERED) !== 0);
+      }
+
+      entityManager.markDirty(entity);
+      restored++;
+    });
+
+    entityManager.removeEntities(entityManager.getAllEntities().filter(entity => !snapshotIds.has(entity.id)));
+
+    return { restored, missing };
+  }
+}
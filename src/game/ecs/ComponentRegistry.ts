@@ -0,0 +1,314 @@
+import * as THREE from 'three';
+import { Entity } from './Entity';
+import { Component } from './Component';
+import type { EntityManager } from './EntityManager';
+import type { SerializedComponent } from './serialization/SceneSerializer';
+import { TransformComponent } from './components/TransformComponent';
+import { MeshRendererComponent } from './components/MeshRendererComponent';
+import { PhysicsComponent } from './components/PhysicsComponent';
+import { LightComponent } from './components/LightComponent';
+import { TriggerComponent } from './components/TriggerComponent';
+import { MaterialComponent } from './components/MaterialComponent';
+import { ScriptComponent } from './components/ScriptComponent';
+import { Debug } from '../utils/debug';
+
+/**
+ * Services a factory may hand to a new component
+ * Missing services are injected later (e.g. Game.setScriptLoaderForTriggers)
+ */
+export interface ComponentFactoryContext {
+  renderer?: any;
+  physicsWorld?: any;
+  scriptLoader?: any;
+  materialLibrary?: any;
+}
+
+/**
+ * Writer handed to binary codecs (strings go through the scene string table, so repeats are stored once)
+ */
+export interface ComponentBinaryWriter {
+  u8(value: number): void;
+  varint(value: number): void;
+  f64(value: number): void;
+  float32Array(values: Float32Array): void;
+  string(value: string): void;
+}
+
+export interface ComponentBinaryReader {
+  u8(): number;
+  varint(): number;
+  f64(): number;
+  float32Array(count: number): Float32Array;
+  string(): string;
+}
+
+/**
+ * Optional compact encoding for a component's serialized data in the binary scene format
+ */
+export interface ComponentBinaryCodec {
+  /** Write the data - return false to fall back to the JSON block */
+  encode(data: any, writer: ComponentBinaryWriter): boolean;
+  decode(reader: ComponentBinaryReader): any;
+}
+
+export interface ComponentTypeDefinition<T extends Component = Component> {
+  type: string; // Component type key (as used by EntityManager.getComponent)
+  typeId: number; // Stable ID stored in binary scene files (0 is reserved for unregistered types)
+  componentClass: abstract new (...args: any[]) => T;
+  /** Build a component from its serialized data (not yet added to the entity) */
+  create(entity: Entity, data: any, context: ComponentFactoryContext): T;
+  /** Defaults to component.serialize() */
+  serialize?(component: T): any;
+  /** Runs once all components of a loaded entity are added (in registration order) */
+  afterLoad?(component: T, entityManager: EntityManager): void;
+  binary?: ComponentBinaryCodec;
+}
+
+interface RegisteredComponentType {
+  definition: ComponentTypeDefinition<any>;
+  order: number;
+}
+
+/**
+ * Component Registry - single table of component types shared by the ECS, SceneSerializer,
+ * PrefabManager and the binary scene format. Registering a type is all it takes for it to be
+ * saved, loaded and instantiated from prefabs.
+ */
+export class ComponentRegistry {
+  private static byType: Map<string, RegisteredComponentType> = new Map();
+  private static byId: Map<number, RegisteredComponentType> = new Map();
+  private static byClass: Map<Function, RegisteredComponentType> = new Map();
+
+  /**
+   * Register a component type
+   */
+  static register<T extends Component>(definition: ComponentTypeDefinition<T>): void {
+    if (definition.typeId <= 0 || definition.typeId > 0xff) {
+      throw new Error(`ComponentRegistry: type ID for ${definition.type} must be in 1..255`);
+    }
+    const existing = this.byId.get(definition.typeId);
+    if (existing && existing.definition.type !== definition.type) {
+      throw new Error(
+        `ComponentRegistry: type ID ${definition.typeId} of ${definition.type} is taken by ${existing.definition.type}`
+      );
+    }
+
+    const previous = this.byType.get(definition.type);
+    if (previous) {
+      this.byId.delete(previous.definition.typeId);
+      this.byClass.delete(previous.definition.componentClass);
+    }
+
+    const entry: RegisteredComponentType = { definition, order: previous ? previous.order : this.byType.size };
+    this.byType.set(definition.type, entry);
+    this.byId.set(definition.typeId, entry);
+    this.byClass.set(definition.componentClass, entry);
+  }
+
+  /**
+   * Get a type definition by type key
+   */
+  static get(type: string): ComponentTypeDefinition | null {
+    return this.byType.get(type)?.definition || null;
+  }
+
+  /**
+   * Get a type definition by binary type ID
+   */
+  static getById(typeId: number): ComponentTypeDefinition | null {
+    return this.byId.get(typeId)?.definition || null;
+  }
+
+  static has(type: string): boolean {
+    return this.byType.has(type);
+  }
+
+  /**
+   * Get all registered types (in registration order)
+   */
+  static getAll(): ComponentTypeDefinition[] {
+    return Array.from(this.byType.values()).map(entry => entry.definition);
+  }
+
+  /**
+   * Type key of a component instance
+   * Resolved through the registered class, so it survives class name minification
+   */
+  static getTypeName(component: Component): string {
+    return this.byClass.get(component.constructor)?.definition.type || component.constructor.name;
+  }
+
+  /**
+   * Serialize one component (null for unregistered types, which cannot be restored)
+   */
+  static serializeComponent(component: Component): SerializedComponent | null {
+    const entry = this.byClass.get(component.constructor);
+    if (!entry) return null;
+    const { definition } = entry;
+    return {
+      type: definition.type,
+      data: definition.serialize ? definition.serialize(component) : component.serialize(),
+    };
+  }
+
+  /**
+   * Create the components of one entity from serialized data and add them
+   * Returns the number of components created (unknown types are skipped with a warning)
+   */
+  static instantiateComponents(
+    entityManager: EntityManager,
+    entity: Entity,
+    components: SerializedComponent[],
+    context: ComponentFactoryContext
+  ): number {
+    const created: Array<{ entry: RegisteredComponentType; component: Component }> = [];
+
+    components.forEach((serializedComponent) => {
+      const entry = this.byType.get(serializedComponent.type);
+      if (!entry) {
+        Debug.warn('ComponentRegistry', `Unknown component type ${serializedComponent.type} on ${entity.name} - skipped`);
+        return;
+      }
+
+      try {
+        const component = entry.definition.create(entity, serializedComponent.data || {}, context);
+        entityManager.addComponent(entity, component);
+        created.push({ entry, component });
+      } catch (error) {
+        Debug.error('ComponentRegistry', `Failed to create ${serializedComponent.type} on ${entity.name}`, error as Error);
+      }
+    });
+
+    created
+      .sort((a, b) => a.entry.order - b.entry.order)
+      .forEach(({ entry, component }) => entry.definition.afterLoad?.(component, entityManager));
+
+    return created.length;
+  }
+}
+
+function getTransform(entity: Entity, entityManager: EntityManager): TransformComponent | null {
+  return entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+}
+
+function isNumberArray(value: any): value is number[] {
+  return Array.isArray(value) && value.every(v => typeof v === 'number');
+}
+
+// Built-in component types (type IDs are stored in binary scene files - never renumber)
+
+ComponentRegistry.register<TransformComponent>({
+  type: 'TransformComponent',
+  typeId: 1,
+  componentClass: TransformComponent,
+  create: (entity, data) => {
+    const transform = new TransformComponent(entity);
+    transform.deserialize(data);
+    return transform;
+  },
+});
+
+ComponentRegistry.register<PhysicsComponent>({
+  type: 'PhysicsComponent',
+  typeId: 3,
+  componentClass: PhysicsComponent,
+  create: (entity, data, context) => {
+    const physics = new PhysicsComponent(entity, data.properties, context.physicsWorld);
+    physics.deserialize(data);
+    return physics;
+  },
+  // Bodies are created at the origin - move them to the saved transform
+  afterLoad: (physics, entityManager) => {
+    const transform = getTransform(physics.entity, entityManager);
+    if (!transform || !physics.rigidBody) return;
+    const quat = new THREE.Quaternion().setFromEuler(transform.rotation);
+    physics.updateTransform(transform.getPosition(), { x: quat.x, y: quat.y, z: quat.z, w: quat.w });
+  },
+});
+
+ComponentRegistry.register<MeshRendererComponent>({
+  type: 'MeshRendererComponent',
+  typeId: 2,
+  componentClass: MeshRendererComponent,
+  create: (entity, data, context) => {
+    const meshRenderer = new MeshRendererComponent(entity, data.geometry, data.materialColor, context.renderer);
+    meshRenderer.deserialize(data);
+    return meshRenderer;
+  },
+  afterLoad: (meshRenderer, entityManager) => {
+    const transform = getTransform(meshRenderer.entity, entityManager);
+    if (!transform) return;
+    meshRenderer.updateTransform({
+      position: transform.position,
+      rotation: transform.rotation,
+      scale: transform.scale,
+    });
+  },
+  // Baked lighting as a Float32 array (saved rounded to 3 decimals), the rest as JSON
+  binary: {
+    encode: (data, writer) => {
+      if (!isNumberArray(data?.bakedLighting)) return false;
+      const { bakedLighting, ...rest } = data;
+      writer.string(JSON.stringify(rest));
+      writer.varint(bakedLighting.length);
+      writer.float32Array(Float32Array.from(bakedLighting));
+      return true;
+    },
+    decode: (reader) => {
+      const data = JSON.parse(reader.string());
+      const count = reader.varint();
+      data.bakedLighting = Array.from(reader.float32Array(count), v => Math.round(v * 1000) / 1000);
+      return data;
+    },
+  },
+});
+
+ComponentRegistry.register<LightComponent>({
+  type: 'LightComponent',
+  typeId: 4,
+  componentClass: LightComponent,
+  create: (entity, data) => {
+    const light = new LightComponent(entity, data.properties);
+    light.deserialize(data);
+    return light;
+  },
+  afterLoad: (light, entityManager) => {
+    const transform = getTransform(light.entity, entityManager);
+    if (transform) {
+      light.updateTransform(transform.position, transform.rotation);
+    }
+  },
+});
+
+ComponentRegistry.register<TriggerComponent>({
+  type: 'TriggerComponent',
+  typeId: 5,
+  componentClass: TriggerComponent,
+  create: (entity, data, context) => {
+    const trigger = new TriggerComponent(entity, data.properties, context.physicsWorld, context.scriptLoader);
+    trigger.deserialize(data);
+    return trigger;
+  },
+});
+
+ComponentRegistry.register<MaterialComponent>({
+  type: 'MaterialComponent',
+  typeId: 6,
+  componentClass: MaterialComponent,
+  create: (entity, data, context) => {
+    const material = new MaterialComponent(entity, data.properties, context.materialLibrary);
+    if (data.enabled !== undefined) material.enabled = data.enabled;
+    return material;
+  },
+});
+
+ComponentRegistry.register<ScriptComponent>({
+  type: 'ScriptComponent',
+  typeId: 7,
+  componentClass: ScriptComponent,
+  create: (entity, data) => {
+    const script = new ScriptComponent(entity, data.properties);
+    if (data.enabled !== undefined) script.enabled = data.enabled;
+    return script;
+  },
+});
@@ -5,6 +5,18 @@ function generateId(): string {
   return 'entity_' + Date.now().toString(36) + '_' + Math.random().toString(36).substr(2, 9);
 }
 
+/**
+ * Reserve IDs for a batch of entities (one timestamp and random prefix, then a counter)
+ */
+export function reserveEntityIds(count: number): string[] {
+  const prefix = generateId();
+  const ids = new Array<string>(count);
+  for (let i = 0; i < count; i++) {
+    ids[i] = prefix + '_' + i.toString(36);
+  }
+  return ids;
+}
+
 /**
  * Entity - A container for components
  * Entities are simple IDs with a name and optional metadata
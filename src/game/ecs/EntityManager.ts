@@ -1,5 +1,5 @@
 import * as THREE from 'three';
-import { Entity } from './Entity';
+import { Entity, reserveEntityIds } from './Entity';
 import { Component } from './Component';
 import { TransformComponent } from './components/TransformComponent';
 import { MeshRendererComponent } from './components/MeshRendererComponent';
@@ -7,13 +7,38 @@ import { PhysicsComponent } from './components/PhysicsComponent';
 import { LightComponent } from './components/LightComponent';
 import { TriggerComponent } from './components/TriggerComponent';
 import { MaterialComponent } from './components/MaterialComponent';
+import { ScriptComponent } from './components/ScriptComponent';
+import { ComponentRegistry } from './ComponentRegistry';
 import { RetroRenderer } from '../renderer/RetroRenderer';
 import { PhysicsWorld } from '../physics/PhysicsWorld';
-import { Debug } from '../utils/debug';
+import { Debug, LOG_DEBUG, LOG_TRACE } from '../utils/debug';
+import { Metrics } from '../utils/Metrics';
+
+/**
+ * Entities added and removed by one operation (a whole batch is reported at once)
+ */
+export interface EntityChangeEvent {
+  added: Entity[];
+  removed: Entity[];
+}
+
+export type EntityChangeListener = (event: EntityChangeEvent) => void;
+
+const queryCount = Metrics.counter('ecs.queries', 'Entity queries (all / by tag / from Object3D)');
+const componentLookups = Metrics.counter('ecs.component_lookups', 'getComponent calls');
+
+interface EntityBatch {
+  added: Entity[];
+  removed: Entity[];
+  sceneAdds: Set<THREE.Object3D>; // Applied when the batch ends
+  sceneRemovals: Set<THREE.Object3D>;
+  startTime: number;
+}
 
 /**
  * EntityManager - Manages all entities and their components
  * Acts as the central registry for the ECS system
+ * Bulk work (procedural placement, level unload) should go through batch() / createEntities() / removeEntities()
  */
 export class EntityManager {
   private entities: Map<string, Entity> = new Map();
@@ -21,6 +46,13 @@ export class EntityManager {
   private scene: THREE.Scene;
   private renderer: RetroRenderer;
   private physicsWorld: PhysicsWorld;
+  private warnedUnregisteredTypes: Set<string> = new Set();
+  // Changes since the last save (see SceneStorage delta saves)
+  private dirtyEntities: Set<string> = new Set();
+  private removedEntities: Set<string> = new Set();
+  private changeListeners: Set<EntityChangeListener> = new Set();
+  private scriptComponents: Set<ScriptComponent> = new Set(); // Run by ScriptSystem
+  private currentBatch: EntityBatch | null = null;
 
   constructor(scene: THREE.Scene, renderer: RetroRenderer, physicsWorld: PhysicsWorld) {
     this.scene = scene;
@@ -32,11 +64,57 @@ export class EntityManager {
    * Create a new entity
    */
   createEntity(name: string = 'Entity'): Entity {
-    const entity = new Entity(name);
-    this.entities.set(entity.id, entity);
-    this.components.set(entity.id, new Map());
-    Debug.log('EntityManager', `Created entity: ${name} (${entity.id})`);
-    return entity;
+    return this.registerEntity(new Entity(name));
+  }
+
+  /**
+   * Create several entities at once (IDs reserved together, one notification)
+   */
+  createEntities(names: string[]): Entity[] {
+    const ids = reserveEntityIds(names.length);
+    return this.batch(() => names.map((name, i) => this.registerEntity(new Entity(name, ids[i]))));
+  }
+
+  /**
+   * Run a bulk operation as one batch: meshes and lights enter/leave the scene in one pass at the end,
+   * per-entity logging is skipped and listeners get one aggregated notification.
+   * Nested calls join the outer batch.
+   */
+  batch<T>(operation: () => T): T {
+    if (this.currentBatch) return operation();
+
+    const batch: EntityBatch = {
+      added: [],
+      removed: [],
+      sceneAdds: new Set(),
+      sceneRemovals: new Set(),
+      startTime: performance.now(),
+    };
+    this.currentBatch = batch;
+    try {
+      return operation();
+    } finally {
+      this.currentBatch = null;
+      this.detachFromScene(batch.sceneRemovals);
+      batch.sceneAdds.forEach(object => this.scene.add(object));
+      if (batch.added.length > 0 || batch.removed.length > 0) {
+        if (LOG_DEBUG) {
+          Debug.log('EntityManager', () => `Batch: ${batch.added.length} entities created, ${batch.removed.length} removed in ${(performance.now() - batch.startTime).toFixed(1)}ms`);
+        }
+        this.notifyChange(batch.added, batch.removed);
+      }
+    }
+  }
+
+  /**
+   * Listen for entities being created or removed
+   * @returns Unsubscribe function
+   */
+  onEntitiesChanged(listener: EntityChangeListener): () => void {
+    this.changeListeners.add(listener);
+    return () => {
+      this.changeListeners.delete(listener);
+    };
   }
 
   /**
@@ -50,13 +128,42 @@ export class EntityManager {
    * Get all entities
    */
   getAllEntities(): Entity[] {
+    queryCount.inc();
     return Array.from(this.entities.values());
   }
 
+  /**
+   * Number of entities
+   */
+  getEntityCount(): number {
+    return this.entities.size;
+  }
+
+  /**
+   * Script components of all entities (see ScriptSystem)
+   */
+  getScriptComponents(): ReadonlySet<ScriptComponent> {
+    return this.scriptComponents;
+  }
+
+  /**
+   * Number of components of each type (for metrics)
+   */
+  getComponentCounts(): Map<string, number> {
+    const counts = new Map<string, number>();
+    this.components.forEach((entityComponents) => {
+      entityComponents.forEach((_component, type) => {
+        counts.set(type, (counts.get(type) || 0) + 1);
+      });
+    });
+    return counts;
+  }
+
   /**
    * Get entities by tag
    */
   getEntitiesByTag(tag: string): Entity[] {
+    queryCount.inc();
     return Array.from(this.entities.values()).filter(e => e.hasTag(tag));
   }
 
@@ -70,8 +177,14 @@ export class EntityManager {
       return;
     }
 
-    const componentType = component.constructor.name;
+    const componentType = ComponentRegistry.getTypeName(component);
     entityComponents.set(componentType, component);
+    this.dirtyEntities.add(entity.id);
+
+    if (!ComponentRegistry.has(componentType) && !this.warnedUnregisteredTypes.has(componentType)) {
+      this.warnedUnregisteredTypes.add(componentType);
+      Debug.warn('EntityManager', `${componentType} is not registered in ComponentRegistry - it will not be saved`);
+    }
     
     if (component.onAdd) {
       component.onAdd();
@@ -81,12 +194,12 @@ export class EntityManager {
     if (component instanceof MeshRendererComponent) {
       const mesh = component.getMesh(this.renderer);
       if (mesh) {
-        this.scene.add(mesh);
+        this.addToScene(mesh);
       }
     } else if (component instanceof LightComponent) {
       const light = component.getLight();
       if (light) {
-        this.scene.add(light);
+        this.addToScene(light);
       }
     } else if (component instanceof PhysicsComponent) {
       component.setPhysicsWorld(this.physicsWorld);
@@ -97,20 +210,34 @@ export class EntityManager {
     } else if (component instanceof MaterialComponent) {
       // Set material library if available (will be set from Game instance)
       // This is handled separately via Game.setMaterialLibraryForComponents()
+    } else if (component instanceof ScriptComponent) {
+      this.scriptComponents.add(component);
     }
 
-    Debug.log('EntityManager', `Added ${componentType} to entity ${entity.name} (${entity.id})`);
+    if (LOG_TRACE && !this.currentBatch) {
+      Debug.trace('EntityManager', () => `Added ${componentType} to entity ${entity.name} (${entity.id})`);
+    }
   }
 
   /**
    * Get component from entity
    */
   getComponent<T extends Component>(entity: Entity, componentType: string): T | null {
+    componentLookups.inc();
     const entityComponents = this.components.get(entity.id);
     if (!entityComponents) return null;
     return (entityComponents.get(componentType) as T) || null;
   }
 
+  /**
+   * Get all components of an entity (in the order they were added)
+   */
+  getComponents(entity: Entity): Component[] {
+    const entityComponents = this.components.get(entity.id);
+    if (!entityComponents) return [];
+    return Array.from(entityComponents.values());
+  }
+
   /**
    * Check if entity has component
    */
@@ -137,24 +264,83 @@ export class EntityManager {
       if (component instanceof MeshRendererComponent) {
         const mesh = component.getMesh();
         if (mesh) {
-          this.scene.remove(mesh);
+          this.removeFromScene(mesh);
         }
       } else if (component instanceof LightComponent) {
         const light = component.getLight();
         if (light) {
-          this.scene.remove(light);
+          this.removeFromScene(light);
         }
+      } else if (component instanceof ScriptComponent) {
+        this.scriptComponents.delete(component);
       }
 
       entityComponents.delete(componentType);
-      Debug.log('EntityManager', `Removed ${componentType} from entity ${entity.name} (${entity.id})`);
+      this.dirtyEntities.add(entity.id);
+      if (LOG_TRACE && !this.currentBatch) {
+        Debug.trace('EntityManager', () => `Removed ${componentType} from entity ${entity.name} (${entity.id})`);
+      }
     }
   }
 
+  /**
+   * Enable or disable an entity as a whole: visibility, physics bodies, trigger colliders and updates
+   * Enabling restores each component's own state (hidden meshes, disabled lights and bodies stay off)
+   */
+  setEntityEnabled(entity: Entity, enabled: boolean): void {
+    if (entity.active !== enabled) this.dirtyEntities.add(entity.id);
+    entity.active = enabled;
+    this.getComponents(entity).forEach((component) => {
+      if (component instanceof MeshRendererComponent) {
+        const mesh = component.getMesh();
+        if (mesh) mesh.visible = enabled && component.enabled && component.visible;
+      } else if (component instanceof LightComponent) {
+        const light = component.getLight();
+        if (light) light.visible = enabled && component.enabled;
+      } else if (component instanceof PhysicsComponent) {
+        component.rigidBody?.setEnabled(enabled && component.enabled);
+      } else if (component instanceof TriggerComponent) {
+        component.collider?.setEnabled(enabled && component.enabled && component.properties.enabled !== false);
+      }
+    });
+  }
+
+  /**
+   * Flag an entity as changed since the last save (call after editing its components)
+   */
+  markDirty(entity: Entity): void {
+    if (this.entities.has(entity.id)) {
+      this.dirtyEntities.add(entity.id);
+    }
+  }
+
+  /**
+   * Check if anything changed since the last save
+   */
+  hasChanges(): boolean {
+    return this.dirtyEntities.size > 0 || this.removedEntities.size > 0;
+  }
+
+  /**
+   * Get and reset the changes since the last call
+   */
+  takeChanges(): { dirty: Entity[]; removed: string[] } {
+    const dirty: Entity[] = [];
+    this.dirtyEntities.forEach((id) => {
+      const entity = this.entities.get(id);
+      if (entity) dirty.push(entity);
+    });
+    const removed = Array.from(this.removedEntities);
+    this.dirtyEntities.clear();
+    this.removedEntities.clear();
+    return { dirty, removed };
+  }
+
   /**
    * Remove entity and all its components
    */
   removeEntity(entity: Entity): void {
+    if (!this.entities.has(entity.id)) return;
     const entityComponents = this.components.get(entity.id);
     if (entityComponents) {
       // Remove all components (which will clean up Three.js objects)
@@ -164,19 +350,29 @@ export class EntityManager {
       this.components.delete(entity.id);
     }
     this.entities.delete(entity.id);
-    Debug.log('EntityManager', `Removed entity: ${entity.name} (${entity.id})`);
+    this.dirtyEntities.delete(entity.id);
+    this.removedEntities.add(entity.id);
+
+    if (this.currentBatch) {
+      this.currentBatch.removed.push(entity);
+    } else {
+      if (LOG_DEBUG) Debug.log('EntityManager', () => `Removed entity: ${entity.name} (${entity.id})`);
+      this.notifyChange([], [entity]);
+    }
+  }
+
+  /**
+   * Remove several entities at once (one scene pass, one notification)
+   */
+  removeEntities(entities: Entity[]): void {
+    this.batch(() => entities.forEach(entity => this.removeEntity(entity)));
   }
 
   /**
    * Clear all entities from the scene
    */
   clearAll(): void {
-    // Get all entities and remove them
-    const allEntities = Array.from(this.entities.values());
-    allEntities.forEach((entity) => {
-      this.removeEntity(entity);
-    });
-    Debug.log('EntityManager', `Cleared all entities (${allEntities.length} entities removed)`);
+    this.removeEntities(Array.from(this.entities.values()));
   }
 
   /**
@@ -233,6 +429,9 @@ export class EntityManager {
             physTransform.rotation.w
           );
           transform.rotation.setFromQuaternion(quat);
+          if (!physics.rigidBody.isSleeping()) {
+            this.dirtyEntities.add(entity.id); // Moved by the simulation
+          }
         } else if (isEditorControlled || physics.properties.bodyType === 'static' || physics.properties.bodyType === 'kinematic') {
           // Sync transform TO physics (transform drives the physics)
           const quat = new THREE.Quaternion().setFromEuler(transform.rotation);
@@ -254,6 +453,70 @@ export class EntityManager {
     });
   }
 
+  private registerEntity(entity: Entity): Entity {
+    this.entities.set(entity.id, entity);
+    this.components.set(entity.id, new Map());
+    this.dirtyEntities.add(entity.id);
+    if (this.currentBatch) {
+      this.currentBatch.added.push(entity);
+    } else {
+      if (LOG_DEBUG) Debug.log('EntityManager', () => `Created entity: ${entity.name} (${entity.id})`);
+      this.notifyChange([entity], []);
+    }
+    return entity;
+  }
+
+  private notifyChange(added: Entity[], removed: Entity[]): void {
+    if (this.changeListeners.size === 0) return;
+    const event: EntityChangeEvent = { added, removed };
+    this.changeListeners.forEach((listener) => {
+      try {
+        listener(event);
+      } catch (error) {
+        Debug.error('EntityManager', 'Entity change listener failed', error as Error);
+      }
+    });
+  }
+
+  private addToScene(object: THREE.Object3D): void {
+    if (this.currentBatch) {
+      this.currentBatch.sceneRemovals.delete(object);
+      this.currentBatch.sceneAdds.add(object);
+    } else {
+      this.scene.add(object);
+    }
+  }
+
+  private removeFromScene(object: THREE.Object3D): void {
+    if (this.currentBatch) {
+      // Not in the scene yet if it was added in this batch
+      if (!this.currentBatch.sceneAdds.delete(object)) this.currentBatch.sceneRemovals.add(object);
+    } else {
+      this.scene.remove(object);
+    }
+  }
+
+  /**
+   * Remove many objects from the scene in one pass over its children
+   * (scene.remove looks each object up with indexOf - quadratic for a whole level)
+   */
+  private detachFromScene(objects: Set<THREE.Object3D>): void {
+    if (objects.size === 0) return;
+    const children = this.scene.children;
+    let kept = 0;
+    for (let i = 0; i < children.length; i++) {
+      const child = children[i];
+      if (objects.has(child)) {
+        child.parent = null;
+        child.dispatchEvent({ type: 'removed' });
+        this.scene.dispatchEvent({ type: 'childremoved', child });
+      } else {
+        children[kept++] = child;
+      }
+    }
+    children.length = kept;
+  }
+
   /**
    * Get Three.js Object3D for entity (mesh or light)
    */
@@ -275,6 +538,7 @@ export class EntityManager {
    * Get entity from Three.js Object3D (via userData.entityId)
    */
   getEntityFromObject3D(object: THREE.Object3D): Entity | null {
+    queryCount.inc();
     const entityId = object.userData.entityId;
     if (!entityId) return null;
     return this.getEntity(entityId);
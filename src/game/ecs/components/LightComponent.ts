@@ -16,6 +16,8 @@ export interface LightProperties {
   penumbra?: number;
   // For directional lights
   castShadow?: boolean;
+  // Static lights are baked into static brushes by LightBaker (default: true)
+  isStatic?: boolean;
 }
 
 /**
@@ -71,7 +73,7 @@ export class LightComponent extends Component {
 
     this.light.name = `${this.entity.name}_light`;
     this.light.userData.entityId = this.entity.id;
-    this.light.visible = this.enabled;
+    this.light.visible = this.enabled && this.entity.active;
   }
 
   /**
@@ -79,7 +81,7 @@ export class LightComponent extends Component {
    */
   getLight(): THREE.Light | null {
     if (this.light) {
-      this.light.visible = this.enabled;
+      this.light.visible = this.enabled && this.entity.active; // Disabled entities stay hidden
     }
     return this.light;
   }
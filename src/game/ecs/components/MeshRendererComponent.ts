@@ -2,6 +2,7 @@ import * as THREE from 'three';
 import { Component } from '../Component';
 import { Entity } from '../Entity';
 import { RetroRenderer } from '../../renderer/RetroRenderer';
+import { TextureAtlas } from '../../assets/TextureAtlas';
 
 export type MeshType = 'box' | 'sphere' | 'plane' | 'cylinder' | 'cone' | 'custom';
 export type MeshGeometry = {
@@ -44,6 +45,8 @@ export class MeshRendererComponent extends Component {
   private renderer: RetroRenderer | null = null;
   private faceMaterialMap: FaceMaterialMap | null = null; // Per-face material assignments
   private materialLibrary: any = null; // MaterialLibrary instance for per-face materials
+  private bakedLighting: number[] | null = null; // Per-vertex RGB irradiance from LightBaker (linear, already divided by PI)
+  private litMaterial: THREE.Material | THREE.Material[] | null = null; // Original lit material while baked lighting is applied
 
   constructor(
     entity: Entity,
@@ -59,52 +62,48 @@ export class MeshRendererComponent extends Component {
   }
 
   /**
-   * Create Three.js mesh from geometry definition
+   * Build a Three.js geometry from a geometry definition
+   * Does not touch the renderer, so it can also be used headless (e.g. light baking)
    */
-  private createMesh(): void {
-    if (!this.renderer) {
-      console.warn('MeshRendererComponent: No renderer provided, mesh will not be created');
-      return;
-    }
-
+  static createGeometry(geometry: MeshGeometry): THREE.BufferGeometry {
     let threeGeometry: THREE.BufferGeometry;
 
-    switch (this.geometry.type) {
+    switch (geometry.type) {
       case 'box':
         threeGeometry = new THREE.BoxGeometry(
-          this.geometry.width || 1,
-          this.geometry.height || 1,
-          this.geometry.depth || 1
+          geometry.width || 1,
+          geometry.height || 1,
+          geometry.depth || 1
         );
         break;
       case 'sphere':
-        const segments = this.geometry.segments || 16;
+        const segments = geometry.segments || 16;
         threeGeometry = new THREE.SphereGeometry(
-          this.geometry.radius || 0.5,
+          geometry.radius || 0.5,
           segments,
           segments
         );
         break;
       case 'plane':
         threeGeometry = new THREE.PlaneGeometry(
-          this.geometry.planeWidth || 2,
-          this.geometry.planeHeight || 2
+          geometry.planeWidth || 2,
+          geometry.planeHeight || 2
         );
         break;
       case 'cylinder':
-        const cylSegments = this.geometry.segments || 16;
+        const cylSegments = geometry.segments || 16;
         threeGeometry = new THREE.CylinderGeometry(
-          this.geometry.cylinderRadius || 0.5,
-          this.geometry.cylinderRadius || 0.5,
-          this.geometry.cylinderHeight || 1,
+          geometry.cylinderRadius || 0.5,
+          geometry.cylinderRadius || 0.5,
+          geometry.cylinderHeight || 1,
           cylSegments
         );
         break;
       case 'cone':
-        const coneSegments = this.geometry.segments || 16;
+        const coneSegments = geometry.segments || 16;
         threeGeometry = new THREE.ConeGeometry(
-          this.geometry.radius || 0.5,
-          this.geometry.cylinderHeight || 1,
+          geometry.radius || 0.5,
+          geometry.cylinderHeight || 1,
           coneSegments
         );
         break;
@@ -117,16 +116,38 @@ export class MeshRendererComponent extends Component {
         threeGeometry = new THREE.BoxGeometry(1, 1, 1);
     }
 
+    return threeGeometry;
+  }
+
+  /**
+   * Create Three.js mesh from geometry definition
+   */
+  private createMesh(): void {
+    if (!this.renderer) {
+      console.warn('MeshRendererComponent: No renderer provided, mesh will not be created');
+      return;
+    }
+
+    // Baked copies belong to the previous mesh (recreated by deserialize)
+    if (this.litMaterial) {
+      this.disposeBakedMaterials();
+      this.litMaterial = null;
+    }
+
+    const threeGeometry = MeshRendererComponent.createGeometry(this.geometry);
     const material = this.renderer.createRetroStandardMaterial(this.materialColor);
     this.mesh = new THREE.Mesh(threeGeometry, material);
     this.mesh.name = `${this.entity.name}_mesh`;
-    this.mesh.visible = this.visible;
+    this.mesh.visible = this.visible && this.enabled && this.entity.active;
     this.mesh.userData.entityId = this.entity.id;
     
     // Apply per-face materials if specified
     if (this.faceMaterialMap && this.materialLibrary) {
       this.applyPerFaceMaterials();
     }
+
+    // Re-apply baked lighting (mesh may have been recreated by deserialize)
+    if (this.bakedLighting) this.applyBakedMaterial();
   }
 
   /**
@@ -138,7 +159,7 @@ export class MeshRendererComponent extends Component {
       this.createMesh();
     }
     if (this.mesh) {
-      this.mesh.visible = this.visible && this.enabled;
+      this.mesh.visible = this.visible && this.enabled && this.entity.active;
     }
     return this.mesh;
   }
@@ -148,7 +169,16 @@ export class MeshRendererComponent extends Component {
    */
   setColor(color: number): void {
     this.materialColor = color;
-    if (this.mesh && this.mesh.material instanceof THREE.MeshStandardMaterial) {
+    if (this.bakedLighting && this.litMaterial instanceof THREE.MeshStandardMaterial) {
+      // Baked: update the lit material and rebuild the unlit copy from it
+      if (!this.litMaterial.userData.shared) {
+        this.litMaterial.color.setHex(color);
+        this.applyBakedMaterial();
+      }
+      return;
+    }
+    // Shared materials (e.g. the texture atlas) must not be tinted per mesh
+    if (this.mesh && this.mesh.material instanceof THREE.MeshStandardMaterial && !this.mesh.material.userData.shared) {
       this.mesh.material.color.setHex(color);
     }
   }
@@ -159,6 +189,12 @@ export class MeshRendererComponent extends Component {
   updateMaterial(material: THREE.Material): void {
     if (!this.mesh) return;
 
+    // Drop the unlit copies of the previous lit material
+    if (this.bakedLighting && this.litMaterial) {
+      this.disposeBakedMaterials();
+      this.mesh.material = this.litMaterial;
+    }
+
     // Dispose old material if needed
     if (this.mesh.material) {
       if (Array.isArray(this.mesh.material)) {
@@ -176,6 +212,12 @@ export class MeshRendererComponent extends Component {
     if (material instanceof THREE.MeshStandardMaterial && material.color) {
       this.materialColor = material.color.getHex();
     }
+
+    // Keep baked meshes unlit - the new material becomes the lit source
+    if (this.bakedLighting) {
+      this.litMaterial = null;
+      this.applyBakedMaterial();
+    }
   }
 
   /**
@@ -226,6 +268,20 @@ export class MeshRendererComponent extends Component {
     const uniqueMaterialIds = new Set(Object.values(this.faceMaterialMap!));
     if (uniqueMaterialIds.size === 0) return; // No face materials specified
 
+    // Drop the unlit copies of the previous lit material - both paths below replace the material
+    if (this.litMaterial) {
+      this.disposeBakedMaterials();
+      this.mesh.material = this.litMaterial;
+      this.litMaterial = null;
+    }
+
+    // Preferred path: one shared atlas material with face UVs remapped into atlas tiles (single draw call)
+    if (this.applyAtlasFaceMaterials(geometry)) {
+      if (this.bakedLighting) this.applyBakedMaterial();
+      return;
+    }
+    this.restoreSourceUVs(geometry);
+
     // Get material instances from MaterialLibrary
     const materials: THREE.Material[] = [];
     const materialIdToIndex = new Map<string, number>();
@@ -238,7 +294,11 @@ export class MeshRendererComponent extends Component {
       }
     });
 
-    if (materials.length === 0) return; // No valid materials found
+    if (materials.length === 0) {
+      // No valid materials found - keep the current one (baked again)
+      if (this.bakedLighting) this.applyBakedMaterial();
+      return;
+    }
 
     // For boxes, we need to create groups and assign materials to groups
     if (this.geometry.type === 'box' && geometry instanceof THREE.BoxGeometry) {
@@ -296,6 +356,137 @@ export class MeshRendererComponent extends Component {
     if (materials.length > 0 && materials[0] instanceof THREE.MeshStandardMaterial) {
       this.materialColor = materials[0].color.getHex();
     }
+
+    if (this.bakedLighting) this.applyBakedMaterial();
+  }
+
+  /**
+   * Map each box face into its material's atlas tile and use the shared atlas material
+   * Returns false when the atlas is unavailable or doesn't cover every face material
+   */
+  private applyAtlasFaceMaterials(geometry: THREE.BufferGeometry): boolean {
+    if (this.geometry.type !== 'box' || !(geometry instanceof THREE.BoxGeometry)) return false;
+
+    const atlas: TextureAtlas | null = this.materialLibrary.getAtlas?.() || null;
+    const atlasMaterial: THREE.Material | null = this.materialLibrary.getAtlasMaterial?.() || null;
+    const uv = geometry.getAttribute('uv') as THREE.BufferAttribute | undefined;
+    if (!atlas || !atlasMaterial || !uv || !atlas.hasAll(Object.values(this.faceMaterialMap!))) return false;
+
+    // Keep the original 0..1 UVs so faces can be remapped again (or restored)
+    if (!geometry.userData.sourceUVs) {
+      geometry.userData.sourceUVs = Float32Array.from(uv.array as ArrayLike<number>);
+    }
+    const sourceUVs: Float32Array = geometry.userData.sourceUVs;
+
+    // Faces without a material use the first mapped one (same as the multi-material path)
+    const defaultMaterialId = Object.values(this.faceMaterialMap!)[0];
+    // createGeometry builds single-segment boxes: 4 vertices per face, in [right, left, top, bottom, front, back] order
+    for (let faceIndex = 0; faceIndex < 6; faceIndex++) {
+      const region = atlas.getRegion(this.faceMaterialMap![faceIndex] || defaultMaterialId)!;
+      TextureAtlas.remapUVs(uv, sourceUVs, faceIndex * 4, 4, region);
+    }
+
+    // No groups: the whole box is drawn with the shared material
+    geometry.clearGroups();
+    this.mesh!.material = atlasMaterial;
+    return true;
+  }
+
+  /**
+   * Undo atlas UV remapping (when falling back to one material per face)
+   */
+  private restoreSourceUVs(geometry: THREE.BufferGeometry): void {
+    const sourceUVs: Float32Array | undefined = geometry.userData.sourceUVs;
+    const uv = geometry.getAttribute('uv') as THREE.BufferAttribute | undefined;
+    if (!sourceUVs || !uv) return;
+
+    (uv.array as Float32Array).set(sourceUVs);
+    uv.needsUpdate = true;
+    delete geometry.userData.sourceUVs;
+  }
+
+  /**
+   * Apply baked per-vertex lighting (from LightBaker)
+   * The mesh switches to an unlit MeshBasicMaterial that multiplies its color/map by the vertex colors
+   * @param colors RGB triplets, one per vertex of the mesh geometry (null clears the bake)
+   */
+  applyBakedLighting(colors: ArrayLike<number> | null): void {
+    this.bakedLighting = colors ? Array.from(colors) : null;
+    this.applyBakedMaterial();
+  }
+
+  /**
+   * Check if this mesh currently uses baked lighting
+   */
+  hasBakedLighting(): boolean {
+    return this.bakedLighting !== null;
+  }
+
+  /**
+   * Swap between the lit material and its unlit baked counterpart
+   */
+  private applyBakedMaterial(): void {
+    if (!this.mesh) return;
+    const geometry = this.mesh.geometry;
+
+    if (!this.bakedLighting) {
+      // Restore the original lit material
+      if (this.litMaterial) {
+        this.disposeBakedMaterials();
+        this.mesh.material = this.litMaterial;
+        this.litMaterial = null;
+      }
+      geometry.deleteAttribute('color');
+      return;
+    }
+
+    const position = geometry.getAttribute('position');
+    if (!position || position.count * 3 !== this.bakedLighting.length) {
+      // Geometry changed since the bake - lighting no longer matches the vertices
+      console.warn(`MeshRendererComponent: Baked lighting does not match geometry of ${this.entity.name}, rebake required`);
+      this.bakedLighting = null;
+      this.applyBakedMaterial();
+      return;
+    }
+
+    geometry.setAttribute('color', new THREE.Float32BufferAttribute(this.bakedLighting, 3));
+
+    if (this.litMaterial) {
+      this.disposeBakedMaterials();
+    } else {
+      this.litMaterial = this.mesh.material;
+    }
+
+    const toUnlit = (material: THREE.Material): THREE.MeshBasicMaterial => {
+      const unlit = new THREE.MeshBasicMaterial({ vertexColors: true });
+      unlit.name = material.name ? `${material.name}_baked` : 'baked';
+      if (material instanceof THREE.MeshStandardMaterial) {
+        // Metals have no diffuse term in the lit shader, match that here
+        unlit.color.copy(material.color).multiplyScalar(1 - material.metalness);
+        unlit.map = material.map;
+        unlit.wireframe = material.wireframe;
+      }
+      unlit.transparent = material.transparent;
+      unlit.opacity = material.opacity;
+      unlit.side = material.side;
+      return unlit;
+    };
+
+    this.mesh.material = Array.isArray(this.litMaterial)
+      ? this.litMaterial.map(toUnlit)
+      : toUnlit(this.litMaterial);
+  }
+
+  /**
+   * Dispose the unlit materials created for baked lighting
+   */
+  private disposeBakedMaterials(): void {
+    if (!this.mesh || !this.litMaterial || this.mesh.material === this.litMaterial) return;
+    if (Array.isArray(this.mesh.material)) {
+      this.mesh.material.forEach(m => m.dispose());
+    } else {
+      this.mesh.material.dispose();
+    }
   }
 
   /**
@@ -304,7 +495,7 @@ export class MeshRendererComponent extends Component {
   setVisible(visible: boolean): void {
     this.visible = visible;
     if (this.mesh) {
-      this.mesh.visible = visible && this.enabled;
+      this.mesh.visible = visible && this.enabled && this.entity.active;
     }
   }
 
@@ -320,10 +511,15 @@ export class MeshRendererComponent extends Component {
 
   onRemove(): void {
     if (this.mesh) {
+      if (this.litMaterial) {
+        this.disposeBakedMaterials();
+        this.mesh.material = this.litMaterial;
+        this.litMaterial = null;
+      }
       this.mesh.geometry.dispose();
       if (Array.isArray(this.mesh.material)) {
         this.mesh.material.forEach(m => m.dispose());
-      } else {
+      } else if (!this.mesh.material.userData.shared) {
         this.mesh.material.dispose();
       }
       this.mesh = null;
@@ -338,6 +534,8 @@ export class MeshRendererComponent extends Component {
       visible: this.visible,
       enabled: this.enabled,
       faceMaterialMap: this.faceMaterialMap || undefined,
+      // Rounded to keep saved scenes compact - well below 8-bit output precision
+      bakedLighting: this.bakedLighting ? this.bakedLighting.map(v => Math.round(v * 1000) / 1000) : undefined,
     };
   }
 
@@ -353,6 +551,9 @@ export class MeshRendererComponent extends Component {
         this.createMesh();
       }
     }
+    if (data.bakedLighting) {
+      this.applyBakedLighting(data.bakedLighting);
+    }
   }
 
   clone(entity: Entity): MeshRendererComponent {
@@ -365,6 +566,9 @@ export class MeshRendererComponent extends Component {
     if (cloned.faceMaterialMap && cloned.materialLibrary) {
       cloned.applyPerFaceMaterials();
     }
+    if (this.bakedLighting) {
+      cloned.applyBakedLighting(this.bakedLighting);
+    }
     return cloned;
   }
 }
@@ -0,0 +1,65 @@
+import { Component } from '../Component';
+import { Entity } from '../Entity';
+import type { LoadedScript, ScriptContext } from '@/game/scripts/types';
+
+export interface ScriptProperties {
+  scriptPath: string; // Path to script file (e.g., "scripts/entities/spinner")
+  data?: Record<string, any>; // Passed to the script as context.data
+  budgetMs?: number; // onUpdate time budget (ScriptSystem default when unset)
+}
+
+/**
+ * Script Component - attaches a script to an entity
+ * ScriptSystem loads the script and calls its onUpdate every frame with the real frame delta
+ * (worker scripts are sent to the script worker instead).
+ */
+export class ScriptComponent extends Component {
+  public properties: ScriptProperties;
+
+  // Runtime state owned by ScriptSystem (not serialized)
+  public script: LoadedScript | null = null;
+  public context: ScriptContext | null = null;
+  public lastUpdateTime: number | null = null; // ScriptSystem clock at the last onUpdate
+  public lastRunFrame: number = -1;
+  public deferredFrame: number = -1;
+  public overBudget: boolean = false; // Last onUpdate exceeded its budget - scheduled after the others
+  public failed: boolean = false; // onUpdate threw - not called again until the script is reassigned
+
+  constructor(entity: Entity, properties: ScriptProperties) {
+    super(entity);
+    this.properties = { ...properties };
+  }
+
+  /**
+   * Point the component at another script (reloaded by ScriptSystem on the next frame)
+   */
+  setScriptPath(scriptPath: string): void {
+    this.properties.scriptPath = scriptPath;
+    this.script = null;
+    this.context = null;
+    this.lastUpdateTime = null;
+    this.failed = false;
+  }
+
+  serialize(): any {
+    return {
+      type: 'ScriptComponent',
+      properties: { ...this.properties },
+      enabled: this.enabled,
+    };
+  }
+
+  deserialize(data: any): void {
+    if (data.properties) {
+      this.setScriptPath(data.properties.scriptPath);
+      this.properties = { ...data.properties };
+    }
+    if (data.enabled !== undefined) this.enabled = data.enabled;
+  }
+
+  clone(entity: Entity): ScriptComponent {
+    const cloned = new ScriptComponent(entity, { ...this.properties, data: this.properties.data && { ...this.properties.data } });
+    cloned.enabled = this.enabled;
+    return cloned;
+  }
+}
@@ -3,8 +3,13 @@ import { Entity } from '../Entity';
 import * as THREE from 'three';
 import { PhysicsWorld } from '../../physics/PhysicsWorld';
 import RAPIER from '@dimforge/rapier3d';
-import { IScript, ScriptContext } from '@/game/scripts/types';
+import { isWorkerScript, type GameApi, type LoadedScript, type ScriptContext } from '@/game/scripts/types';
 import { ScriptLoader } from '@/game/scripts/ScriptLoader';
+import type { ScriptWorkerHost } from '@/game/scripts/ScriptWorkerHost';
+import { Tracer } from '@/game/utils/Tracer';
+import { Metrics } from '@/game/utils/Metrics';
+
+const scriptInvocations = Metrics.counter('scripts.invocations', 'Trigger script callbacks run');
 
 export type TriggerEventType = 'onEnter' | 'onExit' | 'onStay' | 'onInteract';
 export type TriggerAction = 'script' | 'loadLevel' | 'spawnEntity' | 'enableEntity' | 'disableEntity';
@@ -19,8 +24,10 @@ export interface TriggerProperties {
   actionData?: {
     scriptPath?: string; // Path to script file (e.g., "scripts/triggers/door")
     scriptName?: string; // Legacy - deprecated, use scriptPath instead
-    levelId?: string;
-    entityId?: string;
+    levelId?: string; // loadLevel: scene ID or asset URL
+    prefabId?: string; // spawnEntity (falls back to entityId)
+    position?: { x: number; y: number; z: number }; // spawnEntity: spawn point (prefab position when unset)
+    entityId?: string; // enableEntity / disableEntity target
     [key: string]: any;
   };
   oneShot?: boolean; // Trigger only once
@@ -36,10 +43,12 @@ export class TriggerComponent extends Component {
   public collider: RAPIER.Collider | null = null;
   private physicsWorld: PhysicsWorld | null = null;
   private scriptLoader: ScriptLoader | null = null;
-  private loadedScript: IScript | null = null;
+  private loadedScript: LoadedScript | null = null;
+  private scriptWorker: ScriptWorkerHost | null = null; // Runs worker scripts
+  private game: GameApi | null = null; // Level, spawn and enable actions
   private triggered: boolean = false;
   private entitiesInside: Set<number> = new Set(); // Track entities inside trigger
-  private scriptLoadPromise: Promise<IScript | null> | null = null;
+  private lastDeltaTime: number = 1 / 60; // Latest frame delta, passed to trigger scripts
 
   constructor(entity: Entity, properties: TriggerProperties, physicsWorld?: PhysicsWorld, scriptLoader?: ScriptLoader) {
     super(entity);
@@ -153,15 +162,8 @@ export class TriggerComponent extends Component {
       return;
     }
 
-    // If already loading, wait for that promise
-    if (this.scriptLoadPromise) {
-      await this.scriptLoadPromise;
-      return;
-    }
-
-    this.scriptLoadPromise = this.scriptLoader.loadScript(scriptPath);
-    this.loadedScript = await this.scriptLoadPromise;
-    this.scriptLoadPromise = null;
+    // ScriptLoader shares a load already in flight (e.g. the scene preload)
+    this.loadedScript = await this.scriptLoader.loadScript(scriptPath);
 
     if (!this.loadedScript) {
       console.warn(`[TriggerComponent] Failed to load script: ${scriptPath}`);
@@ -182,10 +184,27 @@ export class TriggerComponent extends Component {
       return;
     }
 
+    if (isWorkerScript(this.loadedScript)) {
+      if (!this.loadedScript[callbackName]) return;
+      if (!this.scriptWorker) {
+        console.warn(`[TriggerComponent] No script worker set, cannot execute worker script ${callbackName}`);
+        return;
+      }
+      scriptInvocations.inc();
+      this.scriptWorker.dispatch(this.getScriptPath()!, this.loadedScript, callbackName, this.entity, {
+        time: context.time,
+        deltaTime: context.deltaTime,
+        data: context.data,
+        otherEntity: context.otherEntity,
+      });
+      return;
+    }
+
     const callback = this.loadedScript[callbackName];
     if (callback) {
       try {
-        callback(context);
+        scriptInvocations.inc();
+        Tracer.scope(`script ${this.getScriptPath()}:${callbackName}`, 'script', () => callback(context));
       } catch (error) {
         console.error(`[TriggerComponent] Error executing script ${callbackName}:`, error);
       }
@@ -216,8 +235,9 @@ export class TriggerComponent extends Component {
           entity: this.entity,
           triggerComponent: this,
           time: performance.now() / 1000, // Convert to seconds
-          deltaTime: 0.016, // Approximate 60 FPS
+          deltaTime: this.lastDeltaTime,
           data: this.properties.actionData,
+          game: this.game || undefined,
           ...scriptContext,
         };
 
@@ -235,25 +255,37 @@ export class TriggerComponent extends Component {
         }
         break;
       }
-      case 'loadLevel':
-        // Level loading would go here
-        console.log(`Trigger ${this.entity.id}: Load level ${this.properties.actionData?.levelId}`);
+      case 'loadLevel': {
+        const levelId = this.properties.actionData?.levelId;
+        if (!levelId || !this.requireGame()) break;
+        await this.game!.loadLevel(levelId);
         break;
-      case 'spawnEntity':
-        // Entity spawning would go here
-        console.log(`Trigger ${this.entity.id}: Spawn entity ${this.properties.actionData?.entityId}`);
+      }
+      case 'spawnEntity': {
+        const prefabId = this.properties.actionData?.prefabId || this.properties.actionData?.entityId;
+        if (!prefabId || !this.requireGame()) break;
+        if (!this.game!.spawnEntity(prefabId, this.properties.actionData?.position)) {
+          console.warn(`[TriggerComponent] Trigger ${this.entity.id} could not spawn prefab ${prefabId}`);
+        }
         break;
+      }
       case 'enableEntity':
-        // Enable entity would go here
-        console.log(`Trigger ${this.entity.id}: Enable entity ${this.properties.actionData?.entityId}`);
-        break;
-      case 'disableEntity':
-        // Disable entity would go here
-        console.log(`Trigger ${this.entity.id}: Disable entity ${this.properties.actionData?.entityId}`);
+      case 'disableEntity': {
+        const targetId = this.properties.actionData?.entityId;
+        if (!targetId || !this.requireGame()) break;
+        this.game!.setEntityEnabled(targetId, this.properties.action === 'enableEntity');
         break;
+      }
     }
   }
 
+  private requireGame(): boolean {
+    if (!this.game) {
+      console.warn(`[TriggerComponent] No game API set, cannot run ${this.properties.action} on trigger ${this.entity.id}`);
+    }
+    return !!this.game;
+  }
+
   /**
    * Set script loader (for initialization after creation)
    */
@@ -264,10 +296,29 @@ export class TriggerComponent extends Component {
     }
   }
 
+  /**
+   * Set the script worker (for worker scripts)
+   */
+  setScriptWorker(scriptWorker: ScriptWorkerHost): void {
+    this.scriptWorker = scriptWorker;
+  }
+
+  /**
+   * Set the game API (level, spawn and enable actions); a level transition starts reading its level
+   */
+  setGameApi(game: GameApi): void {
+    this.game = game;
+    const levelId = this.properties.actionData?.levelId;
+    if (this.properties.action === 'loadLevel' && levelId && this.properties.enabled) {
+      game.preloadLevel(levelId);
+    }
+  }
+
   /**
    * Update trigger state
    */
   update(deltaTime: number): void {
+    this.lastDeltaTime = deltaTime;
     if (!this.properties.enabled || !this.collider) return;
 
     // Check for collision events
@@ -275,6 +326,20 @@ export class TriggerComponent extends Component {
     // For now, we'll just update the component state
   }
 
+  /**
+   * Check if the trigger has fired (one-shot triggers stay fired)
+   */
+  isTriggered(): boolean {
+    return this.triggered;
+  }
+
+  /**
+   * Set the fired state (restoring a save game)
+   */
+  setTriggered(triggered: boolean): void {
+    this.triggered = triggered;
+  }
+
   /**
    * Reset trigger state
    */
@@ -1,7 +1,8 @@
 // ECS Core
 export { Entity } from './Entity';
 export { Component } from './Component';
-export { EntityManager } from './EntityManager';
+export { EntityManager, type EntityChangeEvent, type EntityChangeListener } from './EntityManager';
+export { ComponentRegistry, type ComponentTypeDefinition, type ComponentFactoryContext, type ComponentBinaryCodec } from './ComponentRegistry';
 
 // Components
 export { TransformComponent } from './components/TransformComponent';
@@ -0,0 +1,53 @@
+/**
+ * Override diffs between prefab component data and instance data (JSON Merge Patch, RFC 7396)
+ * Objects are diffed per key; arrays and primitives are replaced whole; null deletes a key.
+ */
+
+function isPlainObject(value: any): value is Record<string, any> {
+  return value !== null && typeof value === 'object' && !Array.isArray(value);
+}
+
+/**
+ * Patch turning base into target (undefined when they are equal)
+ */
+export function createMergePatch(base: any, target: any): any {
+  if (!isPlainObject(base) || !isPlainObject(target)) {
+    return JSON.stringify(base) === JSON.stringify(target) ? undefined : target;
+  }
+
+  const patch: Record<string, any> = {};
+  let changed = false;
+  Object.keys(base).forEach((key) => {
+    if (target[key] === undefined && base[key] !== undefined) {
+      patch[key] = null;
+      changed = true;
+    }
+  });
+  Object.keys(target).forEach((key) => {
+    if (target[key] === undefined) return;
+    const value = createMergePatch(base[key], target[key]);
+    if (value !== undefined) {
+      patch[key] = value;
+      changed = true;
+    }
+  });
+  return changed ? patch : undefined;
+}
+
+/**
+ * Apply a merge patch (returns a new value; base is not modified)
+ */
+export function applyMergePatch(base: any, patch: any): any {
+  if (patch === undefined) return base;
+  if (!isPlainObject(patch)) return patch;
+
+  const result: Record<string, any> = isPlainObject(base) ? { ...base } : {};
+  Object.keys(patch).forEach((key) => {
+    if (patch[key] === null) {
+      delete result[key];
+    } else {
+      result[key] = applyMergePatch(result[key], patch[key]);
+    }
+  });
+  return result;
+}
@@ -1,11 +1,15 @@
 import { Entity } from '../Entity';
-import { Component } from '../Component';
 import { EntityManager } from '../EntityManager';
-import { TransformComponent } from '../components/TransformComponent';
-import { MeshRendererComponent } from '../components/MeshRendererComponent';
-import { PhysicsComponent } from '../components/PhysicsComponent';
-import { LightComponent } from '../components/LightComponent';
-import { SceneSerializer, SerializedEntity } from '../serialization/SceneSerializer';
+import { ComponentRegistry, type ComponentFactoryContext } from '../ComponentRegistry';
+import { SceneSerializer, type SerializedEntity, type SerializedComponent, type PrefabSource } from '../serialization/SceneSerializer';
+import { SharedBlobTable, cloneData, hashContent } from '../serialization/ContentHash';
+import { PrefabStorage, type PrefabBlobChanges } from './PrefabStorage';
+import { createMergePatch, applyMergePatch } from './PrefabDiff';
+import { Debug } from '../../utils/debug';
+
+const MAX_PREFAB_DEPTH = 16; // Nesting limit (also stops reference cycles)
+
+type ResolvedComponents = Array<{ component: SerializedComponent; hash: string }>;
 
 export interface Prefab {
   id: string;
@@ -13,76 +17,63 @@ export interface Prefab {
   entity: SerializedEntity;
   createdAt: number;
   updatedAt: number;
+  deletedAt?: number; // Tombstone - hidden from the library, still resolves saved instances and variants
 }
 
 /**
  * PrefabManager - Manages prefab templates (reusable entity templates)
+ * Prefabs are kept in memory; each change writes only the affected prefab record to IndexedDB.
+ * Component payloads are content-addressed in a shared blob table, and instances (entities with
+ * metadata.prefabId) stay linked: they are saved as overrides of their prefab (see PrefabSource),
+ * and prefab edits are pushed to them in one batched pass. A prefab made from an instance is
+ * nested - it stores its overrides of the base prefab and follows its edits too. Since saved scenes
+ * and variants only hold overrides, deleting a prefab leaves a tombstone rather than dropping its components.
  */
-export class PrefabManager {
+export class PrefabManager implements PrefabSource {
   private prefabs: Map<string, Prefab> = new Map();
-  private storageKey = 'drd_prefabs';
+  private blobs: SharedBlobTable = new SharedBlobTable();
+  private componentHashes: Map<string, Array<string | null>> = new Map(); // Own component payload hashes (blob references, null = not shared)
+  private resolved: Map<string, ResolvedComponents> = new Map(); // Full component lists, nesting applied
+  private pendingPropagation: Map<string, ResolvedComponents> = new Map(); // Prefab -> components before the edit
+  private propagationTarget: EntityManager | null = null;
+  private propagationScheduled = false;
+  private factoryContext: ComponentFactoryContext = {};
+  private storage: PrefabStorage = new PrefabStorage();
+  private loaded = false; // Stored prefabs are in the blob table, so its reference counts cover storage
+  private ready: Promise<void>;
 
   constructor() {
-    this.loadPrefabsFromStorage();
+    this.ready = this.loadPrefabsFromStorage();
   }
 
   /**
-   * Create a prefab from an entity
+   * Resolves once the stored prefabs are loaded
    */
-  createPrefab(name: string, entity: Entity, entityManager: EntityManager): Prefab {
-    // Serialize the entity
-    const serializedEntity: SerializedEntity = {
-      id: '', // Prefabs don't keep original IDs
-      name: entity.name,
-      active: entity.active,
-      tags: Array.from(entity.tags),
-      metadata: { ...entity.metadata },
-      components: [],
-    };
-
-    // Serialize all components
-    const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-    if (transform) {
-      serializedEntity.components.push({
-        type: 'TransformComponent',
-        data: transform.serialize(),
-      });
-    }
-
-    const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent');
-    if (meshRenderer) {
-      serializedEntity.components.push({
-        type: 'MeshRendererComponent',
-        data: meshRenderer.serialize(),
-      });
-    }
-
-    const physics = entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent');
-    if (physics) {
-      serializedEntity.components.push({
-        type: 'PhysicsComponent',
-        data: physics.serialize(),
-      });
-    }
+  whenReady(): Promise<void> {
+    return this.ready;
+  }
 
-    const light = entityManager.getComponent<LightComponent>(entity, 'LightComponent');
-    if (light) {
-      serializedEntity.components.push({
-        type: 'LightComponent',
-        data: light.serialize(),
-      });
-    }
+  /**
+   * Services components created by the manager get (instantiation without a renderer, propagation)
+   */
+  setFactoryContext(context: ComponentFactoryContext): void {
+    this.factoryContext = context;
+  }
 
+  /**
+   * Create a prefab from an entity
+   * An instance of another prefab gives a nested prefab (stored as overrides of that prefab)
+   */
+  createPrefab(name: string, entity: Entity, entityManager: EntityManager): Prefab {
     const prefab: Prefab = {
       id: `prefab_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`,
       name,
-      entity: serializedEntity,
+      entity: this.templateFromEntity(entity, entityManager),
       createdAt: Date.now(),
       updatedAt: Date.now(),
     };
 
-    this.prefabs.set(prefab.id, prefab);
-    this.savePrefabsToStorage();
+    this.savePrefabToStorage(this.addPrefab(prefab), prefab);
 
     return prefab;
   }
@@ -97,135 +88,341 @@ export class PrefabManager {
     physicsWorld: any,
     position?: { x: number; y: number; z: number }
   ): Entity | null {
-    const prefab = this.prefabs.get(prefabId);
-    if (!prefab) {
+    const prefab = this.getPrefab(prefabId);
+    const components = this.getPrefabComponents(prefabId);
+    if (!prefab || !components) {
       console.error(`PrefabManager: Prefab ${prefabId} not found`);
       return null;
     }
 
-    // Create entity from prefab
-    const entity = entityManager.createEntity(prefab.entity.name);
-
-    // Copy tags and metadata
-    prefab.entity.tags.forEach(tag => entity.addTag(tag));
-    entity.metadata = { ...prefab.entity.metadata };
-
-    // Create components
-    prefab.entity.components.forEach((serializedComponent) => {
-      switch (serializedComponent.type) {
-        case 'TransformComponent':
-          const transform = new TransformComponent(entity);
-          transform.deserialize(serializedComponent.data);
-          // Override position if provided
-          if (position) {
-            transform.setPosition(position);
-          }
-          entityManager.addComponent(entity, transform);
-          break;
-
-        case 'MeshRendererComponent':
-          const meshRenderer = new MeshRendererComponent(
-            entity,
-            serializedComponent.data.geometry,
-            serializedComponent.data.materialColor,
-            renderer
-          );
-          meshRenderer.deserialize(serializedComponent.data);
-          entityManager.addComponent(entity, meshRenderer);
-          break;
-
-        case 'PhysicsComponent':
-          const physics = new PhysicsComponent(entity, serializedComponent.data.properties, physicsWorld);
-          physics.deserialize(serializedComponent.data);
-          entityManager.addComponent(entity, physics);
-          // Update transform to match physics
-          if (position) {
-            const transformComp = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-            if (transformComp) {
-              transformComp.setPosition(position);
-              physics.updateTransform(position);
-            }
-          }
-          break;
-
-        case 'LightComponent':
-          const light = new LightComponent(entity, serializedComponent.data.properties);
-          light.deserialize(serializedComponent.data);
-          entityManager.addComponent(entity, light);
-          break;
+    const serializedEntity = this.instanceData(prefab, components, position);
+    return SceneSerializer.deserializeEntity(entityManager, serializedEntity, this.contextFor(renderer, physicsWorld));
+  }
+
+  /**
+   * Instantiate a prefab once per position as one EntityManager batch (procedural placement)
+   * The prefab is resolved once; entities are created together and the scene is updated in one pass.
+   */
+  instantiatePrefabs(
+    prefabId: string,
+    entityManager: EntityManager,
+    positions: Array<{ x: number; y: number; z: number }>,
+    renderer: any = null,
+    physicsWorld: any = null
+  ): Entity[] {
+    const prefab = this.getPrefab(prefabId);
+    const components = this.getPrefabComponents(prefabId);
+    if (!prefab || !components) {
+      console.error(`PrefabManager: Prefab ${prefabId} not found`);
+      return [];
+    }
+
+    const serializedEntities = positions.map(position => this.instanceData(prefab, components, position));
+    return SceneSerializer.deserializeEntities(entityManager, serializedEntities, this.contextFor(renderer, physicsWorld));
+  }
+
+  /**
+   * Remove every instance of a prefab from the scene (one pass, one batch)
+   * @returns Number of instances removed
+   */
+  removeInstances(prefabId: string, entityManager: EntityManager): number {
+    const instances = entityManager.getAllEntities().filter(entity => entity.metadata.prefabId === prefabId);
+    entityManager.removeEntities(instances);
+    return instances.length;
+  }
+
+  /**
+   * Replace a prefab's template with the current state of an entity (usually an edited instance)
+   * Linked instances and nested prefabs pick up the change in one batched pass after the current task
+   * (or immediately with flushPropagation)
+   */
+  updatePrefab(prefabId: string, entity: Entity, entityManager: EntityManager): boolean {
+    const prefab = this.getPrefab(prefabId);
+    if (!prefab) {
+      console.error(`PrefabManager: Prefab ${prefabId} not found`);
+      return false;
+    }
+
+    // A nested prefab stays nested on the same base
+    const template = this.templateFromEntity(entity, entityManager, prefab.entity.prefab?.id);
+
+    // Remember what instances were built from (first edit since the last pass wins)
+    this.affectedPrefabs(prefabId).forEach((id) => {
+      if (!this.pendingPropagation.has(id)) {
+        const before = this.getPrefabComponents(id);
+        if (before) this.pendingPropagation.set(id, before);
       }
     });
 
-    // Update transforms after all components are added
-    const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-    if (transform) {
-      const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent');
-      if (meshRenderer) {
-        meshRenderer.updateTransform({
-          position: transform.position,
-          rotation: transform.rotation,
-          scale: transform.scale,
-        });
-      }
+    const updated: Prefab = { ...prefab, entity: template, updatedAt: Date.now() };
+    this.savePrefabToStorage(this.addPrefab(updated), updated);
 
-      const light = entityManager.getComponent<LightComponent>(entity, 'LightComponent');
-      if (light) {
-        light.updateTransform(transform.position, transform.rotation);
-      }
+    this.propagationTarget = entityManager;
+    if (!this.propagationScheduled) {
+      this.propagationScheduled = true;
+      queueMicrotask(() => {
+        if (this.propagationScheduled) this.flushPropagation();
+      });
     }
+    return true;
+  }
 
-    return entity;
+  /**
+   * Push pending prefab edits to their instances (one pass over the entities)
+   * Instance overrides are kept: each instance's diff against the old prefab is re-applied to the new one
+   * @returns Number of instances updated
+   */
+  flushPropagation(entityManager: EntityManager | null = this.propagationTarget): number {
+    this.propagationScheduled = false;
+    if (!entityManager || this.pendingPropagation.size === 0) return 0;
+
+    const pending = this.pendingPropagation;
+    this.pendingPropagation = new Map();
+    const startTime = performance.now();
+    let updated = 0;
+
+    entityManager.batch(() => {
+      entityManager.getAllEntities().forEach((entity) => {
+        const prefabId = entity.metadata.prefabId;
+        const before = prefabId ? pending.get(prefabId) : undefined;
+        const after = before ? this.getPrefabComponents(prefabId) : null;
+        if (before && after && this.updateInstance(entity, entityManager, before, after)) {
+          updated++;
+        }
+      });
+    });
+
+    Debug.log('PrefabManager', `Propagated ${pending.size} prefab edits to ${updated} instances in ${(performance.now() - startTime).toFixed(1)}ms`);
+    return updated;
   }
 
   /**
-   * Get all prefabs
+   * Get all prefabs (deleted ones excluded)
    */
   getAllPrefabs(): Prefab[] {
-    return Array.from(this.prefabs.values());
+    return Array.from(this.prefabs.values()).filter(prefab => !prefab.deletedAt);
+  }
+
+  /**
+   * Prefab components (nesting applied) with their content hashes (PrefabSource, used to diff instances)
+   */
+  getPrefabComponents(prefabId: string): ResolvedComponents | null {
+    return this.resolvePrefab(prefabId, 0);
   }
 
   /**
-   * Get prefab by ID
+   * Get prefab by ID (null once deleted)
    */
   getPrefab(id: string): Prefab | null {
-    return this.prefabs.get(id) || null;
+    const prefab = this.prefabs.get(id);
+    return prefab && !prefab.deletedAt ? prefab : null;
   }
 
   /**
    * Delete a prefab
    */
   deletePrefab(id: string): boolean {
-    const deleted = this.prefabs.delete(id);
-    if (deleted) {
-      this.savePrefabsToStorage();
-    }
+    return this.deletePrefabs([id]) === 1;
+  }
+
+  /**
+   * Delete several prefabs
+   * Each becomes a tombstone: gone from the library and no longer instantiable, but its components
+   * stay (in memory and in storage) so stored scenes and nested prefabs built on it still load in full.
+   * @returns Number of prefabs deleted
+   */
+  deletePrefabs(ids: string[]): number {
+    let deleted = 0;
+    ids.forEach((id) => {
+      const prefab = this.getPrefab(id);
+      if (!prefab) return;
+      const tombstone: Prefab = { ...prefab, deletedAt: Date.now() };
+      this.prefabs.set(id, tombstone); // Same components - the resolved lists stay valid
+      this.savePrefabToStorage({ added: [], orphaned: [] }, tombstone);
+      deleted++;
+    });
     return deleted;
   }
 
   /**
-   * Save prefabs to localStorage
+   * Serialized instance of a prefab - linked (saved as overrides of the prefab), with copies of its payloads
    */
-  private savePrefabsToStorage(): void {
-    try {
-      const prefabsArray = Array.from(this.prefabs.values());
-      localStorage.setItem(this.storageKey, JSON.stringify(prefabsArray));
-    } catch (error) {
-      console.error('PrefabManager: Failed to save prefabs to storage', error);
+  private instanceData(prefab: Prefab, components: ResolvedComponents, position?: { x: number; y: number; z: number }): SerializedEntity {
+    return {
+      id: '',
+      name: prefab.entity.name,
+      active: prefab.entity.active,
+      tags: prefab.entity.tags,
+      metadata: { ...prefab.entity.metadata, prefabId: prefab.id },
+      // Copies - the template payloads are shared through the blob table. The position is set
+      // before components are created, so physics bodies and meshes start at the right place
+      components: components.map(({ component }) => {
+        const data = cloneData(component.data);
+        if (position && component.type === 'TransformComponent') data.position = { ...position };
+        return { type: component.type, data };
+      }),
+    };
+  }
+
+  private contextFor(renderer: any, physicsWorld: any): ComponentFactoryContext {
+    return {
+      ...this.factoryContext,
+      ...(renderer ? { renderer } : {}),
+      ...(physicsWorld ? { physicsWorld } : {}),
+    };
+  }
+
+  /**
+   * Serialized template of an entity - a nested prefab (overrides of the base) when a base is given
+   * @param baseId Base prefab (defaults to the prefab the entity is an instance of)
+   */
+  private templateFromEntity(
+    entity: Entity,
+    entityManager: EntityManager,
+    baseId: string | undefined = entity.metadata.prefabId
+  ): SerializedEntity {
+    // Prefabs don't keep original IDs; the base prefab link moves from metadata to the template
+    const { prefabId: _instanceOf, ...metadata } = entity.metadata;
+    const nested = !!baseId && this.prefabs.has(baseId);
+    return {
+      ...SceneSerializer.serializeEntity(entityManager, entity, { inlinePrefabs: !nested, prefabId: baseId }),
+      id: '',
+      metadata,
+    };
+  }
+
+  private resolvePrefab(prefabId: string, depth: number): ResolvedComponents | null {
+    const cached = this.resolved.get(prefabId);
+    if (cached) return cached;
+
+    const prefab = this.prefabs.get(prefabId);
+    if (!prefab) return null;
+
+    let components = prefab.entity.components;
+    const base = prefab.entity.prefab;
+    if (base) {
+      const baseComponents = depth < MAX_PREFAB_DEPTH ? this.resolvePrefab(base.id, depth + 1) : null;
+      if (!baseComponents) {
+        Debug.warn('PrefabManager', `Base prefab ${base.id} of ${prefab.name} is missing - using its own components`);
+      } else {
+        components = mergeOverrides(baseComponents, prefab.entity);
+      }
     }
+
+    const result = components.map(component => ({ component, hash: hashContent(component.data) }));
+    this.resolved.set(prefabId, result);
+    return result;
   }
 
   /**
-   * Load prefabs from localStorage
+   * The prefab and every prefab nested on it (directly or not)
    */
-  private loadPrefabsFromStorage(): void {
-    try {
-      const stored = localStorage.getItem(this.storageKey);
-      if (stored) {
-        const prefabsArray: Prefab[] = JSON.parse(stored);
-        prefabsArray.forEach(prefab => {
-          this.prefabs.set(prefab.id, prefab);
-        });
+  private affectedPrefabs(prefabId: string): string[] {
+    const affected = [prefabId];
+    for (let i = 0; i < affected.length; i++) {
+      this.prefabs.forEach((prefab) => {
+        if (prefab.entity.prefab?.id === affected[i] && !affected.includes(prefab.id)) {
+          affected.push(prefab.id);
+        }
+      });
+    }
+    return affected;
+  }
+
+  /**
+   * Rebuild the components of one instance whose prefab changed
+   */
+  private updateInstance(entity: Entity, entityManager: EntityManager, before: ResolvedComponents, after: ResolvedComponents): boolean {
+    const oldByType = new Map(before.map(entry => [entry.component.type, entry]));
+    const newByType = new Map(after.map(entry => [entry.component.type, entry]));
+    const rebuilt: SerializedComponent[] = [];
+    let removed = 0;
+
+    newByType.forEach(({ component, hash }, type) => {
+      const old = oldByType.get(type);
+      if (old && old.hash === hash) return;
+      const live = entityManager.getComponents(entity).find(c => ComponentRegistry.getTypeName(c) === type);
+      const current = live ? ComponentRegistry.serializeComponent(live) : null;
+      if (old && !current) return; // Removed on the instance
+
+      // Keep the instance's own changes on top of the new prefab data
+      const patch = old && current ? createMergePatch(old.component.data, current.data) : undefined;
+      const data = applyMergePatch(cloneData(component.data), patch);
+      if (current && hashContent(current.data) === hashContent(data)) return;
+      if (live) entityManager.removeComponent(entity, type);
+      rebuilt.push({ type, data });
+    });
+
+    // Components dropped from the prefab go too, unless the instance changed them
+    oldByType.forEach(({ hash }, type) => {
+      if (newByType.has(type)) return;
+      const live = entityManager.getComponents(entity).find(c => ComponentRegistry.getTypeName(c) === type);
+      const current = live ? ComponentRegistry.serializeComponent(live) : null;
+      if (current && hashContent(current.data) === hash) {
+        entityManager.removeComponent(entity, type);
+        removed++;
       }
+    });
+
+    if (rebuilt.length > 0) {
+      ComponentRegistry.instantiateComponents(entityManager, entity, rebuilt, this.factoryContext);
+    }
+    return rebuilt.length + removed > 0;
+  }
+
+  /**
+   * Add or replace a prefab, interning its component payloads in the blob table
+   * Returns the payloads the table did not have yet and the ones no prefab uses anymore
+   */
+  private addPrefab(prefab: Prefab): PrefabBlobChanges {
+    const previous = this.prefabs.has(prefab.id) ? this.componentHashes.get(prefab.id) || [] : [];
+    // Resolved lists of this prefab and the ones nested on it are stale now
+    this.affectedPrefabs(prefab.id).forEach(affected => this.resolved.delete(affected));
+
+    const added: PrefabBlobChanges['added'] = [];
+    const hashes: Array<string | null> = [];
+    prefab.entity.components = prefab.entity.components.map((component) => {
+      const { hash, data, isNew } = this.blobs.intern(component.data);
+      if (isNew && hash) added.push({ hash, data });
+      hashes.push(hash);
+      return { type: component.type, data };
+    });
+
+    this.prefabs.set(prefab.id, prefab);
+    this.componentHashes.set(prefab.id, hashes);
+    // Released after the new payloads are interned, so unchanged components keep their blob
+    const orphaned = previous.filter((hash): hash is string => hash !== null && this.blobs.release(hash));
+    return { added, orphaned };
+  }
+
+  /**
+   * Write one prefab (and its payload changes) to IndexedDB in the background
+   */
+  private savePrefabToStorage(changes: PrefabBlobChanges, prefab: Prefab): void {
+    if (typeof indexedDB === 'undefined') return; // SSR, Node (benchmarks)
+    const hashes = this.componentHashes.get(prefab.id) || [];
+    // Until storage is loaded, stored prefabs may still use a payload the table dropped
+    const orphaned = this.loaded ? changes.orphaned : [];
+    this.storage.savePrefab(prefab, hashes, changes.added, orphaned).catch((error) => {
+      console.error(`PrefabManager: Failed to save prefab ${prefab.id} to storage`, error);
+    });
+  }
+
+  /**
+   * Load prefabs from IndexedDB (prefabs created before loading finished are kept)
+   */
+  private async loadPrefabsFromStorage(): Promise<void> {
+    if (typeof indexedDB === 'undefined') return;
+    try {
+      const stored = await this.storage.loadAll();
+      stored.forEach(({ prefab, embedded }) => {
+        if (!this.prefabs.has(prefab.id)) {
+          const changes = this.addPrefab(prefab);
+          // Payloads stored inline (legacy records, hash collisions) move to the blob store when they can
+          if (embedded) this.savePrefabToStorage(changes, prefab);
+        }
+      });
+      this.loaded = true;
     } catch (error) {
       console.error('PrefabManager: Failed to load prefabs from storage', error);
     }
@@ -246,8 +443,7 @@ export class PrefabManager {
   importPrefab(jsonString: string): Prefab | null {
     try {
       const prefab: Prefab = JSON.parse(jsonString);
-      this.prefabs.set(prefab.id, prefab);
-      this.savePrefabsToStorage();
+      this.savePrefabToStorage(this.addPrefab(prefab), prefab);
       return prefab;
     } catch (error) {
       console.error('PrefabManager: Failed to import prefab', error);
@@ -256,6 +452,20 @@ export class PrefabManager {
   }
 }
 
-
-
-
+/**
+ * Full component list of a nested prefab: base components with the template's overrides applied
+ */
+function mergeOverrides(base: ResolvedComponents, template: SerializedEntity): SerializedComponent[] {
+  const replaced = new Map(template.components.map(c => [c.type, c]));
+  const removed = new Set(template.prefab?.removed || []);
+  const patches = template.prefab?.overrides || {};
+  const merged: SerializedComponent[] = [];
+  base.forEach(({ component }) => {
+    if (removed.has(component.type)) return;
+    const replacement = replaced.get(component.type);
+    replaced.delete(component.type);
+    merged.push(replacement || { type: component.type, data: applyMergePatch(component.data, patches[component.type]) });
+  });
+  replaced.forEach(component => merged.push(component));
+  return merged;
+}
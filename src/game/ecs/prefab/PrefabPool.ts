@@ -0,0 +1,124 @@
+import * as THREE from 'three';
+import { Entity } from '../Entity';
+import { EntityManager } from '../EntityManager';
+import type { PrefabManager } from './PrefabManager';
+import type { TransformComponent } from '../components/TransformComponent';
+import type { PhysicsComponent } from '../components/PhysicsComponent';
+import { TriggerComponent } from '../components/TriggerComponent';
+import { ScriptComponent } from '../components/ScriptComponent';
+import { Metrics } from '../../utils/Metrics';
+
+const reuseCount = Metrics.counter('prefabs.pool_reuses', 'Spawns served by a pooled instance');
+const createCount = Metrics.counter('prefabs.pool_creates', 'Spawns that had to instantiate the prefab');
+
+/**
+ * Prefab Pool - spawn/despawn of prefab instances without rebuilding them
+ * Despawned instances are disabled and kept per prefab (entity.metadata.pooled marks them, and
+ * saves skip them); a spawn reuses one - transform reset to the prefab's, triggers and scripts
+ * started over - and only instantiates the prefab when none is free. Cleared on scene load.
+ */
+export class PrefabPool {
+  private prefabManager: PrefabManager;
+  private entityManager: EntityManager;
+  private renderer: any;
+  private physicsWorld: any;
+  private free: Map<string, Entity[]> = new Map(); // Prefab ID -> despawned instances
+
+  constructor(prefabManager: PrefabManager, entityManager: EntityManager, renderer: any = null, physicsWorld: any = null) {
+    this.prefabManager = prefabManager;
+    this.entityManager = entityManager;
+    this.renderer = renderer;
+    this.physicsWorld = physicsWorld;
+  }
+
+  /**
+   * Spawn an instance of a prefab (at its saved position when none is given)
+   */
+  acquire(prefabId: string, position?: { x: number; y: number; z: number }): Entity | null {
+    const free = this.free.get(prefabId);
+    while (free && free.length > 0) {
+      const entity = free.pop()!;
+      if (!this.entityManager.getEntity(entity.id)) continue; // Removed while pooled
+      delete entity.metadata.pooled;
+      this.restore(prefabId, entity, position);
+      this.entityManager.setEntityEnabled(entity, true);
+      reuseCount.inc();
+      return entity;
+    }
+
+    createCount.inc();
+    return this.prefabManager.instantiatePrefab(prefabId, this.entityManager, this.renderer, this.physicsWorld, position);
+  }
+
+  /**
+   * Despawn a prefab instance (entities that are not prefab instances are removed)
+   */
+  release(entity: Entity): void {
+    const prefabId = entity.metadata.prefabId;
+    if (!prefabId || !this.prefabManager.getPrefab(prefabId)) {
+      this.entityManager.removeEntity(entity);
+      return;
+    }
+    if (entity.metadata.pooled) return;
+
+    this.entityManager.setEntityEnabled(entity, false);
+    entity.metadata.pooled = true;
+    let free = this.free.get(prefabId);
+    if (!free) {
+      free = [];
+      this.free.set(prefabId, free);
+    }
+    free.push(entity);
+  }
+
+  /**
+   * Create disabled instances ahead of use (one batch)
+   */
+  prewarm(prefabId: string, count: number): number {
+    const have = this.free.get(prefabId)?.length || 0;
+    if (count <= have) return 0;
+    const positions = Array.from({ length: count - have }, () => ({ x: 0, y: 0, z: 0 }));
+    const created = this.entityManager.batch(() => {
+      const entities = this.prefabManager.instantiatePrefabs(prefabId, this.entityManager, positions, this.renderer, this.physicsWorld);
+      entities.forEach(entity => this.release(entity));
+      return entities;
+    });
+    return created.length;
+  }
+
+  /**
+   * Forget pooled instances (their entities went with the scene)
+   */
+  clear(): void {
+    this.free.clear();
+  }
+
+  /**
+   * Put a reused instance back in its spawned state
+   */
+  private restore(prefabId: string, entity: Entity, position?: { x: number; y: number; z: number }): void {
+    const template = this.prefabManager.getPrefabComponents(prefabId)?.find(({ component }) => component.type === 'TransformComponent');
+    const transform = this.entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+    if (transform) {
+      if (template) transform.deserialize(template.component.data);
+      if (position) transform.setPosition(position);
+    }
+
+    const physics = this.entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent');
+    if (physics?.rigidBody && transform) {
+      const rotation = new THREE.Quaternion().setFromEuler(transform.rotation);
+      physics.updateTransform(transform.getPosition(), { x: rotation.x, y: rotation.y, z: rotation.z, w: rotation.w });
+      physics.rigidBody.setLinvel({ x: 0, y: 0, z: 0 }, false);
+      physics.rigidBody.setAngvel({ x: 0, y: 0, z: 0 }, false);
+    }
+
+    this.entityManager.getComponents(entity).forEach((component) => {
+      if (component instanceof TriggerComponent) {
+        component.reset();
+      } else if (component instanceof ScriptComponent) {
+        component.setScriptPath(component.properties.scriptPath);
+      }
+    });
+    this.entityManager.markDirty(entity);
+  }
+}
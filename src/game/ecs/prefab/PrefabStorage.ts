@@ -0,0 +1,176 @@
+import type { Prefab } from './PrefabManager';
+import type { SerializedEntity } from '../serialization/SceneSerializer';
+import { trackTransaction } from '../storage/transactionMetrics';
+
+const DB_NAME = 'DRD_PrefabDB';
+const DB_VERSION = 2;
+const STORE_NAME = 'prefabs';
+const BLOB_STORE_NAME = 'prefabBlobs'; // Component payloads by content hash, shared between prefabs
+const LEGACY_STORAGE_KEY = 'drd_prefabs'; // Whole library as one localStorage JSON string (before IndexedDB)
+
+/**
+ * Stored prefab - components reference their payload by content hash
+ * (records from before the blob store embed the data instead)
+ */
+interface StoredPrefabRecord extends Omit<Prefab, 'entity'> {
+  entity: Omit<SerializedEntity, 'components'> & {
+    components: Array<{ type: string; hash?: string; data?: any }>;
+  };
+}
+
+export interface PrefabBlob {
+  hash: string;
+  data: any;
+}
+
+/**
+ * Blob store changes from adding or replacing a prefab
+ */
+export interface PrefabBlobChanges {
+  added: PrefabBlob[]; // Payloads not stored yet
+  orphaned: string[]; // Hashes no prefab uses anymore
+}
+
+/**
+ * PrefabStorage - Handles saving/loading prefabs to/from IndexedDB
+ * One record per prefab, so saving a prefab only writes that prefab (asynchronously, off the main thread).
+ * Component payloads live in a shared blob store, so identical components are stored once.
+ */
+export class PrefabStorage {
+  private db: IDBDatabase | null = null;
+
+  /**
+   * Initialize IndexedDB database
+   */
+  async initialize(): Promise<void> {
+    return new Promise((resolve, reject) => {
+      const request = indexedDB.open(DB_NAME, DB_VERSION);
+
+      request.onerror = () => {
+        reject(new Error('Failed to open IndexedDB'));
+      };
+
+      request.onsuccess = () => {
+        this.db = request.result;
+        resolve();
+      };
+
+      request.onupgradeneeded = (event) => {
+        const db = (event.target as IDBOpenDBRequest).result;
+        if (!db.objectStoreNames.contains(STORE_NAME)) {
+          db.createObjectStore(STORE_NAME, { keyPath: 'id' });
+        }
+        if (!db.objectStoreNames.contains(BLOB_STORE_NAME)) {
+          db.createObjectStore(BLOB_STORE_NAME, { keyPath: 'hash' });
+        }
+      };
+    });
+  }
+
+  /**
+   * Load all prefabs with their components resolved (moves a legacy localStorage library into IndexedDB first)
+   * Prefabs with payloads stored inline (embedded) come last, so shared payloads claim their hashes first
+   */
+  async loadAll(): Promise<Array<{ prefab: Prefab; embedded: boolean }>> {
+    if (!this.db) {
+      await this.initialize();
+    }
+    await this.migrateLegacyStorage();
+
+    return new Promise((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME, BLOB_STORE_NAME], 'readonly'));
+      const prefabRequest = transaction.objectStore(STORE_NAME).getAll();
+      const blobRequest = transaction.objectStore(BLOB_STORE_NAME).getAll();
+
+      transaction.oncomplete = () => {
+        const blobs = new Map((blobRequest.result as PrefabBlob[]).map(blob => [blob.hash, blob.data]));
+        const records = prefabRequest.result as StoredPrefabRecord[];
+        const loaded = records.map(record => ({
+          prefab: {
+            ...record,
+            entity: {
+              ...record.entity,
+              components: record.entity.components
+                .filter(c => c.hash === undefined || blobs.has(c.hash))
+                .map(c => ({ type: c.type, data: c.hash !== undefined ? blobs.get(c.hash) : c.data })),
+            },
+          },
+          embedded: record.entity.components.some(c => c.hash === undefined),
+        }));
+        resolve(loaded.sort((a, b) => Number(a.embedded) - Number(b.embedded)));
+      };
+
+      transaction.onerror = () => {
+        reject(new Error('Failed to load prefabs'));
+      };
+    });
+  }
+
+  /**
+   * Save (insert or replace) one prefab
+   * @param hashes Content hash of each prefab component (same order; null = stored inline)
+   * @param newBlobs Payloads not stored yet
+   * @param orphanedBlobs Hashes of payloads to delete
+   */
+  async savePrefab(prefab: Prefab, hashes: Array<string | null>, newBlobs: PrefabBlob[] = [], orphanedBlobs: string[] = []): Promise<void> {
+    const record: StoredPrefabRecord = {
+      ...prefab,
+      entity: {
+        ...prefab.entity,
+        components: prefab.entity.components.map((c, i) => {
+          const hash = hashes[i];
+          return hash ? { type: c.type, hash } : { type: c.type, data: c.data };
+        }),
+      },
+    };
+    return this.write([record], newBlobs, 'Failed to save prefab', orphanedBlobs);
+  }
+
+  private async write(records: StoredPrefabRecord[], blobs: PrefabBlob[], errorMessage: string, orphanedBlobs: string[] = []): Promise<void> {
+    if (!this.db) {
+      await this.initialize();
+    }
+
+    return new Promise((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      // Blobs and the prefabs referencing them land in one transaction
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME, BLOB_STORE_NAME], 'readwrite'));
+      const store = transaction.objectStore(STORE_NAME);
+      const blobStore = transaction.objectStore(BLOB_STORE_NAME);
+      orphanedBlobs.forEach(hash => blobStore.delete(hash));
+      blobs.forEach(blob => blobStore.put(blob));
+      records.forEach(record => store.put(record));
+
+      transaction.oncomplete = () => {
+        resolve();
+      };
+
+      transaction.onerror = () => {
+        reject(new Error(errorMessage));
+      };
+    });
+  }
+
+  /**
+   * Copy the old localStorage library into IndexedDB once, then drop the key
+   */
+  private async migrateLegacyStorage(): Promise<void> {
+    if (typeof localStorage === 'undefined') return;
+    const stored = localStorage.getItem(LEGACY_STORAGE_KEY);
+    if (!stored) return;
+
+    // Written with embedded component data - the manager re-saves them as blobs when they change
+    const prefabs: StoredPrefabRecord[] = JSON.parse(stored);
+    await this.write(prefabs, [], 'Failed to migrate prefabs');
+    localStorage.removeItem(LEGACY_STORAGE_KEY);
+  }
+}
@@ -0,0 +1,835 @@
+import type { SerializedScene, SerializedEntity, SerializedComponent } from './SceneSerializer';
+import { ComponentRegistry, type ComponentBinaryCodec, type ComponentBinaryReader, type ComponentBinaryWriter } from '../ComponentRegistry';
+import { canonicalJson, cloneData } from './ContentHash';
+
+/**
+ * Binary Scene Format (.drds) - compact, streamable alternative to the JSON scene format
+ *
+ * Layout (little-endian):
+ *   Header:   magic "DRDS", u16 format version, u16 flags, then scene version/name/author
+ *             strings and createdAt/updatedAt (f64)
+ *   Sections: u8 section type, u32 byte length, payload
+ *     STRINGS  - strings first referenced by the next entity block (appended to the string table)
+ *     ENTITIES - a batch of entities: entity records, then a Float64 transform section,
+ *                a physics section (enum bytes + Float64 values) and per-component blocks
+ *                tagged with the ComponentRegistry type ID (data is either packed by the type's
+ *                binary codec or stored as JSON in the string table)
+ *     END      - total entity count (integrity check)
+ *
+ * Component payloads are deduplicated: a payload equal to an earlier one (same type and canonical
+ * JSON - typical for repeated brushes, props and prefab instances) is written as a reference to it.
+ * Version 2 added those shared blocks and prefab instance records, version 3 prefab override patches;
+ * older files still decode.
+ *
+ * Entity batches are self-contained once their STRINGS section has been read, so scenes can be
+ * encoded and decoded incrementally. Decoding yields the same SerializedScene as the JSON path
+ * (components with unexpected shapes fall back to an embedded JSON block).
+ */
+
+export const BINARY_SCENE_MAGIC = 0x53445244; // "DRDS" read as little-endian u32
+export const BINARY_SCENE_FORMAT_VERSION = 3;
+
+const SECTION_STRINGS = 1;
+const SECTION_ENTITIES = 2;
+const SECTION_END = 0xff;
+
+const SECTION_HEADER_SIZE = 5; // u8 type + u32 length
+const DEFAULT_ENTITIES_PER_BLOCK = 256;
+const NO_STRING = 0; // String index 0 is reserved for "absent"
+
+// Component type IDs come from ComponentRegistry (stable - stored in files)
+const CUSTOM_COMPONENT_TYPE = 0; // Followed by the type name (string index)
+
+// Component block encodings
+const BLOCK_JSON = 0; // Component data as embedded JSON
+const BLOCK_TRANSFORM = 1; // Data lives in the transform section
+const BLOCK_PHYSICS = 2; // Data lives in the physics section
+const BLOCK_CODEC = 3; // Written by the type's ComponentRegistry binary codec
+const BLOCK_SHARED = 4; // Same payload as an earlier component block (index among non-transform, non-shared blocks)
+
+const PHYSICS_BODY_TYPES = ['static', 'dynamic', 'kinematic'];
+const PHYSICS_SHAPES = ['box', 'sphere', 'cylinder', 'capsule', 'plane'];
+const PHYSICS_NUMBER_FIELDS = ['mass', 'friction', 'restitution', 'colliderRadius', 'colliderHeight'] as const;
+const PHYSICS_VALUE_COUNT = PHYSICS_NUMBER_FIELDS.length + 3; // + colliderSize x/y/z
+
+const TRANSFORM_VALUE_COUNT = 9;
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+export interface BinarySceneHeader {
+  formatVersion: number;
+  version: string;
+  metadata: SerializedScene['metadata'];
+}
+
+export interface BinaryEncodeOptions {
+  entitiesPerBlock?: number;
+}
+
+/**
+ * Growable byte buffer with little-endian writers
+ */
+class ByteWriter {
+  private buffer: Uint8Array;
+  private view: DataView;
+  public length = 0;
+
+  constructor(initialSize: number = 1024) {
+    this.buffer = new Uint8Array(initialSize);
+    this.view = new DataView(this.buffer.buffer);
+  }
+
+  private ensure(bytes: number): void {
+    if (this.length + bytes <= this.buffer.length) return;
+    let size = this.buffer.length * 2;
+    while (size < this.length + bytes) size *= 2;
+    const next = new Uint8Array(size);
+    next.set(this.buffer.subarray(0, this.length));
+    this.buffer = next;
+    this.view = new DataView(next.buffer);
+  }
+
+  u8(value: number): void {
+    this.ensure(1);
+    this.buffer[this.length++] = value;
+  }
+
+  u16(value: number): void {
+    this.ensure(2);
+    this.view.setUint16(this.length, value, true);
+    this.length += 2;
+  }
+
+  u32(value: number): void {
+    this.ensure(4);
+    this.view.setUint32(this.length, value, true);
+    this.length += 4;
+  }
+
+  f64(value: number): void {
+    this.ensure(8);
+    this.view.setFloat64(this.length, value, true);
+    this.length += 8;
+  }
+
+  /**
+   * Unsigned LEB128 varint
+   */
+  varint(value: number): void {
+    this.ensure(5);
+    while (value >= 0x80) {
+      this.buffer[this.length++] = (value & 0x7f) | 0x80;
+      value >>>= 7;
+    }
+    this.buffer[this.length++] = value;
+  }
+
+  bytes(data: Uint8Array): void {
+    this.ensure(data.length);
+    this.buffer.set(data, this.length);
+    this.length += data.length;
+  }
+
+  string(value: string): void {
+    const encoded = textEncoder.encode(value);
+    this.varint(encoded.length);
+    this.bytes(encoded);
+  }
+
+  /**
+   * Pad with zeros to an alignment boundary (so typed arrays can view the data directly)
+   */
+  align(alignment: number): void {
+    while (this.length % alignment !== 0) this.u8(0);
+  }
+
+  float64Array(values: Float64Array): void {
+    this.align(8);
+    this.bytes(new Uint8Array(values.buffer, values.byteOffset, values.byteLength));
+  }
+
+  float32Array(values: Float32Array): void {
+    this.align(4);
+    this.bytes(new Uint8Array(values.buffer, values.byteOffset, values.byteLength));
+  }
+
+  toBytes(): Uint8Array {
+    return this.buffer.slice(0, this.length);
+  }
+}
+
+/**
+ * Little-endian reader over one section payload
+ */
+class ByteReader {
+  private view: DataView;
+  public offset = 0;
+
+  constructor(private data: Uint8Array) {
+    this.view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+  }
+
+  u8(): number {
+    return this.data[this.offset++];
+  }
+
+  u16(): number {
+    const value = this.view.getUint16(this.offset, true);
+    this.offset += 2;
+    return value;
+  }
+
+  u32(): number {
+    const value = this.view.getUint32(this.offset, true);
+    this.offset += 4;
+    return value;
+  }
+
+  f64(): number {
+    const value = this.view.getFloat64(this.offset, true);
+    this.offset += 8;
+    return value;
+  }
+
+  varint(): number {
+    let result = 0;
+    let shift = 0;
+    let byte: number;
+    do {
+      byte = this.data[this.offset++];
+      result += (byte & 0x7f) * Math.pow(2, shift);
+      shift += 7;
+    } while (byte & 0x80);
+    return result;
+  }
+
+  string(): string {
+    const length = this.varint();
+    const end = this.offset + length;
+
+    // Fast path: short ASCII strings (names, IDs, tags) - TextDecoder has high per-call overhead
+    if (length <= 64) {
+      let ascii = true;
+      for (let i = this.offset; i < end; i++) {
+        if (this.data[i] >= 0x80) {
+          ascii = false;
+          break;
+        }
+      }
+      if (ascii) {
+        const value = String.fromCharCode.apply(null, this.data.subarray(this.offset, end) as unknown as number[]);
+        this.offset = end;
+        return value;
+      }
+    }
+
+    const value = textDecoder.decode(this.data.subarray(this.offset, end));
+    this.offset = end;
+    return value;
+  }
+
+  align(alignment: number): void {
+    this.offset = Math.ceil(this.offset / alignment) * alignment;
+  }
+
+  float64Array(count: number): Float64Array {
+    this.align(8);
+    const values = new Float64Array(count);
+    for (let i = 0; i < count; i++) {
+      values[i] = this.view.getFloat64(this.offset + i * 8, true);
+    }
+    this.offset += count * 8;
+    return values;
+  }
+
+  float32Array(count: number): Float32Array {
+    this.align(4);
+    const values = new Float32Array(count);
+    for (let i = 0; i < count; i++) {
+      values[i] = this.view.getFloat32(this.offset + i * 4, true);
+    }
+    this.offset += count * 4;
+    return values;
+  }
+}
+
+/**
+ * Encoder - produces the binary format as a sequence of chunks (header, then one chunk per entity batch)
+ */
+export class BinarySceneEncoder {
+  private strings: Map<string, number> = new Map();
+  private pendingStrings: string[] = [];
+  private sharedBlocks: Map<string, number> = new Map(); // Type + canonical JSON -> block index (no hash collisions)
+  private blockCount = 0;
+
+  /**
+   * Encode a whole scene into one buffer
+   */
+  static encode(scene: SerializedScene, options: BinaryEncodeOptions = {}): Uint8Array {
+    const chunks = Array.from(new BinarySceneEncoder().encodeChunks(scene, options));
+    const total = chunks.reduce((sum, chunk) => sum + chunk.length, 0);
+    const result = new Uint8Array(total);
+    let offset = 0;
+    chunks.forEach((chunk) => {
+      result.set(chunk, offset);
+      offset += chunk.length;
+    });
+    return result;
+  }
+
+  /**
+   * Encode a scene as a ReadableStream (e.g. to pipe through CompressionStream or into a Response)
+   */
+  static encodeStream(scene: SerializedScene, options: BinaryEncodeOptions = {}): ReadableStream<Uint8Array> {
+    const chunks = new BinarySceneEncoder().encodeChunks(scene, options);
+    return new ReadableStream<Uint8Array>({
+      pull(controller) {
+        const next = chunks.next();
+        if (next.done) {
+          controller.close();
+        } else {
+          controller.enqueue(next.value);
+        }
+      },
+    });
+  }
+
+  /**
+   * Lazily encode a scene - each yielded chunk is independent of the ones after it
+   */
+  *encodeChunks(scene: SerializedScene, options: BinaryEncodeOptions = {}): Generator<Uint8Array> {
+    const entitiesPerBlock = Math.max(1, options.entitiesPerBlock || DEFAULT_ENTITIES_PER_BLOCK);
+    this.strings.clear();
+    this.pendingStrings = [];
+    this.sharedBlocks.clear();
+    this.blockCount = 0;
+
+    yield this.encodeHeader(scene);
+
+    for (let start = 0; start < scene.entities.length; start += entitiesPerBlock) {
+      const entities = scene.entities.slice(start, start + entitiesPerBlock);
+      const entityPayload = this.encodeEntityBlock(entities);
+
+      // Strings are written before the block that first uses them
+      const stringPayload = new ByteWriter();
+      stringPayload.varint(this.pendingStrings.length);
+      this.pendingStrings.forEach(value => stringPayload.string(value));
+      this.pendingStrings = [];
+
+      const chunk = new ByteWriter(entityPayload.length + stringPayload.length + SECTION_HEADER_SIZE * 2);
+      writeSection(chunk, SECTION_STRINGS, stringPayload.toBytes());
+      writeSection(chunk, SECTION_ENTITIES, entityPayload);
+      yield chunk.toBytes();
+    }
+
+    const end = new ByteWriter(16);
+    const endPayload = new ByteWriter(8);
+    endPayload.u32(scene.entities.length);
+    writeSection(end, SECTION_END, endPayload.toBytes());
+    yield end.toBytes();
+  }
+
+  private encodeHeader(scene: SerializedScene): Uint8Array {
+    const writer = new ByteWriter(256);
+    writer.u32(BINARY_SCENE_MAGIC);
+    writer.u16(BINARY_SCENE_FORMAT_VERSION);
+    writer.u16(0); // Flags (reserved)
+    writer.string(scene.version);
+    writer.string(scene.metadata.name);
+    writer.u8(scene.metadata.author !== undefined ? 1 : 0);
+    if (scene.metadata.author !== undefined) writer.string(scene.metadata.author);
+    writer.f64(scene.metadata.createdAt);
+    writer.f64(scene.metadata.updatedAt);
+    return writer.toBytes();
+  }
+
+  private stringIndex(value: string): number {
+    let index = this.strings.get(value);
+    if (index === undefined) {
+      index = this.strings.size + 1; // 0 = NO_STRING
+      this.strings.set(value, index);
+      this.pendingStrings.push(value);
+    }
+    return index;
+  }
+
+  /**
+   * Try a registry codec (rolls back if it declines the data)
+   */
+  private encodeWithCodec(codec: ComponentBinaryCodec, data: any, components: ByteWriter): boolean {
+    const start = components.length;
+    components.u8(BLOCK_CODEC);
+    const writer: ComponentBinaryWriter = {
+      u8: value => components.u8(value),
+      varint: value => components.varint(value),
+      f64: value => components.f64(value),
+      float32Array: values => components.float32Array(values),
+      string: value => components.varint(this.stringIndex(value)),
+    };
+    if (codec.encode(data, writer)) return true;
+    components.length = start;
+    return false;
+  }
+
+  private encodeEntityBlock(entities: SerializedEntity[]): Uint8Array {
+    const records = new ByteWriter(entities.length * 32);
+    const transforms: number[] = [];
+    const transformFlags: number[] = [];
+    const physicsEnums = new ByteWriter(64);
+    const physicsValues: number[] = [];
+    const components = new ByteWriter(entities.length * 16);
+    let physicsCount = 0;
+
+    records.varint(entities.length);
+
+    entities.forEach((entity) => {
+      records.varint(this.stringIndex(entity.id));
+      records.varint(this.stringIndex(entity.name));
+      records.u8(entity.active ? 1 : 0);
+      records.varint(entity.tags.length);
+      entity.tags.forEach(tag => records.varint(this.stringIndex(tag)));
+      const hasMetadata = entity.metadata && Object.keys(entity.metadata).length > 0;
+      records.varint(hasMetadata ? this.stringIndex(JSON.stringify(entity.metadata)) : NO_STRING);
+      records.varint(entity.prefab ? this.stringIndex(entity.prefab.id) : NO_STRING);
+      if (entity.prefab) {
+        const removed = entity.prefab.removed || [];
+        records.varint(removed.length);
+        removed.forEach(type => records.varint(this.stringIndex(type)));
+        const overrides = entity.prefab.overrides;
+        records.varint(overrides ? this.stringIndex(JSON.stringify(overrides)) : NO_STRING);
+      }
+      records.varint(entity.components.length);
+
+      entity.components.forEach((component) => {
+        const definition = ComponentRegistry.get(component.type);
+        const typeId = definition?.typeId ?? CUSTOM_COMPONENT_TYPE;
+        components.u8(typeId);
+        if (typeId === CUSTOM_COMPONENT_TYPE) {
+          components.varint(this.stringIndex(component.type));
+        }
+
+        if (isPackableTransform(component)) {
+          // Transforms are nearly always unique - packed without a dedup lookup
+          components.u8(BLOCK_TRANSFORM);
+          const { position, rotation, scale } = component.data;
+          transforms.push(position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, scale.x, scale.y, scale.z);
+          transformFlags.push(component.data.enabled ? 1 : 0);
+          return;
+        }
+
+        const key = `${component.type}#${canonicalJson(component.data)}`;
+        const shared = this.sharedBlocks.get(key);
+        if (shared !== undefined) {
+          components.u8(BLOCK_SHARED);
+          components.varint(shared);
+          return;
+        }
+        this.sharedBlocks.set(key, this.blockCount++);
+
+        if (isPackablePhysics(component)) {
+          components.u8(BLOCK_PHYSICS);
+          const properties = component.data.properties;
+          physicsEnums.u8(PHYSICS_BODY_TYPES.indexOf(properties.bodyType));
+          physicsEnums.u8(PHYSICS_SHAPES.indexOf(properties.colliderShape));
+          // bit 0: enabled, bit 1: isSensor present, bit 2: isSensor value, bit 3: colliderSize present
+          physicsEnums.u8(
+            (component.data.enabled ? 1 : 0) |
+            (properties.isSensor !== undefined ? 2 : 0) |
+            (properties.isSensor ? 4 : 0) |
+            (properties.colliderSize !== undefined ? 8 : 0)
+          );
+          // Absent optional numbers are stored as NaN
+          PHYSICS_NUMBER_FIELDS.forEach(field => physicsValues.push(properties[field] ?? NaN));
+          const size = properties.colliderSize;
+          physicsValues.push(size?.x ?? NaN, size?.y ?? NaN, size?.z ?? NaN);
+          physicsCount++;
+        } else if (definition?.binary && this.encodeWithCodec(definition.binary, component.data, components)) {
+          // Written by the codec
+        } else {
+          // Through the string table: identical component data (common for brushes) is stored once
+          components.u8(BLOCK_JSON);
+          components.varint(this.stringIndex(JSON.stringify(component.data)));
+        }
+      });
+    });
+
+    const block = new ByteWriter(records.length + components.length + transforms.length * 8 + physicsValues.length * 8 + 64);
+    block.varint(records.length);
+    block.bytes(records.toBytes());
+
+    block.varint(transformFlags.length);
+    block.float64Array(Float64Array.from(transforms));
+    block.bytes(Uint8Array.from(transformFlags));
+
+    block.varint(physicsCount);
+    block.bytes(physicsEnums.toBytes());
+    block.float64Array(Float64Array.from(physicsValues));
+
+    block.varint(components.length);
+    block.bytes(components.toBytes());
+    return block.toBytes();
+  }
+}
+
+/**
+ * Decoder - accepts the binary format in arbitrary chunks and yields entities as batches complete
+ */
+export class BinarySceneDecoder {
+  private buffer: Uint8Array = new Uint8Array(0);
+  private strings: string[] = [''];
+  private blocks: any[] = []; // Decoded component payloads that later blocks may share
+  private entities: SerializedEntity[] = [];
+  private header: BinarySceneHeader | null = null;
+  private finished = false;
+
+  /**
+   * Decode a whole buffer
+   */
+  static decode(bytes: Uint8Array): SerializedScene {
+    const decoder = new BinarySceneDecoder();
+    decoder.push(bytes);
+    return decoder.finish();
+  }
+
+  /**
+   * Decode from a stream, reporting entity batches as they arrive
+   */
+  static async decodeStream(
+    stream: ReadableStream<Uint8Array>,
+    onEntities?: (entities: SerializedEntity[], header: BinarySceneHeader) => void
+  ): Promise<SerializedScene> {
+    const decoder = new BinarySceneDecoder();
+    const reader = stream.getReader();
+    while (true) {
+      const { done, value } = await reader.read();
+      if (done) break;
+      const entities = decoder.push(value);
+      if (entities.length > 0 && onEntities) {
+        onEntities(entities, decoder.getHeader()!);
+      }
+    }
+    return decoder.finish();
+  }
+
+  /**
+   * Check if bytes start with the binary scene magic number
+   */
+  static isBinaryScene(bytes: Uint8Array): boolean {
+    return bytes.length >= 4 && new DataView(bytes.buffer, bytes.byteOffset, 4).getUint32(0, true) === BINARY_SCENE_MAGIC;
+  }
+
+  getHeader(): BinarySceneHeader | null {
+    return this.header;
+  }
+
+  /**
+   * Feed more bytes; returns the entities completed by this chunk
+   */
+  push(chunk: Uint8Array): SerializedEntity[] {
+    if (this.finished) {
+      throw new Error('BinarySceneDecoder: data after end of scene');
+    }
+    this.append(chunk);
+
+    const decoded: SerializedEntity[] = [];
+    let offset = 0;
+
+    if (!this.header) {
+      const headerLength = this.tryReadHeader();
+      if (headerLength === 0) return decoded;
+      offset = headerLength;
+    }
+
+    while (!this.finished && this.buffer.length - offset >= SECTION_HEADER_SIZE) {
+      const view = new DataView(this.buffer.buffer, this.buffer.byteOffset + offset, SECTION_HEADER_SIZE);
+      const type = view.getUint8(0);
+      const length = view.getUint32(1, true);
+      if (this.buffer.length - offset - SECTION_HEADER_SIZE < length) break; // Wait for the rest
+
+      // Copy so typed-array sections are aligned relative to the payload start
+      const payload = this.buffer.slice(offset + SECTION_HEADER_SIZE, offset + SECTION_HEADER_SIZE + length);
+      offset += SECTION_HEADER_SIZE + length;
+
+      switch (type) {
+        case SECTION_STRINGS:
+          this.readStrings(payload);
+          break;
+        case SECTION_ENTITIES:
+          decoded.push(...this.readEntityBlock(payload));
+          break;
+        case SECTION_END: {
+          const expected = new ByteReader(payload).u32();
+          if (expected !== this.entities.length + decoded.length) {
+            throw new Error(`BinarySceneDecoder: expected ${expected} entities, decoded ${this.entities.length + decoded.length}`);
+          }
+          this.finished = true;
+          break;
+        }
+        default:
+          // Unknown section from a newer minor revision - skip it
+          break;
+      }
+    }
+
+    this.buffer = this.buffer.slice(offset);
+    this.entities.push(...decoded);
+    return decoded;
+  }
+
+  /**
+   * Complete decoding (throws if the data was truncated)
+   */
+  finish(): SerializedScene {
+    if (!this.header || !this.finished) {
+      throw new Error('BinarySceneDecoder: truncated scene data');
+    }
+    return {
+      version: this.header.version,
+      entities: this.entities,
+      metadata: this.header.metadata,
+    };
+  }
+
+  private append(chunk: Uint8Array): void {
+    if (this.buffer.length === 0) {
+      this.buffer = chunk;
+      return;
+    }
+    const merged = new Uint8Array(this.buffer.length + chunk.length);
+    merged.set(this.buffer);
+    merged.set(chunk, this.buffer.length);
+    this.buffer = merged;
+  }
+
+  /**
+   * Returns header byte length, or 0 if more data is needed
+   */
+  private tryReadHeader(): number {
+    if (this.buffer.length < 8) return 0;
+    const reader = new ByteReader(this.buffer);
+    if (reader.u32() !== BINARY_SCENE_MAGIC) {
+      throw new Error('BinarySceneDecoder: not a binary scene');
+    }
+    const formatVersion = reader.u16();
+    if (formatVersion > BINARY_SCENE_FORMAT_VERSION) {
+      throw new Error(`BinarySceneDecoder: unsupported format version ${formatVersion}`);
+    }
+    reader.u16(); // Flags
+
+    try {
+      const version = reader.string();
+      const name = reader.string();
+      const author = reader.u8() ? reader.string() : undefined;
+      const createdAt = reader.f64();
+      const updatedAt = reader.f64();
+      if (reader.offset > this.buffer.length) return 0;
+
+      const metadata: SerializedScene['metadata'] = { name, createdAt, updatedAt };
+      if (author !== undefined) metadata.author = author;
+      this.header = { formatVersion, version, metadata };
+      return reader.offset;
+    } catch (error) {
+      // Header split across chunks
+      if (error instanceof RangeError) return 0;
+      throw error;
+    }
+  }
+
+  private readStrings(payload: Uint8Array): void {
+    const reader = new ByteReader(payload);
+    const count = reader.varint();
+    for (let i = 0; i < count; i++) {
+      this.strings.push(reader.string());
+    }
+  }
+
+  /**
+   * Reader handed to registry codecs (strings resolve through the string table)
+   */
+  private codecReader(components: ByteReader): ComponentBinaryReader {
+    return {
+      u8: () => components.u8(),
+      varint: () => components.varint(),
+      f64: () => components.f64(),
+      float32Array: count => components.float32Array(count),
+      string: () => this.strings[components.varint()],
+    };
+  }
+
+  private readEntityBlock(payload: Uint8Array): SerializedEntity[] {
+    const reader = new ByteReader(payload);
+    const formatVersion = this.header!.formatVersion;
+
+    const recordsLength = reader.varint();
+    const records = new ByteReader(payload.subarray(reader.offset, reader.offset + recordsLength));
+    reader.offset += recordsLength;
+
+    const transformCount = reader.varint();
+    const transforms = reader.float64Array(transformCount * TRANSFORM_VALUE_COUNT);
+    const transformFlags = payload.subarray(reader.offset, reader.offset + transformCount);
+    reader.offset += transformCount;
+
+    const physicsCount = reader.varint();
+    const physicsEnums = payload.subarray(reader.offset, reader.offset + physicsCount * 3);
+    reader.offset += physicsCount * 3;
+    const physicsValues = reader.float64Array(physicsCount * PHYSICS_VALUE_COUNT);
+
+    const componentsLength = reader.varint();
+    const components = new ByteReader(payload.subarray(reader.offset, reader.offset + componentsLength));
+    const codecReader = this.codecReader(components);
+
+    let transformIndex = 0;
+    let physicsIndex = 0;
+    const entities: SerializedEntity[] = [];
+    const entityCount = records.varint();
+
+    for (let e = 0; e < entityCount; e++) {
+      const id = this.strings[records.varint()];
+      const name = this.strings[records.varint()];
+      const active = records.u8() === 1;
+      const tagCount = records.varint();
+      const tags: string[] = [];
+      for (let t = 0; t < tagCount; t++) tags.push(this.strings[records.varint()]);
+      const metadataIndex = records.varint();
+      const metadata = metadataIndex === NO_STRING ? {} : JSON.parse(this.strings[metadataIndex]);
+      let prefab: SerializedEntity['prefab'];
+      if (formatVersion >= 2) {
+        const prefabIndex = records.varint();
+        if (prefabIndex !== NO_STRING) {
+          const removedCount = records.varint();
+          const removed: string[] = [];
+          for (let r = 0; r < removedCount; r++) removed.push(this.strings[records.varint()]);
+          prefab = { id: this.strings[prefabIndex] };
+          if (removedCount > 0) prefab.removed = removed;
+          const overridesIndex = formatVersion >= 3 ? records.varint() : NO_STRING;
+          if (overridesIndex !== NO_STRING) prefab.overrides = JSON.parse(this.strings[overridesIndex]);
+        }
+      }
+      const componentCount = records.varint();
+
+      const entityComponents: SerializedComponent[] = [];
+      for (let c = 0; c < componentCount; c++) {
+        const typeId = components.u8();
+        const type = typeId === CUSTOM_COMPONENT_TYPE ? this.strings[components.varint()] : componentTypeName(typeId);
+        const encoding = components.u8();
+        let data: any;
+
+        switch (encoding) {
+          case BLOCK_TRANSFORM: {
+            const v = transforms.subarray(transformIndex * TRANSFORM_VALUE_COUNT, (transformIndex + 1) * TRANSFORM_VALUE_COUNT);
+            data = {
+              type,
+              position: { x: v[0], y: v[1], z: v[2] },
+              rotation: { x: v[3], y: v[4], z: v[5] },
+              scale: { x: v[6], y: v[7], z: v[8] },
+              enabled: transformFlags[transformIndex] === 1,
+            };
+            transformIndex++;
+            break;
+          }
+          case BLOCK_PHYSICS: {
+            const bodyType = PHYSICS_BODY_TYPES[physicsEnums[physicsIndex * 3]];
+            const colliderShape = PHYSICS_SHAPES[physicsEnums[physicsIndex * 3 + 1]];
+            const flags = physicsEnums[physicsIndex * 3 + 2];
+            const v = physicsValues.subarray(physicsIndex * PHYSICS_VALUE_COUNT, (physicsIndex + 1) * PHYSICS_VALUE_COUNT);
+            const properties: Record<string, any> = { bodyType, colliderShape };
+            PHYSICS_NUMBER_FIELDS.forEach((field, i) => {
+              if (!Number.isNaN(v[i])) properties[field] = v[i];
+            });
+            const sizeOffset = PHYSICS_NUMBER_FIELDS.length;
+            if (flags & 8) properties.colliderSize = { x: v[sizeOffset], y: v[sizeOffset + 1], z: v[sizeOffset + 2] };
+            if (flags & 2) properties.isSensor = (flags & 4) !== 0;
+            data = { type, properties, enabled: (flags & 1) !== 0 };
+            physicsIndex++;
+            break;
+          }
+          case BLOCK_CODEC: {
+            const codec = ComponentRegistry.get(type)?.binary;
+            if (!codec) {
+              throw new Error(`BinarySceneDecoder: no binary codec registered for ${type}`);
+            }
+            data = codec.decode(codecReader);
+            break;
+          }
+          case BLOCK_SHARED: {
+            const index = components.varint();
+            if (index >= this.blocks.length) {
+              throw new Error(`BinarySceneDecoder: shared block ${index} not decoded yet`);
+            }
+            // Components may keep references into their data, so each gets its own copy
+            data = cloneData(this.blocks[index]);
+            break;
+          }
+          default:
+            data = JSON.parse(this.strings[components.varint()]);
+        }
+        if (encoding !== BLOCK_TRANSFORM && encoding !== BLOCK_SHARED) {
+          this.blocks.push(data);
+        }
+
+        entityComponents.push({ type, data });
+      }
+
+      const entity: SerializedEntity = { id, name, active, tags, metadata, components: entityComponents };
+      if (prefab) entity.prefab = prefab;
+      entities.push(entity);
+    }
+
+    return entities;
+  }
+}
+
+function writeSection(writer: ByteWriter, type: number, payload: Uint8Array): void {
+  writer.u8(type);
+  writer.u32(payload.length);
+  writer.bytes(payload);
+}
+
+function componentTypeName(typeId: number): string {
+  const definition = ComponentRegistry.getById(typeId);
+  if (!definition) {
+    throw new Error(`BinarySceneDecoder: unknown component type ID ${typeId}`);
+  }
+  return definition.type;
+}
+
+function isVector(value: any): boolean {
+  return value && typeof value.x === 'number' && typeof value.y === 'number' && typeof value.z === 'number'
+    && Object.keys(value).length === 3;
+}
+
+function hasOnlyKeys(value: any, keys: string[]): boolean {
+  return Object.keys(value).every(key => keys.includes(key));
+}
+
+/**
+ * Transform data matching TransformComponent.serialize exactly (else it is stored as JSON)
+ */
+function isPackableTransform(component: SerializedComponent): boolean {
+  const data = component.data;
+  return component.type === 'TransformComponent' && !!data && data.type === component.type
+    && hasOnlyKeys(data, ['type', 'position', 'rotation', 'scale', 'enabled'])
+    && isVector(data.position) && isVector(data.rotation) && isVector(data.scale)
+    && typeof data.enabled === 'boolean';
+}
+
+/**
+ * Physics data matching PhysicsComponent.serialize exactly (else it is stored as JSON)
+ */
+function isPackablePhysics(component: SerializedComponent): boolean {
+  const data = component.data;
+  if (component.type !== 'PhysicsComponent' || !data || data.type !== component.type) return false;
+  if (!hasOnlyKeys(data, ['type', 'properties', 'enabled']) || typeof data.enabled !== 'boolean') return false;
+
+  const properties = data.properties;
+  if (!properties || !PHYSICS_BODY_TYPES.includes(properties.bodyType) || !PHYSICS_SHAPES.includes(properties.colliderShape)) {
+    return false;
+  }
+  if (!hasOnlyKeys(properties, ['bodyType', 'colliderShape', 'isSensor', 'colliderSize', ...PHYSICS_NUMBER_FIELDS])) return false;
+  if (properties.isSensor !== undefined && typeof properties.isSensor !== 'boolean') return false;
+  if (properties.colliderSize !== undefined && !isVector(properties.colliderSize)) return false;
+  // NaN marks absent values, so real NaNs must go through JSON (which turns them into null anyway)
+  return PHYSICS_NUMBER_FIELDS.every(field => properties[field] === undefined
+    || (typeof properties[field] === 'number' && !Number.isNaN(properties[field])));
+}
@@ -0,0 +1,95 @@
+/**
+ * Content hashing for serialized data - equal payloads get equal hashes regardless of key order
+ * Used to deduplicate component payloads in scene files and the prefab library
+ */
+
+/**
+ * JSON with object keys sorted, so equal content always gives the same text
+ */
+export function canonicalJson(value: any): string {
+  return JSON.stringify(value, (_key, v) => {
+    if (!v || typeof v !== 'object' || Array.isArray(v)) return v;
+    const sorted: Record<string, any> = {};
+    Object.keys(v).sort().forEach((key) => {
+      sorted[key] = v[key];
+    });
+    return sorted;
+  }) ?? 'undefined';
+}
+
+/**
+ * 64-bit hash of a string (two independent 32-bit FNV-1a style lanes), as 16 hex digits
+ */
+export function hashString(text: string): string {
+  let h1 = 0x811c9dc5;
+  let h2 = 0xc2b2ae35;
+  for (let i = 0; i < text.length; i++) {
+    const c = text.charCodeAt(i);
+    h1 = Math.imul(h1 ^ c, 0x01000193);
+    h2 = Math.imul(h2 ^ c, 0x5bd1e995);
+    h2 ^= h2 >>> 15;
+  }
+  return (h1 >>> 0).toString(16).padStart(8, '0') + (h2 >>> 0).toString(16).padStart(8, '0');
+}
+
+/**
+ * Content hash of any JSON-compatible value
+ */
+export function hashContent(value: any): string {
+  return hashString(canonicalJson(value));
+}
+
+/**
+ * Deep copy of a payload (shared payloads must not be mutated through the components built from them)
+ */
+export function cloneData<T>(data: T): T {
+  return typeof structuredClone === 'function' ? structuredClone(data) : JSON.parse(JSON.stringify(data));
+}
+
+/**
+ * Shared blob table - one copy of each distinct payload, referenced by content hash
+ * Reference counted, so blobs can be dropped when nothing uses them anymore
+ */
+export class SharedBlobTable {
+  private blobs: Map<string, { data: any; refs: number }> = new Map();
+
+  /**
+   * Add a reference to a payload; returns its hash, the shared copy and whether it was new to the table
+   * A payload whose hash collides with a different one is not shared (hash null)
+   */
+  intern(data: any): { hash: string | null; data: any; isNew: boolean } {
+    const json = canonicalJson(data);
+    const hash = hashString(json);
+    const existing = this.blobs.get(hash);
+    if (existing) {
+      if (canonicalJson(existing.data) !== json) return { hash: null, data, isNew: false };
+      existing.refs++;
+      return { hash, data: existing.data, isNew: false };
+    }
+    this.blobs.set(hash, { data, refs: 1 });
+    return { hash, data, isNew: true };
+  }
+
+  /**
+   * Drop a reference to a payload; returns true when that was the last one and the blob is gone
+   */
+  release(hash: string): boolean {
+    const blob = this.blobs.get(hash);
+    if (!blob) return false;
+    if (--blob.refs > 0) return false;
+    this.blobs.delete(hash);
+    return true;
+  }
+
+  get(hash: string): any {
+    return this.blobs.get(hash)?.data ?? null;
+  }
+
+  has(hash: string): boolean {
+    return this.blobs.has(hash);
+  }
+
+  get size(): number {
+    return this.blobs.size;
+  }
+}
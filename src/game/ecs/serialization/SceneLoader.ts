@@ -0,0 +1,214 @@
+import { Entity } from '../Entity';
+import { EntityManager } from '../EntityManager';
+import type { ComponentFactoryContext } from '../ComponentRegistry';
+import { SceneSerializer, SerializedScene, SerializedEntity } from './SceneSerializer';
+import { logScene } from '@/editor/utils/debugLogger';
+import { Tracer } from '@/game/utils/Tracer';
+
+/**
+ * atomic      - build the new scene hidden and disabled, swap it in when complete (cancel keeps the old scene)
+ * progressive - hide and unload the old scene, then show entities as they load, nearest to the origin first
+ */
+export type SceneLoadMode = 'atomic' | 'progressive';
+
+export type SceneLoadPhase = 'unloading' | 'building' | 'committing' | 'done' | 'cancelled';
+
+export interface SceneLoadProgress {
+  phase: SceneLoadPhase;
+  loaded: number;
+  total: number;
+  fraction: number; // 0..1
+}
+
+export interface SceneLoadOptions {
+  mode?: SceneLoadMode;
+  frameBudgetMs?: number; // Deserialization time per frame
+  origin?: { x: number; y: number; z: number }; // Progressive mode: load nearest entities first
+  signal?: AbortSignal;
+  onProgress?: (progress: SceneLoadProgress) => void;
+}
+
+export interface SceneLoadResult {
+  status: 'loaded' | 'cancelled';
+  entities: Entity[]; // Created entities (empty when cancelled)
+  idMap: Map<string, string>; // Saved entity ID -> created entity ID
+  slices: number; // Frames the load was spread over
+  durationMs: number;
+  unloaded: Promise<void>; // Atomic mode: resolves once the replaced entities are removed (after the swap)
+}
+
+const DEFAULT_FRAME_BUDGET_MS = 6;
+
+/**
+ * Scene Loader - time-sliced scene deserialization
+ * Builds entities in small batches across animation frames instead of blocking the tab,
+ * reporting progress and allowing cancellation between batches.
+ */
+export class SceneLoader {
+  /**
+   * Load a serialized scene into the entity manager, replacing the current entities
+   */
+  static async load(
+    entityManager: EntityManager,
+    serialized: SerializedScene,
+    context: ComponentFactoryContext,
+    options: SceneLoadOptions = {}
+  ): Promise<SceneLoadResult> {
+    const startTime = performance.now();
+    const mode = options.mode || 'atomic';
+    const frameBudgetMs = options.frameBudgetMs ?? DEFAULT_FRAME_BUDGET_MS;
+    const ordered = mode === 'progressive' && options.origin
+      ? this.sortByDistance(serialized.entities, options.origin)
+      : serialized.entities;
+    const total = ordered.length;
+
+    const created: Entity[] = [];
+    const idMap = new Map<string, string>();
+    let slices = 0;
+    const span = Tracer.asyncBegin(`scene.load ${serialized.metadata.name}`, 'scene');
+
+    const report = (phase: SceneLoadPhase) => {
+      options.onProgress?.({ phase, loaded: created.length, total, fraction: total > 0 ? created.length / total : 1 });
+    };
+
+    const cancel = (): SceneLoadResult => {
+      entityManager.removeEntities(created);
+      logScene('SceneLoader: Load cancelled', { sceneName: serialized.metadata.name, loaded: created.length, total, mode });
+      created.length = 0;
+      idMap.clear();
+      report('cancelled');
+      Tracer.asyncEnd(span);
+      return { status: 'cancelled', entities: [], idMap, slices, durationMs: performance.now() - startTime, unloaded: Promise.resolve() };
+    };
+
+    logScene('SceneLoader: Starting load', { sceneName: serialized.metadata.name, total, mode, frameBudgetMs });
+
+    // Atomic mode keeps the current scene until the new one is complete
+    const previous = entityManager.getAllEntities();
+    if (mode === 'progressive') {
+      // Hidden at once, removed across frames (no single clearAll stall)
+      report('unloading');
+      this.hide(entityManager, previous);
+      slices += await this.unload(entityManager, previous, frameBudgetMs);
+    }
+
+    let index = 0;
+    while (index < total) {
+      if (options.signal?.aborted) return cancel();
+
+      const sliceStart = performance.now();
+      // One EntityManager batch per slice (meshes enter the scene together, one notification)
+      entityManager.batch(() => {
+        // At least one entity per slice, so a tiny budget still makes progress
+        do {
+          const entity = SceneSerializer.deserializeEntity(entityManager, ordered[index], context);
+          if (mode === 'atomic') {
+            entityManager.setEntityEnabled(entity, false);
+          }
+          created.push(entity);
+          if (ordered[index].id) idMap.set(ordered[index].id, entity.id);
+          index++;
+        } while (index < total && performance.now() - sliceStart < frameBudgetMs);
+      });
+      Tracer.complete('scene.load.slice', 'scene', sliceStart, performance.now() - sliceStart);
+
+      slices++;
+      report('building');
+
+      if (index < total) {
+        await nextFrame();
+      }
+    }
+
+    if (options.signal?.aborted) return cancel();
+
+    let unloaded = Promise.resolve();
+    if (mode === 'atomic') {
+      report('committing');
+      // Swap in one batch (only visibility changes), then remove the old entities across frames
+      entityManager.batch(() => {
+        this.hide(entityManager, previous);
+        created.forEach((entity, i) => entityManager.setEntityEnabled(entity, ordered[i].active));
+      });
+      unloaded = this.unload(entityManager, previous, frameBudgetMs).then(() => undefined);
+    }
+
+    const durationMs = performance.now() - startTime;
+    logScene('SceneLoader: Load complete', {
+      sceneName: serialized.metadata.name,
+      entityCount: created.length,
+      slices,
+      durationMs: Math.round(durationMs),
+    });
+    report('done');
+    Tracer.asyncEnd(span);
+
+    return { status: 'loaded', entities: created, idMap, slices, durationMs, unloaded };
+  }
+
+  /**
+   * Remove entities in time slices - one EntityManager batch per frame, at least one entity each
+   * Entities already removed are skipped, so overlapping unloads are harmless.
+   * @returns Number of frames the removal took
+   */
+  static async unload(entityManager: EntityManager, entities: Entity[], frameBudgetMs: number = DEFAULT_FRAME_BUDGET_MS): Promise<number> {
+    let index = 0;
+    let slices = 0;
+    while (index < entities.length) {
+      const sliceStart = performance.now();
+      entityManager.batch(() => {
+        do {
+          entityManager.removeEntity(entities[index]);
+          index++;
+        } while (index < entities.length && performance.now() - sliceStart < frameBudgetMs);
+      });
+      Tracer.complete('scene.unload.slice', 'scene', sliceStart, performance.now() - sliceStart);
+
+      slices++;
+      if (index < entities.length) {
+        await nextFrame();
+      }
+    }
+    return slices;
+  }
+
+  /**
+   * Disable entities (meshes, lights and colliders off) while they wait to be removed
+   */
+  private static hide(entityManager: EntityManager, entities: Entity[]): void {
+    entityManager.batch(() => entities.forEach(entity => entityManager.setEntityEnabled(entity, false)));
+  }
+
+  /**
+   * Entities with a transform, nearest first (entities without one keep their order, after the rest)
+   */
+  private static sortByDistance(entities: SerializedEntity[], origin: { x: number; y: number; z: number }): SerializedEntity[] {
+    const distances = new Map<SerializedEntity, number>();
+    entities.forEach((entity) => {
+      const position = entity.components.find(c => c.type === 'TransformComponent')?.data?.position;
+      const distance = position
+        ? (position.x - origin.x) ** 2 + (position.y - origin.y) ** 2 + (position.z - origin.z) ** 2
+        : Infinity;
+      distances.set(entity, distance);
+    });
+    // Array.prototype.sort is stable, so ties keep their saved order
+    return [...entities].sort((a, b) => {
+      const da = distances.get(a)!;
+      const db = distances.get(b)!;
+      return da === db ? 0 : da - db;
+    });
+  }
+}
+
+/**
+ * Resolve on the next animation frame (next macrotask outside the browser)
+ */
+function nextFrame(): Promise<void> {
+  return new Promise((resolve) => {
+    if (typeof requestAnimationFrame === 'function') {
+      requestAnimationFrame(() => resolve());
+    } else {
+      setTimeout(resolve, 0);
+    }
+  });
+}
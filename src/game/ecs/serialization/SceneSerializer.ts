@@ -1,11 +1,11 @@
 import { Entity } from '../Entity';
-import { Component } from '../Component';
 import { EntityManager } from '../EntityManager';
-import { TransformComponent } from '../components/TransformComponent';
-import { MeshRendererComponent } from '../components/MeshRendererComponent';
-import { PhysicsComponent } from '../components/PhysicsComponent';
-import { LightComponent } from '../components/LightComponent';
+import { ComponentRegistry, type ComponentFactoryContext } from '../ComponentRegistry';
 import { logScene } from '@/editor/utils/debugLogger';
+import { BinarySceneEncoder, BinarySceneDecoder } from './BinarySceneFormat';
+import { hashContent, cloneData } from './ContentHash';
+import { createMergePatch, applyMergePatch } from '../prefab/PrefabDiff';
+import { Debug, LOG_DEBUG, LOG_TRACE } from '../../utils/debug';
 
 export interface SerializedScene {
   version: string;
@@ -25,6 +25,12 @@ export interface SerializedEntity {
   tags: string[];
   metadata: Record<string, any>;
   components: SerializedComponent[];
+  // Prefab instance: components only holds replaced components and ones the prefab does not have
+  prefab?: {
+    id: string;
+    removed?: string[]; // Prefab component types the instance does not have
+    overrides?: Record<string, any>; // Component type -> merge patch over the prefab's data (see PrefabDiff)
+  };
 }
 
 export interface SerializedComponent {
@@ -32,78 +38,70 @@ export interface SerializedComponent {
   data: any;
 }
 
+/**
+ * Prefab lookup for storing prefab instances as overrides (implemented by PrefabManager)
+ */
+export interface PrefabSource {
+  /** Prefab components with their content hashes (null if the prefab is unknown) */
+  getPrefabComponents(prefabId: string): Array<{ component: SerializedComponent; hash: string }> | null;
+}
+
+export interface SerializeOptions {
+  inlinePrefabs?: boolean; // Write prefab instances in full (self-contained exports)
+  prefabId?: string; // Prefab to diff against (defaults to metadata.prefabId)
+  entityId?: (id: string) => string; // ID to write for a live entity ID (defaults to the live ID)
+}
+
 /**
  * SceneSerializer - Handles serialization and deserialization of scenes
  */
 export class SceneSerializer {
+  private static prefabSource: PrefabSource | null = null;
+
+  /**
+   * Set the prefab library instances are diffed against (entities with metadata.prefabId)
+   */
+  static setPrefabSource(source: PrefabSource | null): void {
+    this.prefabSource = source;
+  }
+
   /**
    * Serialize entire scene to JSON
    */
-  static serialize(entityManager: EntityManager, sceneName: string = 'Scene', author?: string): SerializedScene {
+  static serialize(
+    entityManager: EntityManager,
+    sceneName: string = 'Scene',
+    author?: string,
+    options: SerializeOptions = {}
+  ): SerializedScene {
     const entities: SerializedEntity[] = [];
     const allEntities = entityManager.getAllEntities();
     
-    logScene('serialize: Starting serialization', {
-      sceneName,
-      entityCount: allEntities.length,
-    });
-
-    allEntities.forEach((entity) => {
-      logScene('serialize: Serializing entity', {
-        entityId: entity.id,
-        entityName: entity.name,
+    if (LOG_DEBUG) {
+      logScene('serialize: Starting serialization', {
+        sceneName,
+        entityCount: allEntities.length,
       });
-      const serializedEntity: SerializedEntity = {
-        id: entity.id,
-        name: entity.name,
-        active: entity.active,
-        tags: Array.from(entity.tags),
-        metadata: { ...entity.metadata },
-        components: [],
-      };
-
-      // Get all components for this entity (we'll need to access the internal map)
-      // For now, we'll try to get known component types
-      const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-      if (transform) {
-        serializedEntity.components.push({
-          type: 'TransformComponent',
-          data: transform.serialize(),
-        });
-      }
-
-      const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent');
-      if (meshRenderer) {
-        serializedEntity.components.push({
-          type: 'MeshRendererComponent',
-          data: meshRenderer.serialize(),
-        });
-      }
-
-      const physics = entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent');
-      if (physics) {
-        serializedEntity.components.push({
-          type: 'PhysicsComponent',
-          data: physics.serialize(),
-        });
-      }
+    }
 
-      const light = entityManager.getComponent<LightComponent>(entity, 'LightComponent');
-      if (light) {
-        serializedEntity.components.push({
-          type: 'LightComponent',
-          data: light.serialize(),
+    allEntities.forEach((entity) => {
+      if (entity.metadata.pooled) return; // Despawned, waiting in a PrefabPool
+      if (LOG_TRACE) {
+        logScene('serialize: Serializing entity', {
+          entityId: entity.id,
+          entityName: entity.name,
         });
       }
-
-      entities.push(serializedEntity);
+      entities.push(this.serializeEntity(entityManager, entity, options));
     });
 
-    logScene('serialize: Serialization complete', {
-      sceneName,
-      entityCount: entities.length,
-      serializedEntities: entities.map(e => ({ id: e.id, name: e.name })),
-    });
+    if (LOG_TRACE) {
+      logScene('serialize: Serialization complete', {
+        sceneName,
+        entityCount: entities.length,
+        serializedEntities: entities.map(e => ({ id: e.id, name: e.name })),
+      });
+    }
 
     return {
       version: '1.0.0',
@@ -126,157 +124,169 @@ export class SceneSerializer {
     renderer: any,
     physicsWorld: any
   ): void {
-    logScene('deserialize: Starting deserialization', {
-      sceneName: serialized.metadata.name,
-      version: serialized.version,
-      entityCount: serialized.entities.length,
-      metadata: serialized.metadata,
-    });
+    if (LOG_DEBUG) {
+      logScene('deserialize: Starting deserialization', {
+        sceneName: serialized.metadata.name,
+        version: serialized.version,
+        entityCount: serialized.entities.length,
+        metadata: serialized.metadata,
+      });
+    }
 
     let entityIndex = 0;
     serialized.entities.forEach((serializedEntity) => {
-      logScene(`deserialize: Deserializing entity ${entityIndex + 1}/${serialized.entities.length}`, {
-        name: serializedEntity.name,
-        id: serializedEntity.id,
-        active: serializedEntity.active,
-        tags: serializedEntity.tags,
-        componentCount: serializedEntity.components.length,
-        componentTypes: serializedEntity.components.map(c => c.type),
-      });
+      if (LOG_TRACE) {
+        logScene(`deserialize: Deserializing entity ${entityIndex + 1}/${serialized.entities.length}`, {
+          name: serializedEntity.name,
+          id: serializedEntity.id,
+          active: serializedEntity.active,
+          tags: serializedEntity.tags,
+          componentCount: serializedEntity.components.length,
+          componentTypes: serializedEntity.components.map(c => c.type),
+        });
+      }
 
-      // Create entity
-      const entity = entityManager.createEntity(serializedEntity.name);
-      entity.active = serializedEntity.active;
-      serializedEntity.tags.forEach(tag => entity.addTag(tag));
-      entity.metadata = { ...serializedEntity.metadata };
-
-      logScene(`deserialize: Entity created`, {
-        name: entity.name,
-        id: entity.id,
-        active: entity.active,
-        tags: Array.from(entity.tags),
-      });
+      const entity = this.deserializeEntity(entityManager, serializedEntity, { renderer, physicsWorld });
 
-      // Create components
-      serializedEntity.components.forEach((serializedComponent, compIndex) => {
-        logScene(`deserialize: Adding component ${compIndex + 1}/${serializedEntity.components.length}`, {
+      if (LOG_TRACE) {
+        // Get the object3D to check if it was added to scene
+        const obj3d = entityManager.getObject3D(entity);
+        logScene(`deserialize: Entity ${entityIndex + 1} completed`, {
           entityName: entity.name,
-          componentType: serializedComponent.type,
-          data: serializedComponent.data,
+          entityId: entity.id,
+          hasObject3D: !!obj3d,
+          object3DName: obj3d?.name,
+          object3DUuid: obj3d?.uuid,
+          object3DType: obj3d?.type,
         });
+      }
+
+      entityIndex++;
+    });
 
-        switch (serializedComponent.type) {
-          case 'TransformComponent':
-            const transform = new TransformComponent(entity);
-            transform.deserialize(serializedComponent.data);
-            entityManager.addComponent(entity, transform);
-            logScene(`deserialize: TransformComponent added`, {
-              entityName: entity.name,
-              position: transform.position.toArray(),
-              rotation: transform.rotation.toArray(),
-              scale: transform.scale.toArray(),
-            });
-            break;
-
-          case 'MeshRendererComponent':
-            const meshRenderer = new MeshRendererComponent(
-              entity,
-              serializedComponent.data.geometry,
-              serializedComponent.data.materialColor,
-              renderer
-            );
-            meshRenderer.deserialize(serializedComponent.data);
-            entityManager.addComponent(entity, meshRenderer);
-            const mesh = meshRenderer.getMesh(renderer);
-            logScene(`deserialize: MeshRendererComponent added`, {
-              entityName: entity.name,
-              hasMesh: !!mesh,
-              meshName: mesh?.name,
-              geometry: serializedComponent.data.geometry,
-            });
-            break;
-
-          case 'PhysicsComponent':
-            const physics = new PhysicsComponent(entity, serializedComponent.data.properties, physicsWorld);
-            physics.deserialize(serializedComponent.data);
-            entityManager.addComponent(entity, physics);
-            // Update transform to match physics position
-            const transformComp = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-            if (transformComp && physics.rigidBody) {
-              const physTransform = physics.getTransform();
-              transformComp.setPosition(physTransform.position);
-            }
-            logScene(`deserialize: PhysicsComponent added`, {
-              entityName: entity.name,
-              hasRigidBody: !!physics.rigidBody,
-              properties: serializedComponent.data.properties,
-            });
-            break;
-
-          case 'LightComponent':
-            const light = new LightComponent(entity, serializedComponent.data.properties);
-            light.deserialize(serializedComponent.data);
-            entityManager.addComponent(entity, light);
-            logScene(`deserialize: LightComponent added`, {
-              entityName: entity.name,
-              lightType: serializedComponent.data.properties?.type,
-            });
-            break;
-
-          default:
-            logScene(`deserialize: Unknown component type: ${serializedComponent.type}`, {
-              entityName: entity.name,
-              componentType: serializedComponent.type,
-            });
-        }
+    if (LOG_DEBUG) {
+      const finalEntityCount = entityManager.getAllEntities().length;
+      logScene('deserialize: Deserialization complete', {
+        sceneName: serialized.metadata.name,
+        expectedEntities: serialized.entities.length,
+        actualEntities: finalEntityCount,
+        match: finalEntityCount === serialized.entities.length,
       });
+    }
+  }
 
-      // Update transforms after all components are added
-      const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
-      if (transform) {
-        const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent');
-        if (meshRenderer) {
-          meshRenderer.updateTransform({
-            position: transform.position,
-            rotation: transform.rotation,
-            scale: transform.scale,
-          });
-          logScene(`deserialize: MeshRenderer transform updated`, {
-            entityName: entity.name,
-            position: transform.position.toArray(),
-          });
-        }
-
-        const light = entityManager.getComponent<LightComponent>(entity, 'LightComponent');
-        if (light) {
-          light.updateTransform(transform.position, transform.rotation);
-          logScene(`deserialize: Light transform updated`, {
-            entityName: entity.name,
-            position: transform.position.toArray(),
-          });
-        }
+  /**
+   * Serialize one entity with all its registered components (ID kept as-is)
+   * Prefab instances keep only the components that differ from their prefab
+   */
+  static serializeEntity(entityManager: EntityManager, entity: Entity, options: SerializeOptions = {}): SerializedEntity {
+    const components: SerializedComponent[] = [];
+    entityManager.getComponents(entity).forEach((component) => {
+      const serializedComponent = ComponentRegistry.serializeComponent(component);
+      if (serializedComponent) {
+        components.push(serializedComponent);
       }
+    });
+
+    const serialized: SerializedEntity = {
+      id: options.entityId ? options.entityId(entity.id) : entity.id,
+      name: entity.name,
+      active: entity.active,
+      tags: Array.from(entity.tags),
+      metadata: { ...entity.metadata },
+      components,
+    };
 
-      // Get the object3D to check if it was added to scene
-      const obj3d = entityManager.getObject3D(entity);
-      logScene(`deserialize: Entity ${entityIndex + 1} completed`, {
-        entityName: entity.name,
-        entityId: entity.id,
-        hasObject3D: !!obj3d,
-        object3DName: obj3d?.name,
-        object3DUuid: obj3d?.uuid,
-        object3DType: obj3d?.type,
+    const prefabId = options.prefabId ?? entity.metadata.prefabId;
+    const prefabComponents = prefabId && !options.inlinePrefabs ? this.prefabSource?.getPrefabComponents(prefabId) : null;
+    if (prefabComponents) {
+      const prefabData = new Map(prefabComponents.map(({ component, hash }) => [component.type, { data: component.data, hash }]));
+      const types = new Set(components.map(c => c.type));
+      const removed = prefabComponents.map(({ component }) => component.type).filter(type => !types.has(type));
+      const overrides: Record<string, any> = {};
+      serialized.components = components.filter((component) => {
+        const base = prefabData.get(component.type);
+        if (!base) return true; // Added on the instance
+        if (base.hash === hashContent(component.data)) return false;
+        // Transforms differ per instance anyway - kept whole, they pack tightly in the binary format
+        if (component.type === 'TransformComponent') return true;
+        overrides[component.type] = createMergePatch(base.data, component.data);
+        return false;
       });
+      serialized.prefab = { id: prefabId };
+      if (removed.length > 0) serialized.prefab.removed = removed;
+      if (Object.keys(overrides).length > 0) serialized.prefab.overrides = overrides;
+    }
 
-      entityIndex++;
+    return serialized;
+  }
+
+  /**
+   * Full component list of a serialized entity (prefab instances are merged with their prefab)
+   */
+  static resolveComponents(serializedEntity: SerializedEntity): SerializedComponent[] {
+    const prefab = serializedEntity.prefab;
+    if (!prefab) return serializedEntity.components;
+
+    const prefabComponents = this.prefabSource?.getPrefabComponents(prefab.id);
+    if (!prefabComponents) {
+      Debug.warn('SceneSerializer', `Prefab ${prefab.id} of ${serializedEntity.name} not found - loading its overrides only`);
+      return serializedEntity.components;
+    }
+
+    const replaced = new Map(serializedEntity.components.map(c => [c.type, c]));
+    const removed = new Set(prefab.removed || []);
+    const patches = prefab.overrides || {};
+    const resolved: SerializedComponent[] = [];
+    prefabComponents.forEach(({ component }) => {
+      if (removed.has(component.type)) return;
+      const replacement = replaced.get(component.type);
+      replaced.delete(component.type);
+      resolved.push(replacement || {
+        type: component.type,
+        data: applyMergePatch(cloneData(component.data), patches[component.type]),
+      });
     });
+    replaced.forEach(component => resolved.push(component)); // Components added on the instance
+    return resolved;
+  }
+
+  /**
+   * Create an entity and its components from serialized data (a new entity ID is assigned)
+   * Does no per-entity scene logging, so it can be used on hot paths (see SceneLoader)
+   */
+  static deserializeEntity(
+    entityManager: EntityManager,
+    serializedEntity: SerializedEntity,
+    context: ComponentFactoryContext
+  ): Entity {
+    const entity = entityManager.createEntity(serializedEntity.name);
+    entity.active = serializedEntity.active;
+    serializedEntity.tags.forEach(tag => entity.addTag(tag));
+    entity.metadata = { ...serializedEntity.metadata };
 
-    const finalEntityCount = entityManager.getAllEntities().length;
-    logScene('deserialize: Deserialization complete', {
-      sceneName: serialized.metadata.name,
-      expectedEntities: serialized.entities.length,
-      actualEntities: finalEntityCount,
-      match: finalEntityCount === serialized.entities.length,
+    ComponentRegistry.instantiateComponents(entityManager, entity, this.resolveComponents(serializedEntity), context);
+    return entity;
+  }
+
+  /**
+   * Create many entities as one EntityManager batch (IDs reserved together, scene updated in one pass)
+   */
+  static deserializeEntities(
+    entityManager: EntityManager,
+    serializedEntities: SerializedEntity[],
+    context: ComponentFactoryContext
+  ): Entity[] {
+    return entityManager.batch(() => {
+      const entities = entityManager.createEntities(serializedEntities.map(e => e.name));
+      entities.forEach((entity, i) => {
+        const serializedEntity = serializedEntities[i];
+        entity.active = serializedEntity.active;
+        serializedEntity.tags.forEach(tag => entity.addTag(tag));
+        entity.metadata = { ...serializedEntity.metadata };
+        ComponentRegistry.instantiateComponents(entityManager, entity, this.resolveComponents(serializedEntity), context);
+      });
+      return entities;
     });
   }
 
@@ -284,7 +294,8 @@ export class SceneSerializer {
    * Export scene to JSON string
    */
   static exportToJSON(entityManager: EntityManager, sceneName: string = 'Scene', author?: string): string {
-    const serialized = this.serialize(entityManager, sceneName, author);
+    // Exported files are self-contained (prefab instances written in full)
+    const serialized = this.serialize(entityManager, sceneName, author, { inlinePrefabs: true });
     return JSON.stringify(serialized, null, 2);
   }
 
@@ -301,5 +312,27 @@ export class SceneSerializer {
     this.deserialize(entityManager, serialized, renderer, physicsWorld);
     return serialized;
   }
+
+  /**
+   * Export scene to the compact binary format (see BinarySceneFormat)
+   */
+  static exportToBinary(entityManager: EntityManager, sceneName: string = 'Scene', author?: string): Uint8Array {
+    const serialized = this.serialize(entityManager, sceneName, author, { inlinePrefabs: true });
+    return BinarySceneEncoder.encode(serialized);
+  }
+
+  /**
+   * Import scene from the binary format
+   */
+  static importFromBinary(
+    entityManager: EntityManager,
+    bytes: Uint8Array,
+    renderer: any,
+    physicsWorld: any
+  ): SerializedScene {
+    const serialized = BinarySceneDecoder.decode(bytes);
+    this.deserialize(entityManager, serialized, renderer, physicsWorld);
+    return serialized;
+  }
 }
 
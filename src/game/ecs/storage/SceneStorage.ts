@@ -1,12 +1,82 @@
-import { SceneSerializer, SerializedScene } from '../serialization/SceneSerializer';
+import { SceneSerializer, SerializedScene, SerializedEntity } from '../serialization/SceneSerializer';
+import { BinarySceneEncoder, BinarySceneDecoder } from '../serialization/BinarySceneFormat';
 import { EntityManager } from '../EntityManager';
+import { compressBytes, decompressBytes, type CompressionFormat } from './compression';
+import type { SaveGame } from '../../core/SaveGame';
+import { trackTransaction } from './transactionMetrics';
 
 const DB_NAME = 'DRD_SceneDB';
-const DB_VERSION = 1;
-const STORE_NAME = 'scenes';
+const DB_VERSION = 4;
+const STORE_NAME = 'scenes'; // Lightweight metadata - what the scene browser reads
+const PAYLOAD_STORE_NAME = 'scenePayloads'; // Encoded scene snapshots
+const ENTITY_STORE_NAME = 'sceneEntities'; // Per-entity deltas on top of a scene snapshot
+const SAVE_GAME_STORE_NAME = 'saveGames'; // Runtime save games, one per slot
+
+/**
+ * Scene metadata record - everything the scene browser shows, without the entities
+ */
+export interface SceneMetadata {
+  id: string;
+  name: string;
+  author?: string;
+  createdAt: number;
+  updatedAt: number;
+  entityCount: number;
+  byteSize: number; // Stored snapshot size (after compression)
+  thumbnail?: string; // Small image data URL
+}
+
+export type SceneSortKey = 'name' | 'createdAt' | 'updatedAt';
+
+export interface SceneListOptions {
+  sortBy?: SceneSortKey;
+  direction?: 'asc' | 'desc';
+  offset?: number;
+  limit?: number;
+}
+
+export interface ScenePage {
+  scenes: SceneMetadata[];
+  total: number;
+}
+
+export interface SceneSaveOptions {
+  thumbnail?: string; // Keeps the previous thumbnail when omitted
+}
+
+/**
+ * Stored scene payload - the scene itself is a binary payload (BinarySceneFormat), gzipped where supported
+ * Scenes saved before the binary format keep their SerializedScene as JSON
+ */
+type StoredScenePayload =
+  | { id: string; format: 'binary'; payload: ArrayBuffer; compression?: CompressionFormat }
+  | { id: string; format: 'json'; scene: SerializedScene };
+
+/**
+ * Per-entity delta record - a changed entity, or a tombstone for a removed one
+ * Applied on top of the scene snapshot when loading, until the next full save compacts them
+ */
+interface StoredEntityRecord {
+  sceneId: string;
+  entityId: string;
+  updatedAt: number;
+  deleted: boolean;
+  entity?: SerializedEntity;
+}
+
+/**
+ * Changes to write with saveSceneDelta
+ */
+export interface SceneDelta {
+  changed: SerializedEntity[];
+  removed: string[]; // Entity IDs
+  entityCount?: number; // Scene entity count after the change (for the metadata record)
+}
 
 /**
  * SceneStorage - Handles saving/loading scenes to/from IndexedDB
+ * Metadata and payloads live in separate stores, so listing scenes never touches entity data.
+ * A full save writes a snapshot; saveSceneDelta only writes changed entities (see StoredEntityRecord)
  */
 export class SceneStorage {
   private db: IDBDatabase | null = null;
@@ -29,27 +99,57 @@ export class SceneStorage {
 
       request.onupgradeneeded = (event) => {
         const db = (event.target as IDBOpenDBRequest).result;
-        if (!db.objectStoreNames.contains(STORE_NAME)) {
-          const objectStore = db.createObjectStore(STORE_NAME, { keyPath: 'id' });
-          objectStore.createIndex('name', 'name', { unique: false });
-          objectStore.createIndex('createdAt', 'createdAt', { unique: false });
+        const transaction = (event.target as IDBOpenDBRequest).transaction!;
+        const store = db.objectStoreNames.contains(STORE_NAME)
+          ? transaction.objectStore(STORE_NAME)
+          : db.createObjectStore(STORE_NAME, { keyPath: 'id' });
+        if (!store.indexNames.contains('name')) store.createIndex('name', 'name', { unique: false });
+        if (!store.indexNames.contains('createdAt')) store.createIndex('createdAt', 'createdAt', { unique: false });
+        if (!store.indexNames.contains('updatedAt')) store.createIndex('updatedAt', 'updatedAt', { unique: false });
+        if (!db.objectStoreNames.contains(PAYLOAD_STORE_NAME)) {
+          db.createObjectStore(PAYLOAD_STORE_NAME, { keyPath: 'id' });
+        }
+        if (!db.objectStoreNames.contains(ENTITY_STORE_NAME)) {
+          db.createObjectStore(ENTITY_STORE_NAME, { keyPath: ['sceneId', 'entityId'] });
+        }
+        if (!db.objectStoreNames.contains(SAVE_GAME_STORE_NAME)) {
+          db.createObjectStore(SAVE_GAME_STORE_NAME, { keyPath: 'slot' });
+        }
+        if (event.oldVersion > 0 && event.oldVersion < 3) {
+          migrateScenePayloads(store, transaction.objectStore(PAYLOAD_STORE_NAME));
         }
       };
     });
   }
 
   /**
-   * Save scene to IndexedDB
+   * Save a full scene snapshot to IndexedDB (replaces and compacts any deltas of that scene)
    */
-  async saveScene(sceneData: SerializedScene, id?: string): Promise<string> {
+  async saveScene(sceneData: SerializedScene, id?: string, options: SceneSaveOptions = {}): Promise<string> {
     if (!this.db) {
       await this.initialize();
     }
 
-    const sceneWithId = {
-      ...sceneData,
-      id: id || `scene_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`,
+    // A single ArrayBuffer is much cheaper to structured-clone into IndexedDB than the object graph
+    // (compressed off the main thread by the browser's CompressionStream)
+    const compressed = await compressBytes(BinarySceneEncoder.encode(sceneData));
+    const encoded = compressed.bytes;
+    const sceneId = id || `scene_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
+    const payload: StoredScenePayload = {
+      id: sceneId,
+      format: 'binary',
+      payload: encoded.buffer.slice(encoded.byteOffset, encoded.byteOffset + encoded.byteLength) as ArrayBuffer,
+      ...(compressed.format ? { compression: compressed.format } : {}),
+    };
+    const metadata: SceneMetadata = {
+      id: sceneId,
+      name: sceneData.metadata.name,
+      author: sceneData.metadata.author,
+      createdAt: sceneData.metadata.createdAt,
       updatedAt: Date.now(),
+      entityCount: sceneData.entities.length,
+      byteSize: encoded.byteLength,
+      thumbnail: options.thumbnail,
     };
 
     return new Promise((resolve, reject) => {
@@ -58,20 +158,80 @@ export class SceneStorage {
         return;
       }
 
-      const transaction = this.db.transaction([STORE_NAME], 'readwrite');
-      const store = transaction.objectStore(STORE_NAME);
-      const request = store.put(sceneWithId);
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME, PAYLOAD_STORE_NAME, ENTITY_STORE_NAME], 'readwrite'));
+      const metadataStore = transaction.objectStore(STORE_NAME);
+      transaction.objectStore(PAYLOAD_STORE_NAME).put(payload);
+      transaction.objectStore(ENTITY_STORE_NAME).delete(sceneEntityRange(sceneId));
+
+      // Overwriting keeps the original creation time and thumbnail unless new ones are given
+      const existingRequest = metadataStore.get(sceneId);
+      existingRequest.onsuccess = () => {
+        const existing: SceneMetadata | undefined = existingRequest.result;
+        if (existing) {
+          metadata.createdAt = existing.createdAt;
+          metadata.thumbnail = options.thumbnail ?? existing.thumbnail;
+        }
+        metadataStore.put(metadata);
+      };
 
-      request.onsuccess = () => {
-        resolve(sceneWithId.id);
+      transaction.oncomplete = () => {
+        resolve(sceneId);
       };
 
-      request.onerror = () => {
+      transaction.onerror = () => {
         reject(new Error('Failed to save scene'));
       };
     });
   }
 
+  /**
+   * Write only changed/removed entities of an already saved scene
+   * Much cheaper than saveScene for small edits; compact with a full saveScene from time to time
+   */
+  async saveSceneDelta(id: string, delta: SceneDelta): Promise<void> {
+    if (!this.db) {
+      await this.initialize();
+    }
+
+    return new Promise((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      const now = Date.now();
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME, ENTITY_STORE_NAME], 'readwrite'));
+      const store = transaction.objectStore(ENTITY_STORE_NAME);
+      delta.changed.forEach((entity) => {
+        const record: StoredEntityRecord = { sceneId: id, entityId: entity.id, updatedAt: now, deleted: false, entity };
+        store.put(record);
+      });
+      delta.removed.forEach((entityId) => {
+        const record: StoredEntityRecord = { sceneId: id, entityId, updatedAt: now, deleted: true };
+        store.put(record);
+      });
+
+      // Metadata records are small, so keeping them current is cheap
+      const metadataStore = transaction.objectStore(STORE_NAME);
+      const metadataRequest = metadataStore.get(id);
+      metadataRequest.onsuccess = () => {
+        const metadata: SceneMetadata | undefined = metadataRequest.result;
+        if (!metadata) return;
+        metadata.updatedAt = now;
+        if (delta.entityCount !== undefined) metadata.entityCount = delta.entityCount;
+        metadataStore.put(metadata);
+      };
+
+      transaction.oncomplete = () => {
+        resolve();
+      };
+
+      transaction.onerror = () => {
+        reject(new Error('Failed to save scene delta'));
+      };
+    });
+  }
+
   /**
    * Load scene from IndexedDB
    */
@@ -80,30 +240,135 @@ export class SceneStorage {
       await this.initialize();
     }
 
+    // Snapshot and deltas are read in one transaction, so they are consistent
+    const { record, deltas } = await new Promise<{ record?: StoredScenePayload; deltas: StoredEntityRecord[] }>((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      const transaction = trackTransaction(this.db.transaction([PAYLOAD_STORE_NAME, ENTITY_STORE_NAME], 'readonly'));
+      const payloadRequest = transaction.objectStore(PAYLOAD_STORE_NAME).get(id);
+      const deltaRequest = transaction.objectStore(ENTITY_STORE_NAME).getAll(sceneEntityRange(id));
+
+      transaction.oncomplete = () => {
+        resolve({ record: payloadRequest.result, deltas: deltaRequest.result });
+      };
+
+      transaction.onerror = () => {
+        reject(new Error('Failed to load scene'));
+      };
+    });
+
+    if (!record) {
+      return null;
+    }
+
+    try {
+      let snapshot: SerializedScene;
+      if (record.format === 'binary') {
+        const bytes = await decompressBytes(new Uint8Array(record.payload), record.compression);
+        snapshot = BinarySceneDecoder.decode(bytes);
+      } else {
+        snapshot = record.scene;
+      }
+      return applySceneDeltas(snapshot, deltas);
+    } catch (error) {
+      throw new Error(`Failed to decode scene: ${error instanceof Error ? error.message : String(error)}`);
+    }
+  }
+
+  /**
+   * List all saved scenes (metadata only)
+   */
+  async listScenes(): Promise<SceneMetadata[]> {
+    const page = await this.listScenePage({ sortBy: 'updatedAt', direction: 'desc' });
+    return page.scenes;
+  }
+
+  /**
+   * List one page of scene metadata, sorted through the metadata store indexes
+   */
+  async listScenePage(options: SceneListOptions = {}): Promise<ScenePage> {
+    if (!this.db) {
+      await this.initialize();
+    }
+
+    const sortBy = options.sortBy || 'updatedAt';
+    const direction: IDBCursorDirection = (options.direction || (sortBy === 'name' ? 'asc' : 'desc')) === 'asc' ? 'next' : 'prev';
+    const offset = Math.max(0, options.offset || 0);
+    const limit = options.limit ?? Infinity;
+
     return new Promise((resolve, reject) => {
       if (!this.db) {
         reject(new Error('Database not initialized'));
         return;
       }
 
-      const transaction = this.db.transaction([STORE_NAME], 'readonly');
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME], 'readonly'));
       const store = transaction.objectStore(STORE_NAME);
-      const request = store.get(id);
+      const scenes: SceneMetadata[] = [];
+      let total = 0;
+
+      store.count().onsuccess = (event) => {
+        total = (event.target as IDBRequest<number>).result;
+      };
+
+      const cursorRequest = store.index(sortBy).openCursor(null, direction);
+      let skipped = offset === 0;
+      cursorRequest.onsuccess = () => {
+        const cursor = cursorRequest.result;
+        if (!cursor || scenes.length >= limit) return;
+        if (!skipped) {
+          skipped = true;
+          cursor.advance(offset);
+          return;
+        }
+        scenes.push(cursor.value);
+        cursor.continue();
+      };
+
+      transaction.oncomplete = () => {
+        resolve({ scenes, total });
+      };
+
+      transaction.onerror = () => {
+        reject(new Error('Failed to list scenes'));
+      };
+    });
+  }
+
+  /**
+   * Get metadata of one scene
+   */
+  async getSceneMetadata(id: string): Promise<SceneMetadata | null> {
+    if (!this.db) {
+      await this.initialize();
+    }
+
+    return new Promise((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME], 'readonly'));
+      const request = transaction.objectStore(STORE_NAME).get(id);
 
       request.onsuccess = () => {
         resolve(request.result || null);
       };
 
       request.onerror = () => {
-        reject(new Error('Failed to load scene'));
+        reject(new Error('Failed to read scene metadata'));
       };
     });
   }
 
   /**
-   * List all saved scenes
+   * Write a save game into a slot (replaces the slot)
    */
-  async listScenes(): Promise<Array<{ id: string; name: string; createdAt: number; updatedAt: number }>> {
+  async saveGame(slot: string, save: SaveGame): Promise<void> {
     if (!this.db) {
       await this.initialize();
     }
@@ -114,22 +379,43 @@ export class SceneStorage {
         return;
       }
 
-      const transaction = this.db.transaction([STORE_NAME], 'readonly');
-      const store = transaction.objectStore(STORE_NAME);
-      const request = store.getAll();
+      // Typed arrays are structured-cloned as-is, so the packed state stays compact
+      const transaction = trackTransaction(this.db.transaction([SAVE_GAME_STORE_NAME], 'readwrite'));
+      transaction.objectStore(SAVE_GAME_STORE_NAME).put({ slot, save });
+
+      transaction.oncomplete = () => {
+        resolve();
+      };
+
+      transaction.onerror = () => {
+        reject(new Error('Failed to write save game'));
+      };
+    });
+  }
+
+  /**
+   * Read the save game in a slot (null if empty)
+   */
+  async loadGame(slot: string): Promise<SaveGame | null> {
+    if (!this.db) {
+      await this.initialize();
+    }
+
+    return new Promise((resolve, reject) => {
+      if (!this.db) {
+        reject(new Error('Database not initialized'));
+        return;
+      }
+
+      const transaction = trackTransaction(this.db.transaction([SAVE_GAME_STORE_NAME], 'readonly'));
+      const request = transaction.objectStore(SAVE_GAME_STORE_NAME).get(slot);
 
       request.onsuccess = () => {
-        const scenes = request.result.map((scene: any) => ({
-          id: scene.id,
-          name: scene.metadata?.name || 'Unnamed Scene',
-          createdAt: scene.metadata?.createdAt || 0,
-          updatedAt: scene.updatedAt || 0,
-        }));
-        resolve(scenes);
+        resolve(request.result?.save || null);
       };
 
       request.onerror = () => {
-        reject(new Error('Failed to list scenes'));
+        reject(new Error('Failed to read save game'));
       };
     });
   }
@@ -148,15 +434,16 @@ export class SceneStorage {
         return;
       }
 
-      const transaction = this.db.transaction([STORE_NAME], 'readwrite');
-      const store = transaction.objectStore(STORE_NAME);
-      const request = store.delete(id);
+      const transaction = trackTransaction(this.db.transaction([STORE_NAME, PAYLOAD_STORE_NAME, ENTITY_STORE_NAME], 'readwrite'));
+      transaction.objectStore(STORE_NAME).delete(id);
+      transaction.objectStore(PAYLOAD_STORE_NAME).delete(id);
+      transaction.objectStore(ENTITY_STORE_NAME).delete(sceneEntityRange(id));
 
-      request.onsuccess = () => {
+      transaction.oncomplete = () => {
         resolve();
       };
 
-      request.onerror = () => {
+      transaction.onerror = () => {
         reject(new Error('Failed to delete scene'));
       };
     });
@@ -199,6 +486,77 @@ export class SceneStorage {
   }
 }
 
+/**
+ * Version 3 upgrade: move payloads out of the scene records, leaving metadata behind
+ * Runs inside the upgrade transaction (decoding each scene once to count its entities)
+ */
+function migrateScenePayloads(metadataStore: IDBObjectStore, payloadStore: IDBObjectStore): void {
+  const cursorRequest = metadataStore.openCursor();
+  cursorRequest.onsuccess = () => {
+    const cursor = cursorRequest.result;
+    if (!cursor) return;
+    const record = cursor.value;
+
+    let scene: SerializedScene | null = null;
+    let byteSize = 0;
+    try {
+      if (record.format === 'binary') {
+        payloadStore.put({ id: record.id, format: 'binary', payload: record.payload });
+        byteSize = record.payload.byteLength;
+        scene = BinarySceneDecoder.decode(new Uint8Array(record.payload));
+      } else if (Array.isArray(record.entities)) {
+        scene = { version: record.version, entities: record.entities, metadata: record.metadata };
+        payloadStore.put({ id: record.id, format: 'json', scene });
+        byteSize = JSON.stringify(scene).length;
+      }
+    } catch (error) {
+      console.error('SceneStorage: Failed to migrate scene', record.id, error);
+    }
 
+    const metadata: SceneMetadata = {
+      id: record.id,
+      name: record.metadata?.name || record.name || 'Unnamed Scene',
+      author: record.metadata?.author,
+      createdAt: record.metadata?.createdAt || record.createdAt || 0,
+      updatedAt: record.updatedAt || record.metadata?.updatedAt || 0,
+      entityCount: scene ? scene.entities.length : 0,
+      byteSize,
+    };
+    cursor.update(metadata);
+    cursor.continue();
+  };
+}
 
+/**
+ * Key range covering all entity records of a scene
+ */
+function sceneEntityRange(sceneId: string): IDBKeyRange {
+  return IDBKeyRange.bound([sceneId, ''], [sceneId, '\uffff']);
+}
 
+/**
+ * Apply per-entity deltas to a snapshot: replace changed entities in place, append new ones, drop removed ones
+ */
+function applySceneDeltas(snapshot: SerializedScene, deltas: StoredEntityRecord[]): SerializedScene {
+  if (deltas.length === 0) return snapshot;
+
+  const byId = new Map(deltas.map(delta => [delta.entityId, delta]));
+  const entities: SerializedEntity[] = [];
+  snapshot.entities.forEach((entity) => {
+    const delta = byId.get(entity.id);
+    if (!delta) {
+      entities.push(entity);
+      return;
+    }
+    byId.delete(entity.id);
+    if (!delta.deleted && delta.entity) entities.push(delta.entity);
+  });
+  // Entities created after the snapshot, in save order
+  Array.from(byId.values())
+    .filter(delta => !delta.deleted && delta.entity)
+    .sort((a, b) => a.updatedAt - b.updatedAt)
+    .forEach(delta => entities.push(delta.entity!));
+
+  const updatedAt = deltas.reduce((latest, delta) => Math.max(latest, delta.updatedAt), snapshot.metadata.updatedAt);
+  return { ...snapshot, entities, metadata: { ...snapshot.metadata, updatedAt } };
+}
@@ -0,0 +1,48 @@
+/**
+ * Byte compression through the browser's native CompressionStream (gzip)
+ * Falls back to storing data uncompressed where the API is unavailable
+ */
+
+export type CompressionFormat = 'gzip';
+
+const MIN_COMPRESS_BYTES = 512; // Below this the gzip header outweighs the savings
+
+/**
+ * Check if native compression is available
+ */
+export function isCompressionSupported(): boolean {
+  return typeof CompressionStream !== 'undefined' && typeof DecompressionStream !== 'undefined';
+}
+
+/**
+ * Compress bytes if worthwhile
+ * Returns the compressed bytes with their format, or the input unchanged (format null)
+ */
+export async function compressBytes(
+  bytes: Uint8Array,
+  format: CompressionFormat = 'gzip'
+): Promise<{ bytes: Uint8Array; format: CompressionFormat | null }> {
+  if (!isCompressionSupported() || bytes.byteLength < MIN_COMPRESS_BYTES) {
+    return { bytes, format: null };
+  }
+
+  const stream = new Blob([bytes]).stream().pipeThrough(new CompressionStream(format));
+  const compressed = new Uint8Array(await new Response(stream).arrayBuffer());
+  // Incompressible data (already packed floats, images) can grow - keep the smaller one
+  return compressed.byteLength < bytes.byteLength
+    ? { bytes: compressed, format }
+    : { bytes, format: null };
+}
+
+/**
+ * Decompress bytes written by compressBytes (format null = stored uncompressed)
+ */
+export async function decompressBytes(bytes: Uint8Array, format: CompressionFormat | null | undefined): Promise<Uint8Array> {
+  if (!format) return bytes;
+  if (!isCompressionSupported()) {
+    throw new Error(`Cannot decompress ${format} data: DecompressionStream is not supported`);
+  }
+
+  const stream = new Blob([bytes]).stream().pipeThrough(new DecompressionStream(format));
+  return new Uint8Array(await new Response(stream).arrayBuffer());
+}
@@ -0,0 +1,17 @@
+import { Metrics } from '@/game/utils/Metrics';
+
+const readLatency = Metrics.histogram('idb.read_ms', 'IndexedDB readonly transaction time (start to complete)');
+const writeLatency = Metrics.histogram('idb.write_ms', 'IndexedDB readwrite transaction time (start to complete)');
+const failures = Metrics.counter('idb.failures', 'IndexedDB transactions that failed or aborted');
+
+/**
+ * Record an IndexedDB transaction's latency when it finishes
+ * Uses event listeners, so the caller's oncomplete/onerror handlers are unaffected
+ */
+export function trackTransaction(transaction: IDBTransaction): IDBTransaction {
+  const start = performance.now();
+  const latency = transaction.mode === 'readonly' ? readLatency : writeLatency;
+  transaction.addEventListener('complete', () => latency.record(performance.now() - start));
+  transaction.addEventListener('abort', () => failures.inc()); // Errors abort the transaction too
+  return transaction;
+}
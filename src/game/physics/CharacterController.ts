@@ -700,6 +700,27 @@ export class CharacterController {
     }
   }
 
+  /**
+   * Get vertical velocity (jumping/falling), for save games
+   */
+  getVerticalVelocity(): number {
+    return this.verticalVelocity;
+  }
+
+  /**
+   * Restore movement state from a save game (cancels climbing and dodging)
+   */
+  restoreMotion(position: THREE.Vector3, verticalVelocity: number): void {
+    this.setPosition(position);
+    this.verticalVelocity = verticalVelocity;
+    this.wantsToJump = false;
+    this.isClimbing = false;
+    this.climbableSurface = null;
+    this.isDodging = false;
+    this.dodgeVelocity.set(0, 0, 0);
+    this.dodgeTimeRemaining = 0;
+  }
+
   /**
    * Check if character is grounded
    */
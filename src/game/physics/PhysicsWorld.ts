@@ -1,6 +1,7 @@
 import RAPIER from '@dimforge/rapier3d';
 import { GAME_CONFIG } from '@/lib/constants';
-import { Debug } from '../utils/debug';
+import { Debug, LOG_TRACE } from '../utils/debug';
+import { Tracer } from '../utils/Tracer';
 
 /**
  * Manages the Rapier physics world and provides methods to create physics bodies
@@ -57,6 +58,7 @@ export class PhysicsWorld {
    * Uses fixed timestep with accumulation for smooth simulation
    */
   step(deltaTime: number): void {
+    Tracer.begin('physics.step', 'physics');
     try {
       // Accumulate time
       this.accumulator += deltaTime;
@@ -73,6 +75,7 @@ export class PhysicsWorld {
         this.accumulator -= fixedTimestep;
         steps++;
       }
+      Tracer.counter('physics.substeps', steps, 'physics');
 
       // If we hit max steps, reset accumulator to prevent spiral of death
       if (steps >= maxSteps) {
@@ -81,6 +84,8 @@ export class PhysicsWorld {
       }
     } catch (error) {
       Debug.error('PhysicsWorld', 'Error stepping physics', error as Error);
+    } finally {
+      Tracer.end('physics.step', 'physics');
     }
   }
 
@@ -120,7 +125,7 @@ export class PhysicsWorld {
       // Attach collider
       this.world.createCollider(colliderDesc, rigidBody);
 
-      Debug.log('PhysicsWorld', 'Created static body at', position);
+      if (LOG_TRACE) Debug.trace('PhysicsWorld', 'Created static body at', position);
       return rigidBody;
     } catch (error) {
       Debug.error('PhysicsWorld', 'Failed to create static body', error as Error);
@@ -173,7 +178,7 @@ export class PhysicsWorld {
       // Attach collider
       this.world.createCollider(colliderDesc, rigidBody);
 
-      Debug.log('PhysicsWorld', 'Created dynamic body at', position, 'with mass', mass);
+      if (LOG_TRACE) Debug.trace('PhysicsWorld', 'Created dynamic body at', position, 'with mass', mass);
       return rigidBody;
     } catch (error) {
       Debug.error('PhysicsWorld', 'Failed to create dynamic body', error as Error);
@@ -211,7 +216,7 @@ export class PhysicsWorld {
       // Attach collider
       this.world.createCollider(colliderDesc, rigidBody);
 
-      Debug.log('PhysicsWorld', 'Created kinematic body at', position);
+      if (LOG_TRACE) Debug.trace('PhysicsWorld', 'Created kinematic body at', position);
       return rigidBody;
     } catch (error) {
       Debug.error('PhysicsWorld', 'Failed to create kinematic body', error as Error);
@@ -225,7 +230,7 @@ export class PhysicsWorld {
   removeBody(rigidBody: RAPIER.RigidBody): void {
     try {
       this.world.removeRigidBody(rigidBody);
-      Debug.log('PhysicsWorld', 'Removed rigid body');
+      if (LOG_TRACE) Debug.trace('PhysicsWorld', 'Removed rigid body');
     } catch (error) {
       Debug.error('PhysicsWorld', 'Failed to remove rigid body', error as Error);
     }
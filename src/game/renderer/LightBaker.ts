@@ -0,0 +1,367 @@
+import * as THREE from 'three';
+import { Entity } from '../ecs/Entity';
+import { EntityManager } from '../ecs/EntityManager';
+import { TransformComponent } from '../ecs/components/TransformComponent';
+import { MeshRendererComponent, type MeshGeometry } from '../ecs/components/MeshRendererComponent';
+import { PhysicsComponent } from '../ecs/components/PhysicsComponent';
+import { LightComponent, type LightProperties } from '../ecs/components/LightComponent';
+import { SceneSerializer, type SerializedScene, type SerializedEntity, type SerializedComponent } from '../ecs/serialization/SceneSerializer';
+import { Debug } from '../utils/debug';
+
+/**
+ * Light prepared for baking (world space, linear color already scaled by intensity)
+ */
+export interface BakeLight {
+  type: LightProperties['type'];
+  r: number;
+  g: number;
+  b: number;
+  position: THREE.Vector3;
+  direction: THREE.Vector3; // Unit vector pointing TOWARDS the light (directional/spot)
+  distance: number;
+  decay: number;
+  coneCos: number;
+  penumbraCos: number;
+}
+
+export interface LightBakeOptions {
+  shadows?: boolean; // Raycast against static brushes for hard shadows (default: false)
+  shadowBias?: number; // Offset along the normal before casting shadow rays (default: 0.01)
+}
+
+export interface LightBakeResult {
+  bakedMeshes: number;
+  bakedVertices: number;
+  lightCount: number;
+  durationMs: number;
+}
+
+/**
+ * Mesh to bake: geometry in local space plus its world matrix
+ */
+interface BakeTarget {
+  geometry: THREE.BufferGeometry;
+  matrixWorld: THREE.Matrix4;
+}
+
+const DEFAULT_SHADOW_BIAS = 0.01;
+
+/**
+ * LightBaker - CPU light baking for static level geometry
+ *
+ * Computes per-vertex diffuse lighting from static LightComponents and stores it on
+ * MeshRendererComponents, which then render with an unlit MeshBasicMaterial.
+ * Uses only Three.js math (no WebGL), so it can run headless as part of a level build.
+ *
+ * The lighting model mirrors the MeshStandardMaterial diffuse term (Lambert BRDF,
+ * physically based light units, same distance/spot attenuation as the Three.js shaders),
+ * so baked walls match their dynamically lit look.
+ */
+export class LightBaker {
+  private static raycaster = new THREE.Raycaster();
+  private static occluderMaterial = new THREE.MeshBasicMaterial({ side: THREE.DoubleSide });
+
+  /**
+   * Check if an entity is a static brush (candidate for baking)
+   * Brushes are tagged 'brush'; other meshes qualify when their physics body is static
+   */
+  static isStaticBrush(entityManager: EntityManager, entity: Entity): boolean {
+    if (!entity.active) return false;
+    if (entityManager.hasComponent(entity, 'TriggerComponent')) return false;
+
+    const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent');
+    const mesh = meshRenderer?.getMesh();
+    if (!meshRenderer || !mesh || mesh.userData.isTrigger) return false;
+
+    if (entity.hasTag('brush')) return true;
+    const physics = entityManager.getComponent<PhysicsComponent>(entity, 'PhysicsComponent');
+    return physics?.properties.bodyType === 'static';
+  }
+
+  /**
+   * Bake lighting into all static brushes of a live scene
+   */
+  static bakeEntities(entityManager: EntityManager, options: LightBakeOptions = {}): LightBakeResult {
+    const startTime = performance.now();
+    const lights: BakeLight[] = [];
+    const brushes: Array<{ meshRenderer: MeshRendererComponent; target: BakeTarget }> = [];
+
+    entityManager.getAllEntities().forEach((entity) => {
+      if (!entity.active) return;
+      const transform = entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+      if (!transform) return;
+
+      const light = entityManager.getComponent<LightComponent>(entity, 'LightComponent');
+      if (light && light.enabled && light.properties.isStatic !== false) {
+        lights.push(this.createBakeLight(light.properties, transform.position, transform.rotation));
+      }
+
+      if (this.isStaticBrush(entityManager, entity)) {
+        const meshRenderer = entityManager.getComponent<MeshRendererComponent>(entity, 'MeshRendererComponent')!;
+        brushes.push({
+          meshRenderer,
+          target: {
+            geometry: meshRenderer.getMesh()!.geometry,
+            matrixWorld: this.composeMatrix(transform.position, transform.rotation, transform.scale),
+          },
+        });
+      }
+    });
+
+    const occluders = options.shadows ? this.createOccluders(brushes.map(b => b.target)) : [];
+    let bakedVertices = 0;
+
+    brushes.forEach(({ meshRenderer, target }) => {
+      const colors = this.computeVertexLighting(target, lights, occluders, options);
+      meshRenderer.applyBakedLighting(colors);
+      bakedVertices += colors.length / 3;
+    });
+
+    const result: LightBakeResult = {
+      bakedMeshes: brushes.length,
+      bakedVertices,
+      lightCount: lights.length,
+      durationMs: performance.now() - startTime,
+    };
+    Debug.log('LightBaker', `Baked ${result.bakedMeshes} brushes (${result.bakedVertices} vertices, ${result.lightCount} lights) in ${result.durationMs.toFixed(1)}ms`);
+    return result;
+  }
+
+  /**
+   * Bake lighting directly into a serialized scene (headless level build)
+   * Writes `bakedLighting` into the MeshRendererComponent data of every static brush
+   * (an override for prefab instances whose mesh comes from the prefab)
+   */
+  static bakeSerializedScene(serialized: SerializedScene, options: LightBakeOptions = {}): LightBakeResult {
+    const startTime = performance.now();
+    const lights: BakeLight[] = [];
+    const brushes: Array<{ serializedEntity: SerializedEntity; meshData: any; target: BakeTarget }> = [];
+
+    serialized.entities.forEach((serializedEntity) => {
+      if (!serializedEntity.active) return;
+      // Prefab instances only store their overrides
+      const components = SceneSerializer.resolveComponents(serializedEntity);
+      const transformData = this.findComponentData(components, 'TransformComponent');
+      if (!transformData) return;
+
+      const position = new THREE.Vector3(transformData.position?.x || 0, transformData.position?.y || 0, transformData.position?.z || 0);
+      const rotation = new THREE.Euler(
+        (transformData.rotation?.x || 0) * (Math.PI / 180),
+        (transformData.rotation?.y || 0) * (Math.PI / 180),
+        (transformData.rotation?.z || 0) * (Math.PI / 180)
+      );
+      const scale = new THREE.Vector3(transformData.scale?.x ?? 1, transformData.scale?.y ?? 1, transformData.scale?.z ?? 1);
+
+      const lightData = this.findComponentData(components, 'LightComponent');
+      if (lightData?.properties && lightData.enabled !== false && lightData.properties.isStatic !== false) {
+        lights.push(this.createBakeLight(lightData.properties, position, rotation));
+      }
+
+      const meshData = this.findComponentData(components, 'MeshRendererComponent');
+      if (meshData?.geometry && this.isStaticBrushData(serializedEntity, components)) {
+        brushes.push({
+          serializedEntity,
+          meshData,
+          target: {
+            geometry: MeshRendererComponent.createGeometry(meshData.geometry as MeshGeometry),
+            matrixWorld: this.composeMatrix(position, rotation, scale),
+          },
+        });
+      }
+    });
+
+    const occluders = options.shadows ? this.createOccluders(brushes.map(b => b.target)) : [];
+    let bakedVertices = 0;
+
+    brushes.forEach(({ serializedEntity, meshData, target }) => {
+      const colors = this.computeVertexLighting(target, lights, occluders, options);
+      this.writeBakedLighting(serializedEntity, meshData, Array.from(colors, v => Math.round(v * 1000) / 1000));
+      bakedVertices += colors.length / 3;
+      target.geometry.dispose();
+    });
+
+    return {
+      bakedMeshes: brushes.length,
+      bakedVertices,
+      lightCount: lights.length,
+      durationMs: performance.now() - startTime,
+    };
+  }
+
+  /**
+   * Compute per-vertex irradiance for one mesh
+   * Output is linear RGB already multiplied by the Lambert BRDF (1/PI), ready for vertex colors
+   */
+  static computeVertexLighting(
+    target: BakeTarget,
+    lights: BakeLight[],
+    occluders: THREE.Object3D[] = [],
+    options: LightBakeOptions = {}
+  ): Float32Array {
+    const geometry = target.geometry;
+    const position = geometry.getAttribute('position');
+    if (!geometry.getAttribute('normal')) {
+      geometry.computeVertexNormals();
+    }
+    const normal = geometry.getAttribute('normal');
+    const normalMatrix = new THREE.Matrix3().getNormalMatrix(target.matrixWorld);
+    const shadowBias = options.shadowBias ?? DEFAULT_SHADOW_BIAS;
+
+    const colors = new Float32Array(position.count * 3);
+    const p = new THREE.Vector3();
+    const n = new THREE.Vector3();
+    const toLight = new THREE.Vector3();
+
+    for (let i = 0; i < position.count; i++) {
+      p.fromBufferAttribute(position, i).applyMatrix4(target.matrixWorld);
+      n.fromBufferAttribute(normal, i).applyMatrix3(normalMatrix).normalize();
+
+      let r = 0;
+      let g = 0;
+      let b = 0;
+
+      for (const light of lights) {
+        if (light.type === 'ambient') {
+          r += light.r;
+          g += light.g;
+          b += light.b;
+          continue;
+        }
+
+        let attenuation = 1;
+        let lightDistance = Infinity;
+
+        if (light.type === 'directional') {
+          toLight.copy(light.direction);
+        } else {
+          toLight.subVectors(light.position, p);
+          lightDistance = toLight.length();
+          if (lightDistance === 0) continue;
+          toLight.divideScalar(lightDistance);
+          attenuation = this.getDistanceAttenuation(lightDistance, light.distance, light.decay);
+
+          if (light.type === 'spot') {
+            attenuation *= THREE.MathUtils.smoothstep(toLight.dot(light.direction), light.coneCos, light.penumbraCos);
+          }
+        }
+
+        const dotNL = n.dot(toLight);
+        if (dotNL <= 0 || attenuation <= 0) continue;
+
+        if (occluders.length > 0 && this.isOccluded(p, n, toLight, lightDistance, shadowBias, occluders)) {
+          continue;
+        }
+
+        const irradiance = dotNL * attenuation;
+        r += light.r * irradiance;
+        g += light.g * irradiance;
+        b += light.b * irradiance;
+      }
+
+      colors[i * 3] = r / Math.PI;
+      colors[i * 3 + 1] = g / Math.PI;
+      colors[i * 3 + 2] = b / Math.PI;
+    }
+
+    return colors;
+  }
+
+  /**
+   * Convert light properties + transform into a bake light
+   * Matches LightComponent.createLight defaults and LightComponent.updateTransform targeting
+   */
+  static createBakeLight(properties: LightProperties, position: THREE.Vector3, rotation: THREE.Euler): BakeLight {
+    const color = new THREE.Color(properties.color); // Converted to linear working space
+    // LightComponent aims directional/spot lights along -Z rotated by the entity rotation
+    const direction = new THREE.Vector3(0, 0, 1).applyEuler(rotation).normalize();
+    const angle = properties.angle || Math.PI / 3;
+    const penumbra = properties.penumbra || 0;
+
+    return {
+      type: properties.type,
+      r: color.r * properties.intensity,
+      g: color.g * properties.intensity,
+      b: color.b * properties.intensity,
+      position: position.clone(),
+      direction,
+      distance: properties.distance || 0,
+      decay: properties.decay || 2,
+      coneCos: Math.cos(angle),
+      penumbraCos: Math.cos(angle * (1 - penumbra)),
+    };
+  }
+
+  /**
+   * Same falloff as Three.js getDistanceAttenuation (physically based lights)
+   */
+  private static getDistanceAttenuation(lightDistance: number, cutoffDistance: number, decay: number): number {
+    let falloff = 1.0 / Math.max(Math.pow(lightDistance, decay), 0.01);
+    if (cutoffDistance > 0) {
+      const ratio = THREE.MathUtils.clamp(1.0 - Math.pow(lightDistance / cutoffDistance, 4), 0, 1);
+      falloff *= ratio * ratio;
+    }
+    return falloff;
+  }
+
+  /**
+   * Cast a shadow ray from a surface point towards a light
+   */
+  private static isOccluded(
+    point: THREE.Vector3,
+    normal: THREE.Vector3,
+    toLight: THREE.Vector3,
+    lightDistance: number,
+    bias: number,
+    occluders: THREE.Object3D[]
+  ): boolean {
+    const origin = point.clone().addScaledVector(normal, bias);
+    this.raycaster.set(origin, toLight);
+    this.raycaster.near = 0;
+    this.raycaster.far = lightDistance === Infinity ? Infinity : lightDistance - bias;
+    return this.raycaster.intersectObjects(occluders, false).length > 0;
+  }
+
+  /**
+   * Build double-sided proxy meshes for shadow rays (independent of render materials)
+   */
+  private static createOccluders(targets: BakeTarget[]): THREE.Mesh[] {
+    return targets.map((target) => {
+      const mesh = new THREE.Mesh(target.geometry, this.occluderMaterial);
+      mesh.matrixAutoUpdate = false;
+      mesh.matrixWorld.copy(target.matrixWorld);
+      return mesh;
+    });
+  }
+
+  private static composeMatrix(position: THREE.Vector3, rotation: THREE.Euler, scale: THREE.Vector3): THREE.Matrix4 {
+    return new THREE.Matrix4().compose(position, new THREE.Quaternion().setFromEuler(rotation), scale);
+  }
+
+  private static findComponentData(components: SerializedComponent[], type: string): any {
+    return components.find(c => c.type === type)?.data || null;
+  }
+
+  /**
+   * Store baked vertex colors on the entity: in its own mesh data, or as an override when the mesh
+   * comes from its prefab (the resolved data is a copy)
+   */
+  private static writeBakedLighting(serializedEntity: SerializedEntity, meshData: any, bakedLighting: number[]): void {
+    const own = serializedEntity.components.some(c => c.data === meshData);
+    if (own || !serializedEntity.prefab) {
+      meshData.bakedLighting = bakedLighting;
+      return;
+    }
+    const overrides = serializedEntity.prefab.overrides || (serializedEntity.prefab.overrides = {});
+    overrides.MeshRendererComponent = { ...overrides.MeshRendererComponent, bakedLighting };
+  }
+
+  /**
+   * Serialized counterpart of isStaticBrush (components resolved through the entity's prefab)
+   */
+  private static isStaticBrushData(serializedEntity: SerializedEntity, components: SerializedComponent[]): boolean {
+    if (components.some(c => c.type === 'TriggerComponent')) return false;
+    if (serializedEntity.tags.includes('brush')) return true;
+    const physicsData = this.findComponentData(components, 'PhysicsComponent');
+    return physicsData?.properties?.bodyType === 'static';
+  }
+}
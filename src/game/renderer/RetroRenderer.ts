@@ -140,6 +140,27 @@ export class RetroRenderer {
     return material;
   }
 
+  /**
+   * Precompile shader programs for all visible objects in a scene
+   * Uses compileAsync (KHR_parallel_shader_compile) when available, so programs
+   * are linked in the background instead of on the first frame that draws them
+   */
+  async precompile(scene: THREE.Scene, camera: THREE.Camera): Promise<{ newPrograms: number; durationMs: number }> {
+    const startTime = performance.now();
+    const programsBefore = this.renderer.info.programs?.length || 0;
+
+    if (typeof this.renderer.compileAsync === 'function') {
+      await this.renderer.compileAsync(scene, camera);
+    } else {
+      this.renderer.compile(scene, camera);
+    }
+
+    return {
+      newPrograms: (this.renderer.info.programs?.length || 0) - programsBefore,
+      durationMs: performance.now() - startTime,
+    };
+  }
+
   /**
    * Resize renderer
    */
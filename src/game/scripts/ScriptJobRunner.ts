@@ -0,0 +1,130 @@
+import { SCRIPT_MANIFEST } from './manifest';
+import {
+  findScriptExport,
+  isWorkerScript,
+  type EntitySnapshot,
+  type ScriptCallbackName,
+  type ScriptCommand,
+  type WorkerScript,
+  type WorkerScriptContext,
+} from './types';
+
+/**
+ * One worker script callback to run
+ */
+export interface ScriptJob {
+  scriptPath: string;
+  callback: ScriptCallbackName;
+  stateKey: string; // Script path + entity ID - selects the script's persistent state
+  context: {
+    entity: EntitySnapshot;
+    otherEntity?: EntitySnapshot;
+    entities: Record<string, EntitySnapshot>;
+    time: number;
+    deltaTime: number;
+    data?: Record<string, any>;
+  };
+}
+
+export interface ScriptJobError {
+  stateKey: string;
+  scriptPath: string;
+  entityId: string;
+  message: string;
+}
+
+/** Main thread -> worker */
+export type ScriptWorkerRequest =
+  | { type: 'run'; batch: number; generation: number; jobs: ScriptJob[] }
+  | { type: 'reset' };
+
+/** Worker -> main thread */
+export interface ScriptBatchResult {
+  type: 'result';
+  batch: number;
+  generation: number;
+  commands: ScriptCommand[];
+  errors: ScriptJobError[];
+  failure?: string; // The whole batch failed (its commands are lost; the scripts stay enabled)
+  durationMs: number;
+}
+
+/**
+ * Script Job Runner - runs batches of worker script callbacks and collects their commands
+ * Used by the script worker, and on the main thread where Web Workers are unavailable.
+ */
+export class ScriptJobRunner {
+  private scripts: Map<string, WorkerScript | string> = new Map(); // Script path -> script, or why it is unavailable
+  private state: Map<string, Record<string, any>> = new Map();
+
+  async run(jobs: ScriptJob[], batch: number, generation: number): Promise<ScriptBatchResult> {
+    const start = performance.now();
+    const commands: ScriptCommand[] = [];
+    const errors: ScriptJobError[] = [];
+    const api: WorkerScriptContext['commands'] = {
+      setEntityEnabled: (entityId, enabled) => commands.push({ type: 'setEntityEnabled', entityId, enabled }),
+      spawnPrefab: (prefabId, position) => commands.push({ type: 'spawnPrefab', prefabId, position }),
+      loadLevel: (levelId) => commands.push({ type: 'loadLevel', levelId }),
+    };
+
+    for (const job of jobs) {
+      const fail = (message: string) => errors.push({ stateKey: job.stateKey, scriptPath: job.scriptPath, entityId: job.context.entity.id, message });
+      const script = await this.load(job.scriptPath);
+      if (typeof script === 'string') {
+        fail(script);
+        continue;
+      }
+      const callback = script[job.callback];
+      if (!callback) {
+        fail(`has no ${job.callback}`);
+        continue;
+      }
+
+      let state = this.state.get(job.stateKey);
+      if (!state) {
+        state = {};
+        this.state.set(job.stateKey, state);
+      }
+      try {
+        callback({ ...job.context, state, commands: api });
+      } catch (error) {
+        fail(`${job.callback} threw: ${error instanceof Error ? error.message : String(error)}`);
+      }
+    }
+
+    return { type: 'result', batch, generation, commands, errors, durationMs: performance.now() - start };
+  }
+
+  /**
+   * Result for a batch that could not be run or sent back
+   */
+  static failedBatch(batch: number, generation: number, error: unknown): ScriptBatchResult {
+    const failure = error instanceof Error ? `${error.name}: ${error.message}` : String(error);
+    return { type: 'result', batch, generation, commands: [], errors: [], failure, durationMs: 0 };
+  }
+
+  /**
+   * Drop all script state (scene change)
+   */
+  reset(): void {
+    this.state.clear();
+  }
+
+  private async load(scriptPath: string): Promise<WorkerScript | string> {
+    const cached = this.scripts.get(scriptPath);
+    if (cached !== undefined) return cached;
+
+    let script: WorkerScript | string = 'is not in the script manifest';
+    const importer = SCRIPT_MANIFEST[scriptPath];
+    if (importer) {
+      try {
+        const found = findScriptExport(await importer());
+        script = found && isWorkerScript(found) ? found : 'is not a worker script';
+      } catch (error) {
+        script = `could not be loaded in the worker: ${error instanceof Error ? error.message : String(error)}`;
+      }
+    }
+    this.scripts.set(scriptPath, script);
+    return script;
+  }
+}
@@ -1,14 +1,18 @@
-import { IScript, ScriptModule } from './types';
+import { findScriptExport, type LoadedScript, type ScriptModule } from './types';
+import { SCRIPT_MANIFEST } from './manifest';
 import { Debug } from '../utils/debug';
+import { Tracer } from '../utils/Tracer';
 
 /**
  * Script Loader - Manages loading and caching of script files
+ * Scripts are imported through the build-time manifest (src/game/scripts/manifest.ts, one chunk per
+ * script). Concurrent loads of a script share one import; preload() fetches a scene's scripts up front.
  * Supports hot-reload in development mode
  */
 export class ScriptLoader {
-  private scriptCache: Map<string, IScript> = new Map();
+  private scriptCache: Map<string, LoadedScript> = new Map();
   private loadedModules: Map<string, any> = new Map();
-  private isLoading: Set<string> = new Set();
+  private pending: Map<string, Promise<LoadedScript | null>> = new Map(); // Loads in flight, by script path
 
   constructor() {
     // In development, set up hot reload if needed
@@ -18,59 +22,75 @@ export class ScriptLoader {
     }
   }
 
+  /**
+   * Normalize a script path to its manifest key
+   * Accepts "scripts/triggers/door", "@/game/scripts/triggers/door" or "./scripts/triggers/door.ts"
+   */
+  static normalizePath(scriptPath: string): string {
+    return scriptPath.trim().replace(/^(@\/game\/|\.\/|\/)/, '').replace(/\.tsx?$/, '');
+  }
+
+  /**
+   * Script paths available to load (from the manifest)
+   */
+  static getAvailableScripts(): string[] {
+    return Object.keys(SCRIPT_MANIFEST);
+  }
+
   /**
    * Load a script from a file path
    * Path format: "scripts/triggers/door" (relative to src/game/)
    * @param scriptPath Path to the script file (without .ts extension)
    * @returns The loaded script, or null if loading failed
    */
-  async loadScript(scriptPath: string): Promise<IScript | null> {
+  loadScript(scriptPath: string): Promise<LoadedScript | null> {
+    const path = ScriptLoader.normalizePath(scriptPath);
+
     // Check cache first
-    if (this.scriptCache.has(scriptPath)) {
-      return this.scriptCache.get(scriptPath)!;
+    const cached = this.scriptCache.get(path);
+    if (cached) {
+      return Promise.resolve(cached);
     }
 
-    // Prevent concurrent loading of the same script
-    if (this.isLoading.has(scriptPath)) {
-      Debug.warn('ScriptLoader', `Script ${scriptPath} is already loading`);
-      return null;
+    // Concurrent requests share the load in flight
+    let pending = this.pending.get(path);
+    if (!pending) {
+      pending = this.importScript(path).finally(() => this.pending.delete(path));
+      this.pending.set(path, pending);
     }
+    return pending;
+  }
+
+  /**
+   * Load scripts in parallel (e.g. every script a scene references, while the scene loads)
+   * @returns Number of scripts available
+   */
+  async preload(scriptPaths: string[]): Promise<number> {
+    const unique = Array.from(new Set(scriptPaths.map(ScriptLoader.normalizePath)));
+    if (unique.length === 0) return 0;
 
-    this.isLoading.add(scriptPath);
+    const id = Tracer.asyncBegin('scripts.preload', 'script');
+    const scripts = await Promise.all(unique.map(path => this.loadScript(path)));
+    Tracer.asyncEnd(id);
 
-    try {
-      // Construct the full import path
-      // In Next.js/TypeScript, we use dynamic imports with the path
-      const importPath = `@/game/${scriptPath}`;
-      
-      Debug.log('ScriptLoader', `Loading script: ${importPath}`);
-      
-      // Dynamic import - this will be resolved by webpack/next.js
-      const module = await import(importPath) as ScriptModule;
-      
-      // Extract the script from the module
-      let script: IScript | null = null;
-      
-      // Try default export first
-      if (module.default) {
-        script = module.default as IScript;
-      } else {
-        // Try to find a script export
-        const scriptKeys = Object.keys(module).filter(key => {
-          const value = module[key];
-          return value && typeof value === 'object' && 
-                 ('onEnter' in value || 'onExit' in value || 'onStay' in value || 'onInteract' in value || 'onUpdate' in value);
-        });
-        
-        if (scriptKeys.length > 0) {
-          script = module[scriptKeys[0]] as IScript;
-          Debug.log('ScriptLoader', `Found script in export: ${scriptKeys[0]}`);
-        }
-      }
+    const loaded = scripts.filter(script => script !== null).length;
+    Debug.log('ScriptLoader', `Preloaded ${loaded}/${unique.length} scripts`);
+    return loaded;
+  }
+
+  private async importScript(scriptPath: string): Promise<LoadedScript | null> {
+    const importer = SCRIPT_MANIFEST[scriptPath];
+    if (!importer) {
+      Debug.error('ScriptLoader', `Unknown script: ${scriptPath} (not in the script manifest - run npm run scripts:manifest after adding scripts)`);
+      return null;
+    }
 
+    try {
+      Debug.log('ScriptLoader', `Loading script: ${scriptPath}`);
+      const module: ScriptModule = await importer();
+      const script = findScriptExport(module);
       if (!script) {
         Debug.error('ScriptLoader', `No script found in module: ${scriptPath}`);
-        this.isLoading.delete(scriptPath);
         return null;
       }
 
@@ -79,12 +99,9 @@ export class ScriptLoader {
       this.loadedModules.set(scriptPath, module);
       
       Debug.log('ScriptLoader', `Script loaded successfully: ${scriptPath}`);
-      this.isLoading.delete(scriptPath);
-      
       return script;
     } catch (error) {
       Debug.error('ScriptLoader', `Failed to load script: ${scriptPath}`, error as Error);
-      this.isLoading.delete(scriptPath);
       return null;
     }
   }
@@ -92,8 +109,8 @@ export class ScriptLoader {
   /**
    * Get a cached script (doesn't load if not cached)
    */
-  getCachedScript(scriptPath: string): IScript | null {
-    return this.scriptCache.get(scriptPath) || null;
+  getCachedScript(scriptPath: string): LoadedScript | null {
+    return this.scriptCache.get(ScriptLoader.normalizePath(scriptPath)) || null;
   }
 
   /**
@@ -101,8 +118,9 @@ export class ScriptLoader {
    */
   clearCache(scriptPath?: string): void {
     if (scriptPath) {
-      this.scriptCache.delete(scriptPath);
-      this.loadedModules.delete(scriptPath);
+      const path = ScriptLoader.normalizePath(scriptPath);
+      this.scriptCache.delete(path);
+      this.loadedModules.delete(path);
       Debug.log('ScriptLoader', `Cleared cache for script: ${scriptPath}`);
     } else {
       this.scriptCache.clear();
@@ -114,7 +132,7 @@ export class ScriptLoader {
   /**
    * Reload a script (clear cache and reload)
    */
-  async reloadScript(scriptPath: string): Promise<IScript | null> {
+  async reloadScript(scriptPath: string): Promise<LoadedScript | null> {
     this.clearCache(scriptPath);
     return this.loadScript(scriptPath);
   }
@@ -123,6 +141,6 @@ export class ScriptLoader {
    * Check if a script is cached
    */
   isCached(scriptPath: string): boolean {
-    return this.scriptCache.has(scriptPath);
+    return this.scriptCache.has(ScriptLoader.normalizePath(scriptPath));
   }
 }
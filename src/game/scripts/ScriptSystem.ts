@@ -0,0 +1,275 @@
+import { EntityManager } from '../ecs/EntityManager';
+import { ScriptComponent } from '../ecs/components/ScriptComponent';
+import { SceneSerializer, type SerializedScene } from '../ecs/serialization/SceneSerializer';
+import { ScriptLoader } from './ScriptLoader';
+import { ScriptWorkerHost } from './ScriptWorkerHost';
+import { GameApi, LoadedScript, ScriptContext, WorkerScript, isWorkerScript } from './types';
+import { Debug } from '../utils/debug';
+import { Metrics } from '../utils/Metrics';
+import { Tracer } from '../utils/Tracer';
+
+export interface ScriptSystemOptions {
+  frameBudgetMs?: number; // Total onUpdate time per frame before the remaining scripts wait a frame
+  scriptBudgetMs?: number; // Default per-script onUpdate budget (ScriptProperties.budgetMs overrides)
+  worker?: ScriptWorkerHost; // Runs WorkerScripts; synced at the end of each update
+  game?: GameApi; // context.game of every script
+}
+
+export interface ScriptProfile {
+  scriptPath: string;
+  calls: number;
+  totalMs: number;
+  maxMs: number;
+  overBudget: number; // Calls that exceeded the script's budget
+  deferred: number; // Frames a component of this script waited for the frame budget
+  errors: number;
+}
+
+const DEFAULT_FRAME_BUDGET_MS = 4;
+const DEFAULT_SCRIPT_BUDGET_MS = 1;
+const LOAD_RETRY_S = 5; // Failed script loads are retried after this long
+
+const passTime = Metrics.histogram('scripts.frame_ms', 'Time spent in script onUpdate per frame');
+const updateCount = Metrics.counter('scripts.updates', 'Script onUpdate calls');
+const deferredCount = Metrics.counter('scripts.deferred', 'Script updates pushed to the next frame by the frame budget');
+const overBudgetCount = Metrics.counter('scripts.over_budget', 'Script updates that exceeded their budget');
+
+/**
+ * Script System - runs ScriptComponent scripts every frame
+ * Calls onUpdate with the time since that component's previous update. Scripts share a per-frame
+ * budget: once it is spent, the remaining components wait for the next frame and run first then
+ * (with the longer delta). A script that overran its own budget is scheduled after the others,
+ * so one slow script delays only itself. Scripts load in the background (see preload) - a
+ * component is skipped until its script is available. Worker scripts are not run here: their
+ * onUpdate calls go to the ScriptWorkerHost, which is synced once per update.
+ */
+export class ScriptSystem {
+  private entityManager: EntityManager;
+  private scriptLoader: ScriptLoader;
+  private frameBudgetMs: number;
+  private scriptBudgetMs: number;
+  private worker: ScriptWorkerHost | null;
+  private game: GameApi | null;
+
+  private time = 0; // Sum of frame deltas (seconds)
+  private frame = 0;
+  private deferred: ScriptComponent[] = [];
+  private slow: ScriptComponent[] = []; // Over budget last time - run after the others (reused each frame)
+  private loading: Set<string> = new Set(); // Script paths awaited by resolveScript
+  private failedLoads: Map<string, number> = new Map(); // Script path -> clock time of the failure
+  private profiles: Map<string, ScriptProfile> = new Map();
+
+  constructor(entityManager: EntityManager, scriptLoader: ScriptLoader, options: ScriptSystemOptions = {}) {
+    this.entityManager = entityManager;
+    this.scriptLoader = scriptLoader;
+    this.frameBudgetMs = options.frameBudgetMs ?? DEFAULT_FRAME_BUDGET_MS;
+    this.scriptBudgetMs = options.scriptBudgetMs ?? DEFAULT_SCRIPT_BUDGET_MS;
+    this.worker = options.worker || null;
+    this.game = options.game || null;
+  }
+
+  /**
+   * Run one frame of script updates
+   */
+  update(deltaTime: number): void {
+    this.time += deltaTime;
+    this.frame++;
+    const start = performance.now();
+    const deadline = start + this.frameBudgetMs;
+    const components = this.entityManager.getScriptComponents();
+
+    Tracer.begin('scripts.update', 'script');
+    let ran = 0;
+    // Components that waited last frame go first
+    const waiting = this.deferred;
+    this.deferred = [];
+    waiting.forEach((component) => {
+      if (components.has(component)) ran += this.runOrDefer(component, deltaTime, deadline, ran);
+    });
+
+    this.slow.length = 0;
+    components.forEach((component) => {
+      if (component.lastRunFrame === this.frame || component.deferredFrame === this.frame) return;
+      if (component.overBudget) {
+        this.slow.push(component);
+        return;
+      }
+      ran += this.runOrDefer(component, deltaTime, deadline, ran);
+    });
+    this.slow.forEach((component) => {
+      ran += this.runOrDefer(component, deltaTime, deadline, ran);
+    });
+    Tracer.end('scripts.update', 'script');
+
+    if (ran > 0) passTime.record(performance.now() - start);
+    this.worker?.sync();
+  }
+
+  /**
+   * Load scripts ahead of use (e.g. every script a scene references, before it starts)
+   * @returns Number of scripts available
+   */
+  preload(scriptPaths: string[]): Promise<number> {
+    return this.scriptLoader.preload(scriptPaths);
+  }
+
+  /**
+   * Script paths referenced by a serialized scene (script components and trigger scripts)
+   */
+  static collectScriptPaths(serialized: SerializedScene): string[] {
+    const paths = new Set<string>();
+    serialized.entities.forEach((entity) => {
+      SceneSerializer.resolveComponents(entity).forEach((component) => {
+        const properties = component.data?.properties;
+        if (component.type === 'ScriptComponent' && properties?.scriptPath) {
+          paths.add(properties.scriptPath);
+        } else if (component.type === 'TriggerComponent' && properties?.action === 'script') {
+          const actionData = properties.actionData;
+          const path = actionData?.scriptPath || (actionData?.scriptName ? `scripts/triggers/${actionData.scriptName}` : null);
+          if (path) paths.add(path);
+        }
+      });
+    });
+    return Array.from(paths);
+  }
+
+  /**
+   * Per-script timings since the last reset (slowest first)
+   */
+  getProfile(): ScriptProfile[] {
+    return Array.from(this.profiles.values()).sort((a, b) => b.totalMs - a.totalMs);
+  }
+
+  resetProfile(): void {
+    this.profiles.clear();
+  }
+
+  /**
+   * Run a component's onUpdate, or defer it when the frame budget is spent
+   * (at least one script runs per frame, so a tight budget still makes progress)
+   * @returns 1 if the script ran
+   */
+  private runOrDefer(component: ScriptComponent, deltaTime: number, deadline: number, ran: number): number {
+    if (!component.enabled || !component.entity.active || component.failed) {
+      component.lastUpdateTime = null; // Resume with a one-frame delta, not the time spent disabled
+      return 0;
+    }
+
+    const script = component.script || this.resolveScript(component);
+    if (!script?.onUpdate) return 0;
+    if (isWorkerScript(script)) {
+      this.dispatchToWorker(component, script, deltaTime);
+      return 0;
+    }
+
+    const profile = this.profileFor(component.properties.scriptPath);
+    if (ran > 0 && performance.now() >= deadline) {
+      component.deferredFrame = this.frame;
+      this.deferred.push(component);
+      profile.deferred++;
+      deferredCount.inc();
+      return 0;
+    }
+
+    const context = component.context || this.createContext(component);
+    context.time = this.time;
+    context.deltaTime = component.lastUpdateTime === null ? deltaTime : this.time - component.lastUpdateTime;
+    component.lastUpdateTime = this.time;
+    component.lastRunFrame = this.frame;
+
+    const start = performance.now();
+    try {
+      script.onUpdate(context);
+    } catch (error) {
+      component.failed = true;
+      profile.errors++;
+      Debug.error('ScriptSystem', `${component.properties.scriptPath} onUpdate threw on ${component.entity.name} - disabled`, error as Error);
+    }
+    const duration = performance.now() - start;
+
+    profile.calls++;
+    profile.totalMs += duration;
+    if (duration > profile.maxMs) profile.maxMs = duration;
+    updateCount.inc();
+
+    const budget = component.properties.budgetMs ?? this.scriptBudgetMs;
+    component.overBudget = duration > budget;
+    if (component.overBudget) {
+      if (profile.overBudget === 0) {
+        Debug.warn('ScriptSystem', `${component.properties.scriptPath} onUpdate took ${duration.toFixed(2)}ms (budget ${budget}ms) - scheduled after other scripts`);
+      }
+      profile.overBudget++;
+      overBudgetCount.inc();
+      Tracer.complete(`script ${component.properties.scriptPath} (over budget)`, 'script', start, duration);
+    }
+    return 1;
+  }
+
+  /**
+   * Attach a loaded script, or start loading it (the component is skipped until it is ready)
+   */
+  private resolveScript(component: ScriptComponent): LoadedScript | null {
+    const path = component.properties.scriptPath;
+    if (!path) return null;
+    const failedAt = this.failedLoads.get(path);
+    if (failedAt !== undefined && this.time - failedAt < LOAD_RETRY_S) return null;
+
+    const cached = this.scriptLoader.getCachedScript(path);
+    if (cached) {
+      component.script = cached;
+      return cached;
+    }
+    if (this.loading.has(path)) return null;
+
+    this.loading.add(path);
+    this.scriptLoader.loadScript(path).then((script) => {
+      this.loading.delete(path);
+      if (script) {
+        this.failedLoads.delete(path);
+        return;
+      }
+      if (!this.failedLoads.has(path)) {
+        Debug.warn('ScriptSystem', `Script ${path} could not be loaded - its components are skipped (retried every ${LOAD_RETRY_S}s)`);
+      }
+      this.failedLoads.set(path, this.time);
+    });
+    return null;
+  }
+
+  private dispatchToWorker(component: ScriptComponent, script: WorkerScript, deltaTime: number): void {
+    const path = component.properties.scriptPath;
+    if (!this.worker) {
+      component.failed = true;
+      Debug.error('ScriptSystem', `${path} is a worker script but no script worker is configured - disabled`);
+      return;
+    }
+    const time = this.time;
+    this.worker.dispatch(path, script, 'onUpdate', component.entity, {
+      time,
+      deltaTime: component.lastUpdateTime === null ? deltaTime : time - component.lastUpdateTime,
+      data: component.properties.data,
+    });
+    component.lastUpdateTime = time;
+    component.lastRunFrame = this.frame;
+  }
+
+  private createContext(component: ScriptComponent): ScriptContext {
+    component.context = {
+      entity: component.entity,
+      time: this.time,
+      deltaTime: 0,
+      data: component.properties.data,
+      game: this.game || undefined,
+    };
+    return component.context;
+  }
+
+  private profileFor(scriptPath: string): ScriptProfile {
+    let profile = this.profiles.get(scriptPath);
+    if (!profile) {
+      profile = { scriptPath, calls: 0, totalMs: 0, maxMs: 0, overBudget: 0, deferred: 0, errors: 0 };
+      this.profiles.set(scriptPath, profile);
+    }
+    return profile;
+  }
+}
@@ -0,0 +1,228 @@
+import type { Entity } from '../ecs/Entity';
+import type { EntityManager } from '../ecs/EntityManager';
+import type { TransformComponent } from '../ecs/components/TransformComponent';
+import { ScriptJobRunner, type ScriptBatchResult, type ScriptJob, type ScriptWorkerRequest } from './ScriptJobRunner';
+import { ScriptLoader } from './ScriptLoader';
+import type { EntitySnapshot, GameApi, ScriptCallbackName, ScriptCommand, WorkerScript } from './types';
+import { Debug } from '../utils/debug';
+import { Metrics } from '../utils/Metrics';
+
+/**
+ * Resolves entity IDs and applies worker script commands on the main thread
+ */
+export type ScriptCommandTarget = Pick<GameApi, 'getEntity' | 'setEntityEnabled' | 'spawnEntity' | 'loadLevel'>;
+
+export interface WorkerDispatch {
+  time: number;
+  deltaTime: number;
+  data?: Record<string, any>;
+  otherEntity?: Entity | null;
+}
+
+const batchTime = Metrics.histogram('scripts.worker_batch_ms', 'Time the script worker spent on a batch');
+const jobCount = Metrics.counter('scripts.worker_jobs', 'Worker script callbacks sent to the worker');
+const commandCount = Metrics.counter('scripts.worker_commands', 'Worker script commands applied');
+const queueGauge = Metrics.gauge('scripts.worker_queue', 'Worker script callbacks waiting for the worker');
+
+/**
+ * Script Worker Host - runs WorkerScripts in a Web Worker
+ * Callbacks are queued with a snapshot of the data they declare and sent as one batch per sync();
+ * while the worker is still busy, new callbacks wait (onUpdate calls of one script and entity are
+ * merged, with their deltas summed). The batch's commands are applied at the next sync() after it
+ * returns, so script cost never lands on the frame. Without Web Worker support (SSR, Node) batches
+ * run through the same runner on this thread.
+ */
+export class ScriptWorkerHost {
+  private entityManager: EntityManager;
+  private target: ScriptCommandTarget;
+  private worker: Worker | null = null;
+  private fallback: ScriptJobRunner | null = null;
+  private queue: ScriptJob[] = [];
+  private updates: Map<string, ScriptJob> = new Map(); // Pending onUpdate jobs, by script path and entity
+  private results: ScriptBatchResult[] = [];
+  private failed: Set<string> = new Set(); // State keys whose callbacks threw - not sent again
+  private batch = 0;
+  private generation = 0; // Bumped by reset() - results of older batches are dropped
+  private busy = false;
+
+  constructor(entityManager: EntityManager, target: ScriptCommandTarget) {
+    this.entityManager = entityManager;
+    this.target = target;
+  }
+
+  /**
+   * Queue a worker script callback (sent at the next sync)
+   */
+  dispatch(scriptPath: string, script: WorkerScript, callback: ScriptCallbackName, entity: Entity, frame: WorkerDispatch): void {
+    // The worker looks scripts up in the manifest, which only has normalized paths
+    const path = ScriptLoader.normalizePath(scriptPath);
+    const stateOwner = script.worker.stateEntity ? frame.data?.[script.worker.stateEntity] : undefined;
+    const stateKey = `${path}|${typeof stateOwner === 'string' ? stateOwner : entity.id}`;
+    if (this.failed.has(stateKey)) return;
+
+    const withPosition = !!script.worker.position;
+    const entities: Record<string, EntitySnapshot> = {};
+    script.worker.entities?.forEach((key) => {
+      const id = frame.data?.[key];
+      // Entity IDs in component data are scene IDs - the target resolves them to live entities
+      const other = typeof id === 'string' ? this.target.getEntity(id) : null;
+      if (other) entities[key] = this.snapshot(other, withPosition);
+    });
+
+    const job: ScriptJob = {
+      scriptPath: path,
+      callback,
+      stateKey,
+      context: {
+        entity: this.snapshot(entity, withPosition),
+        otherEntity: frame.otherEntity ? this.snapshot(frame.otherEntity, withPosition) : undefined,
+        entities,
+        time: frame.time,
+        deltaTime: frame.deltaTime,
+        data: frame.data,
+      },
+    };
+
+    if (callback === 'onUpdate') {
+      const updateKey = `${path}|${entity.id}`;
+      const waiting = this.updates.get(updateKey);
+      if (waiting) job.context.deltaTime += waiting.context.deltaTime;
+      this.updates.set(updateKey, job);
+    } else {
+      this.queue.push(job);
+    }
+  }
+
+  /**
+   * Sync point (once per frame): apply the commands of finished batches, then send queued callbacks
+   */
+  sync(): void {
+    const results = this.results;
+    this.results = [];
+    results.forEach(result => this.apply(result));
+
+    queueGauge.set(this.queue.length + this.updates.size);
+    if (this.busy || (this.queue.length === 0 && this.updates.size === 0)) return;
+
+    const jobs = this.queue;
+    this.updates.forEach(job => jobs.push(job));
+    this.queue = [];
+    this.updates.clear();
+    this.send(jobs);
+  }
+
+  /**
+   * Drop queued callbacks, pending results and script state (scene change)
+   */
+  reset(): void {
+    this.generation++;
+    this.queue = [];
+    this.updates.clear();
+    this.results = [];
+    this.failed.clear();
+    if (this.worker || this.fallback) this.post({ type: 'reset' });
+  }
+
+  dispose(): void {
+    this.worker?.terminate();
+    this.worker = null;
+    this.fallback = null;
+    this.queue = [];
+    this.updates.clear();
+    this.results = [];
+  }
+
+  private send(jobs: ScriptJob[]): void {
+    this.busy = true;
+    this.batch++;
+    jobCount.inc(jobs.length);
+    try {
+      this.post({ type: 'run', batch: this.batch, generation: this.generation, jobs });
+    } catch (error) {
+      // Script data that cannot be cloned (functions, engine objects) - drop the batch
+      this.busy = false;
+      Debug.error('ScriptWorker', `Could not send ${jobs.length} script calls to the worker`, error as Error);
+    }
+  }
+
+  private post(request: ScriptWorkerRequest): void {
+    const worker = this.getWorker();
+    if (worker) {
+      worker.postMessage(request);
+      return;
+    }
+
+    const runner = this.fallback || (this.fallback = new ScriptJobRunner());
+    if (request.type === 'reset') {
+      runner.reset();
+    } else {
+      runner.run(request.jobs, request.batch, request.generation)
+        .catch(error => ScriptJobRunner.failedBatch(request.batch, request.generation, error))
+        .then(result => this.receive(result));
+    }
+  }
+
+  private getWorker(): Worker | null {
+    if (this.worker || this.fallback || typeof Worker === 'undefined') return this.worker;
+    try {
+      this.worker = new Worker(new URL('./scriptWorker.ts', import.meta.url));
+      this.worker.onmessage = (event: MessageEvent<ScriptBatchResult>) => this.receive(event.data);
+      this.worker.onerror = (event) => {
+        Debug.error('ScriptWorker', `Script worker failed (${event.message}) - running worker scripts on the main thread`);
+        this.worker?.terminate();
+        this.worker = null;
+        this.fallback = new ScriptJobRunner();
+        this.busy = false;
+      };
+    } catch (error) {
+      Debug.warn('ScriptWorker', 'Web Worker unavailable - running worker scripts on the main thread', error as Error);
+      this.fallback = new ScriptJobRunner();
+    }
+    return this.worker;
+  }
+
+  private receive(result: ScriptBatchResult): void {
+    if (result.batch === this.batch) this.busy = false;
+    if (result.generation === this.generation) this.results.push(result);
+  }
+
+  private apply(result: ScriptBatchResult): void {
+    if (result.failure) {
+      Debug.error('ScriptWorker', `Script batch ${result.batch} failed (${result.failure}) - its commands were dropped`);
+    }
+    batchTime.record(result.durationMs);
+    result.errors.forEach((error) => {
+      this.failed.add(error.stateKey);
+      Debug.error('ScriptWorker', `${error.scriptPath} on ${error.entityId} ${error.message} - disabled`);
+    });
+    result.commands.forEach(command => this.execute(command));
+    commandCount.inc(result.commands.length);
+  }
+
+  private execute(command: ScriptCommand): void {
+    try {
+      switch (command.type) {
+        case 'setEntityEnabled':
+          this.target.setEntityEnabled(command.entityId, command.enabled);
+          break;
+        case 'spawnPrefab':
+          this.target.spawnEntity(command.prefabId, command.position);
+          break;
+        case 'loadLevel':
+          this.target.loadLevel(command.levelId);
+          break;
+      }
+    } catch (error) {
+      Debug.error('ScriptWorker', `Script command ${command.type} failed`, error as Error);
+    }
+  }
+
+  private snapshot(entity: Entity, withPosition: boolean): EntitySnapshot {
+    const snapshot: EntitySnapshot = { id: entity.id, name: entity.name, active: entity.active };
+    if (withPosition) {
+      const transform = this.entityManager.getComponent<TransformComponent>(entity, 'TransformComponent');
+      if (transform) snapshot.position = transform.getPosition();
+    }
+    return snapshot;
+  }
+}
@@ -0,0 +1,12 @@
+// Generated by tools/scriptManifest.js - do not edit
+import type { ScriptModule } from './types';
+
+/**
+ * Loaders for every script module, keyed by script path (relative to src/game/)
+ */
+export const SCRIPT_MANIFEST: Record<string, () => Promise<ScriptModule>> = {
+  'scripts/triggers/door': () => import('./triggers/door'),
+  'scripts/triggers/levelTransition': () => import('./triggers/levelTransition'),
+  'scripts/triggers/plateSequence': () => import('./triggers/plateSequence'),
+  'scripts/triggers/spawn': () => import('./triggers/spawn'),
+};
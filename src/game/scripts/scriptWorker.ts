@@ -0,0 +1,38 @@
+/**
+ * Script worker entry point - runs worker script batches off the main thread (see ScriptWorkerHost)
+ */
+import { ScriptJobRunner, type ScriptBatchResult, type ScriptWorkerRequest } from './ScriptJobRunner';
+
+const scope = self as unknown as {
+  onmessage: ((event: MessageEvent<ScriptWorkerRequest>) => void) | null;
+  postMessage: (message: ScriptBatchResult) => void;
+};
+const runner = new ScriptJobRunner();
+
+// Batches run one after another, in the order they were sent
+let queue: Promise<void> = Promise.resolve();
+
+scope.onmessage = (event) => {
+  const request = event.data;
+  queue = queue.then(async () => {
+    if (request.type === 'reset') {
+      runner.reset();
+      return;
+    }
+    // Every batch gets a result - the host waits for it before sending the next one
+    let result: ScriptBatchResult;
+    try {
+      result = await runner.run(request.jobs, request.batch, request.generation);
+    } catch (error) {
+      result = ScriptJobRunner.failedBatch(request.batch, request.generation, error);
+    }
+    try {
+      scope.postMessage(result);
+    } catch (error) {
+      // Commands that cannot be cloned (DataCloneError)
+      scope.postMessage(ScriptJobRunner.failedBatch(request.batch, request.generation, error));
+    }
+  }).catch((error) => {
+    console.error('[scriptWorker] Batch failed', error);
+  });
+};
@@ -0,0 +1,37 @@
+import type { WorkerScript, WorkerScriptContext } from '@/game/scripts/types';
+
+/**
+ * Plate Sequence Trigger Script (runs in the script worker)
+ * Plates that share a gate open it when stepped on in order (step 0, 1, 2...); a wrong plate
+ * restarts the sequence. Progress is the gate's script state, so it starts over with the scene.
+ *
+ * actionData: { step: number, steps: number, gateEntityId: string }
+ */
+export const plateSequenceScript: WorkerScript = {
+  worker: {
+    entities: ['gateEntityId'],
+    stateEntity: 'gateEntityId',
+  },
+
+  onEnter: (context: WorkerScriptContext) => {
+    const gate = context.entities.gateEntityId;
+    const step = Number(context.data?.step ?? 0);
+    const steps = Number(context.data?.steps ?? 1);
+    if (!gate) return;
+
+    const expected = context.state.nextStep ?? 0;
+    if (step !== expected) {
+      context.state.nextStep = step === 0 ? 1 : 0;
+      return;
+    }
+
+    if (step + 1 >= steps) {
+      context.state.nextStep = 0;
+      context.commands.setEntityEnabled(gate.id, false);
+    } else {
+      context.state.nextStep = step + 1;
+    }
+  },
+};
+
+export default plateSequenceScript;
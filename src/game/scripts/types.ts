@@ -1,6 +1,6 @@
-import { Entity } from '@/game/ecs/Entity';
-import { TriggerComponent } from '@/game/ecs/components/TriggerComponent';
-import * as THREE from 'three';
+// Type-only imports: the script worker bundles this module and must not pull in the engine
+import type { Entity } from '@/game/ecs/Entity';
+import type { TriggerComponent } from '@/game/ecs/components/TriggerComponent';
 
 /**
  * Script Context - Provides information and APIs for script execution
@@ -32,29 +32,9 @@ export interface ScriptContext {
   deltaTime: number;
   
   /**
-   * Access to game systems (will be expanded as needed)
-   */
-  game?: {
-    /**
-     * Get entity by ID
-     */
-    getEntity: (id: string) => Entity | null;
-    
-    /**
-     * Load a level by ID
-     */
-    loadLevel?: (levelId: string) => Promise<void>;
-    
-    /**
-     * Spawn an entity from prefab
-     */
-    spawnEntity?: (prefabId: string, position: THREE.Vector3) => Entity | null;
-    
-    /**
-     * Enable/disable an entity
-     */
-    setEntityEnabled?: (entityId: string, enabled: boolean) => void;
-  };
+   * Access to game systems
+   */
+  game?: GameApi;
   
   /**
    * Custom data passed to the script (from TriggerComponent.actionData)
@@ -62,6 +42,41 @@ export interface ScriptContext {
   data?: Record<string, any>;
 }
 
+/**
+ * Game API - what scripts and trigger actions may do to the running game
+ */
+export interface GameApi {
+  /**
+   * Get entity by ID
+   */
+  getEntity: (id: string) => Entity | null;
+
+  /**
+   * Enable/disable an entity
+   */
+  setEntityEnabled: (entityId: string, enabled: boolean) => void;
+
+  /**
+   * Spawn an instance of a prefab (pooled; at the prefab's position when none is given)
+   */
+  spawnEntity: (prefabId: string, position?: { x: number; y: number; z: number }) => Entity | null;
+
+  /**
+   * Despawn an entity (prefab instances go back to the pool)
+   */
+  despawnEntity: (entityId: string) => void;
+
+  /**
+   * Start reading a level in the background (scene ID or asset URL)
+   */
+  preloadLevel: (levelId: string) => void;
+
+  /**
+   * Switch to a level (preloaded or not); resolves false if it could not be loaded
+   */
+  loadLevel: (levelId: string) => Promise<boolean>;
+}
+
 /**
  * Script Interface - All scripts must export this interface
  */
@@ -96,6 +111,91 @@ export interface IScript {
  * Script Module - Type for dynamically imported script modules
  */
 export type ScriptModule = {
-  default?: IScript;
-  [key: string]: IScript | any;
+  default?: IScript | WorkerScript;
+  [key: string]: IScript | WorkerScript | any;
 };
+
+/**
+ * Script callbacks, by name
+ */
+export type ScriptCallbackName = 'onEnter' | 'onExit' | 'onStay' | 'onInteract' | 'onUpdate';
+
+/**
+ * Command returned by a worker script, applied on the main thread at the next script sync point
+ */
+export type ScriptCommand =
+  | { type: 'setEntityEnabled'; entityId: string; enabled: boolean }
+  | { type: 'spawnPrefab'; prefabId: string; position?: { x: number; y: number; z: number } }
+  | { type: 'loadLevel'; levelId: string };
+
+/**
+ * Entity state copied into a worker script's context
+ */
+export interface EntitySnapshot {
+  id: string;
+  name: string;
+  active: boolean;
+  position?: { x: number; y: number; z: number }; // With WorkerScriptOptions.position
+}
+
+/**
+ * Worker Script Context - plain data only; the script acts through commands
+ */
+export interface WorkerScriptContext {
+  entity: EntitySnapshot;
+  otherEntity?: EntitySnapshot;
+  entities: Record<string, EntitySnapshot>; // Entities named by WorkerScriptOptions.entities, by data key
+  time: number;
+  deltaTime: number;
+  data?: Record<string, any>;
+  state: Record<string, any>; // Kept in the worker between calls (per script and entity) until the scene changes
+  commands: {
+    setEntityEnabled: (entityId: string, enabled: boolean) => void;
+    spawnPrefab: (prefabId: string, position?: { x: number; y: number; z: number }) => void;
+    loadLevel: (levelId: string) => void;
+  };
+}
+
+/**
+ * What a worker script reads from the game (everything else stays on the main thread)
+ */
+export interface WorkerScriptOptions {
+  position?: boolean; // Include entity positions
+  entities?: string[]; // Keys of context.data holding IDs of other entities to include
+  stateEntity?: string; // Key of context.data holding the entity whose context.state is used (shared state)
+}
+
+/**
+ * Worker Script - runs in the script worker instead of the game loop (expensive AI or puzzle logic)
+ * Callbacks receive a WorkerScriptContext snapshot; their commands are applied on the main thread
+ * at the next sync point, so a slow script delays its own effects but never the frame.
+ */
+export interface WorkerScript {
+  worker: WorkerScriptOptions;
+  onEnter?: (context: WorkerScriptContext) => void;
+  onExit?: (context: WorkerScriptContext) => void;
+  onStay?: (context: WorkerScriptContext) => void;
+  onInteract?: (context: WorkerScriptContext) => void;
+  onUpdate?: (context: WorkerScriptContext) => void;
+}
+
+export type LoadedScript = IScript | WorkerScript;
+
+export function isWorkerScript(script: LoadedScript): script is WorkerScript {
+  return 'worker' in script && !!script.worker;
+}
+
+/**
+ * Find the script a module exports (default export first, then the first export with callbacks)
+ */
+export function findScriptExport(module: ScriptModule): LoadedScript | null {
+  if (module.default) {
+    return module.default as LoadedScript;
+  }
+  const key = Object.keys(module).find(name => {
+    const value = module[name];
+    return value && typeof value === 'object' &&
+           ('onEnter' in value || 'onExit' in value || 'onStay' in value || 'onInteract' in value || 'onUpdate' in value);
+  });
+  return key ? module[key] as LoadedScript : null;
+}
@@ -0,0 +1,130 @@
+import { Debug } from './debug';
+
+export type ChannelListener<T> = (events: readonly T[]) => void;
+
+/**
+ * Event channel - typed events delivered to subscribers once per frame
+ * publish() only appends to the channel's pending array; the events of a frame reach each
+ * subscriber as one batch. Batches are reused buffers: listeners must not keep the array.
+ * Create shared channels with EventBus.channel(); per-instance channels with new Channel().
+ */
+export class Channel<T> {
+  public readonly name: string;
+  private listeners: Set<ChannelListener<T>> = new Set();
+  private pending: T[] = [];
+  private delivering: T[] = [];
+  private queued: boolean = false;
+
+  constructor(name: string) {
+    this.name = name;
+  }
+
+  /**
+   * Queue an event for the next delivery (dropped when nobody is subscribed)
+   */
+  publish(event: T): void {
+    if (this.listeners.size === 0) return;
+    this.pending.push(event);
+    if (!this.queued) {
+      this.queued = true;
+      EventBus.enqueue(this);
+    }
+  }
+
+  /**
+   * Receive the events of each frame as one batch
+   */
+  subscribe(listener: ChannelListener<T>): () => void {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+
+  /**
+   * Receive only the latest event of each frame (state updates)
+   */
+  subscribeLatest(listener: (event: T) => void): () => void {
+    return this.subscribe(events => listener(events[events.length - 1]));
+  }
+
+  hasSubscribers(): boolean {
+    return this.listeners.size > 0;
+  }
+
+  /**
+   * Deliver the pending batch (called by EventBus.flush)
+   */
+  deliver(): void {
+    this.queued = false;
+    // Swap buffers: events published by listeners go to the next batch
+    const events = this.pending;
+    this.pending = this.delivering;
+    this.delivering = events;
+
+    this.listeners.forEach((listener) => {
+      try {
+        listener(events);
+      } catch (error) {
+        Debug.error('EventBus', `Listener of ${this.name} failed`, error as Error);
+      }
+    });
+    events.length = 0;
+  }
+}
+
+/**
+ * Event Bus - shared channels and the once-per-frame delivery of every channel's events
+ * Replaces polling: systems publish changes, UIs and subsystems subscribe to the channels they need.
+ */
+export class EventBus {
+  private static channels: Map<string, Channel<any>> = new Map();
+  private static queue: Channel<any>[] = [];
+  private static flushing: Channel<any>[] = [];
+  private static scheduled: boolean = false;
+
+  /**
+   * Get (or create) the shared channel with this name
+   */
+  static channel<T>(name: string): Channel<T> {
+    let channel = this.channels.get(name);
+    if (!channel) {
+      channel = new Channel<T>(name);
+      this.channels.set(name, channel);
+    }
+    return channel as Channel<T>;
+  }
+
+  /**
+   * Schedule a channel with pending events for the next flush
+   */
+  static enqueue(channel: Channel<any>): void {
+    this.queue.push(channel);
+    if (!this.scheduled) {
+      this.scheduled = true;
+      this.schedule();
+    }
+  }
+
+  /**
+   * Deliver all pending events now (normally runs once per animation frame)
+   */
+  static flush(): void {
+    this.scheduled = false;
+    const channels = this.queue;
+    this.queue = this.flushing;
+    this.flushing = channels;
+    channels.forEach(channel => channel.deliver());
+    channels.length = 0;
+  }
+
+  private static schedule(): void {
+    const hidden = typeof document !== 'undefined' && document.hidden;
+    if (typeof requestAnimationFrame === 'function' && !hidden) {
+      requestAnimationFrame(() => this.flush());
+    } else {
+      // No frames (server, Node, hidden tab) - deliver soon anyway
+      setTimeout(() => this.flush(), 16);
+    }
+  }
+}
@@ -2,6 +2,7 @@
  * Event Log System
  * Tracks and manages game world events for UI display
  */
+import { Channel } from './EventBus';
 
 export enum EventType {
   SOUFFRANCE_DAMAGE = 'SOUFFRANCE_DAMAGE',
@@ -21,15 +22,13 @@ export interface GameEvent {
   data?: Record<string, any>; // Additional event data
 }
 
-type EventListener = (event: GameEvent) => void;
-
 /**
  * Event Log Manager
- * Centralized system for tracking and broadcasting game events
+ * Centralized system for tracking and broadcasting game events (delivered once per frame)
  */
 export class EventLog {
   private events: GameEvent[] = [];
-  private listeners: Set<EventListener> = new Set();
+  private channel: Channel<GameEvent> = new Channel('eventLog');
   private maxEvents: number = 20; // Keep last 20 events
 
   /**
@@ -51,8 +50,7 @@ export class EventLog {
       this.events.shift();
     }
 
-    // Notify listeners
-    this.listeners.forEach((listener) => listener(event));
+    this.channel.publish(event);
   }
 
   /**
@@ -70,14 +68,10 @@ export class EventLog {
   }
 
   /**
-   * Subscribe to new events
+   * Subscribe to new events (each frame's events as one batch, oldest first)
    */
-  subscribe(listener: EventListener): () => void {
-    this.listeners.add(listener);
-    // Return unsubscribe function
-    return () => {
-      this.listeners.delete(listener);
-    };
+  subscribe(listener: (events: readonly GameEvent[]) => void): () => void {
+    return this.channel.subscribe(listener);
   }
 
   /**
@@ -0,0 +1,307 @@
+/**
+ * Frame profiler - per-phase CPU timings (and GPU render time where supported)
+ * Samples live in a fixed-size ring buffer, so recording allocates nothing per frame
+ */
+
+export const FRAME_PHASES = ['physics', 'character', 'camera', 'sceneSync', 'ecs', 'scripts', 'render'] as const;
+export type FramePhase = typeof FRAME_PHASES[number];
+
+export const FRAME_BUDGET_MS = 1000 / 60;
+
+export interface PhaseStats {
+  avg: number;
+  p50: number;
+  p95: number;
+  p99: number;
+  max: number;
+}
+
+export interface FrameSpike {
+  frame: number; // Absolute frame number
+  totalMs: number;
+  worstPhase: FramePhase;
+  worstPhaseMs: number;
+}
+
+export interface FrameProfilerStats {
+  frameCount: number; // Frames in the window
+  budgetMs: number;
+  total: PhaseStats;
+  phases: Record<FramePhase, PhaseStats>;
+  gpu: PhaseStats | null; // Null when GPU timer queries are unsupported
+  spikes: FrameSpike[]; // Most recent first
+}
+
+/**
+ * Last N frames for the overlay graph (oldest first, one row per frame)
+ */
+export interface FrameHistory {
+  phases: FramePhase[];
+  samples: Float32Array; // frameCount * phases.length
+  gpu: Float32Array; // NaN where no GPU result is available
+  frameCount: number;
+}
+
+const PHASE_COUNT = FRAME_PHASES.length;
+const DEFAULT_CAPACITY = 600; // 10s at 60fps
+const MAX_SPIKES = 32;
+
+interface PendingGpuQuery {
+  query: WebGLQuery;
+  frame: number;
+}
+
+export class FrameProfiler {
+  private readonly capacity: number;
+  private readonly samples: Float32Array; // capacity * PHASE_COUNT, ms
+  private readonly totals: Float32Array; // Sum of phases per frame, ms
+  private readonly gpuSamples: Float32Array; // GPU render time per frame, ms (NaN = pending/unsupported)
+  private frame = 0; // Frames recorded so far
+  private phaseStart = 0;
+  private currentPhase = -1;
+  private spikes: FrameSpike[] = [];
+  private enabled = true;
+
+  // GPU timing (EXT_disjoint_timer_query_webgl2)
+  private gl: WebGL2RenderingContext | null = null;
+  private timerExt: any = null;
+  private activeQuery: PendingGpuQuery | null = null;
+  private pendingQueries: PendingGpuQuery[] = [];
+  private freeQueries: WebGLQuery[] = [];
+
+  constructor(capacity: number = DEFAULT_CAPACITY) {
+    this.capacity = capacity;
+    this.samples = new Float32Array(capacity * PHASE_COUNT);
+    this.totals = new Float32Array(capacity);
+    this.gpuSamples = new Float32Array(capacity).fill(NaN);
+  }
+
+  /**
+   * Enable GPU timer queries if the context supports them (WebGL2 only)
+   */
+  attachGpuTimer(gl: WebGLRenderingContext | WebGL2RenderingContext): boolean {
+    if (typeof WebGL2RenderingContext === 'undefined' || !(gl instanceof WebGL2RenderingContext)) {
+      return false;
+    }
+    const ext = gl.getExtension('EXT_disjoint_timer_query_webgl2');
+    if (!ext) return false;
+
+    this.gl = gl;
+    this.timerExt = ext;
+    return true;
+  }
+
+  hasGpuTimer(): boolean {
+    return this.timerExt !== null;
+  }
+
+  setEnabled(enabled: boolean): void {
+    this.enabled = enabled;
+  }
+
+  isEnabled(): boolean {
+    return this.enabled;
+  }
+
+  /**
+   * Start a new frame (clears this frame's slot)
+   */
+  beginFrame(): void {
+    if (!this.enabled) return;
+    const slot = this.frame % this.capacity;
+    this.samples.fill(0, slot * PHASE_COUNT, (slot + 1) * PHASE_COUNT);
+    this.gpuSamples[slot] = NaN;
+    this.currentPhase = -1;
+    this.collectGpuResults();
+  }
+
+  /**
+   * Start timing a phase (ends the previous one)
+   */
+  beginPhase(phase: FramePhase): void {
+    if (!this.enabled) return;
+    const now = performance.now();
+    this.closePhase(now);
+    this.currentPhase = FRAME_PHASES.indexOf(phase);
+    this.phaseStart = now;
+  }
+
+  /**
+   * Stop timing the current phase
+   */
+  endPhase(): void {
+    if (!this.enabled) return;
+    this.closePhase(performance.now());
+    this.currentPhase = -1;
+  }
+
+  /**
+   * Bracket GPU work of this frame (call around the render call)
+   */
+  beginGpu(): void {
+    if (!this.enabled || !this.gl || !this.timerExt || this.activeQuery) return;
+    const query = this.freeQueries.pop() || this.gl.createQuery();
+    if (!query) return;
+    this.gl.beginQuery(this.timerExt.TIME_ELAPSED_EXT, query);
+    this.activeQuery = { query, frame: this.frame };
+  }
+
+  endGpu(): void {
+    if (!this.gl || !this.timerExt || !this.activeQuery) return;
+    this.gl.endQuery(this.timerExt.TIME_ELAPSED_EXT);
+    this.pendingQueries.push(this.activeQuery);
+    this.activeQuery = null;
+  }
+
+  /**
+   * Finish the frame: compute its total and record a spike if it blew the budget
+   */
+  endFrame(): void {
+    if (!this.enabled) return;
+    this.endPhase();
+
+    const slot = this.frame % this.capacity;
+    const base = slot * PHASE_COUNT;
+    let total = 0;
+    let worst = 0;
+    for (let i = 0; i < PHASE_COUNT; i++) {
+      total += this.samples[base + i];
+      if (this.samples[base + i] > this.samples[base + worst]) worst = i;
+    }
+    this.totals[slot] = total;
+
+    if (total > FRAME_BUDGET_MS) {
+      this.spikes.unshift({
+        frame: this.frame,
+        totalMs: total,
+        worstPhase: FRAME_PHASES[worst],
+        worstPhaseMs: this.samples[base + worst],
+      });
+      if (this.spikes.length > MAX_SPIKES) this.spikes.pop();
+    }
+
+    this.frame++;
+  }
+
+  /**
+   * Percentiles over the ring buffer window
+   */
+  getStats(): FrameProfilerStats {
+    const count = Math.min(this.frame, this.capacity);
+    const scratch = new Float32Array(count);
+
+    const phases = {} as Record<FramePhase, PhaseStats>;
+    FRAME_PHASES.forEach((phase, phaseIndex) => {
+      for (let i = 0; i < count; i++) scratch[i] = this.samples[i * PHASE_COUNT + phaseIndex];
+      phases[phase] = computeStats(scratch, count);
+    });
+
+    scratch.set(this.totals.subarray(0, count));
+    const total = computeStats(scratch, count);
+
+    let gpu: PhaseStats | null = null;
+    if (this.timerExt) {
+      let gpuCount = 0;
+      for (let i = 0; i < count; i++) {
+        if (!Number.isNaN(this.gpuSamples[i])) scratch[gpuCount++] = this.gpuSamples[i];
+      }
+      gpu = computeStats(scratch, gpuCount);
+    }
+
+    // Drop spikes that have left the window
+    const oldestFrame = this.frame - count;
+    return {
+      frameCount: count,
+      budgetMs: FRAME_BUDGET_MS,
+      total,
+      phases,
+      gpu,
+      spikes: this.spikes.filter(spike => spike.frame >= oldestFrame),
+    };
+  }
+
+  /**
+   * Copy the most recent frames (oldest first) for graphing
+   */
+  getHistory(maxFrames: number = this.capacity): FrameHistory {
+    const frameCount = Math.min(this.frame, this.capacity, maxFrames);
+    const samples = new Float32Array(frameCount * PHASE_COUNT);
+    const gpu = new Float32Array(frameCount);
+    const first = this.frame - frameCount;
+
+    for (let i = 0; i < frameCount; i++) {
+      const slot = (first + i) % this.capacity;
+      samples.set(this.samples.subarray(slot * PHASE_COUNT, (slot + 1) * PHASE_COUNT), i * PHASE_COUNT);
+      gpu[i] = this.gpuSamples[slot];
+    }
+
+    return { phases: [...FRAME_PHASES], samples, gpu, frameCount };
+  }
+
+  /**
+   * Clear all recorded data
+   */
+  reset(): void {
+    this.samples.fill(0);
+    this.totals.fill(0);
+    this.gpuSamples.fill(NaN);
+    this.spikes = [];
+    this.frame = 0;
+  }
+
+  dispose(): void {
+    if (this.gl) {
+      this.pendingQueries.forEach(({ query }) => this.gl!.deleteQuery(query));
+      this.freeQueries.forEach(query => this.gl!.deleteQuery(query));
+      if (this.activeQuery) this.gl.deleteQuery(this.activeQuery.query);
+    }
+    this.pendingQueries = [];
+    this.freeQueries = [];
+    this.activeQuery = null;
+    this.gl = null;
+    this.timerExt = null;
+  }
+
+  private closePhase(now: number): void {
+    if (this.currentPhase < 0) return;
+    const slot = this.frame % this.capacity;
+    // Accumulate: a phase may be entered more than once per frame
+    this.samples[slot * PHASE_COUNT + this.currentPhase] += now - this.phaseStart;
+  }
+
+  /**
+   * Poll finished GPU queries (results arrive a few frames late)
+   */
+  private collectGpuResults(): void {
+    if (!this.gl || !this.timerExt || this.pendingQueries.length === 0) return;
+    const gl = this.gl;
+
+    // A disjoint event (e.g. GPU frequency change) invalidates all in-flight results
+    const disjoint = gl.getParameter(this.timerExt.GPU_DISJOINT_EXT);
+
+    while (this.pendingQueries.length > 0) {
+      const pending = this.pendingQueries[0];
+      if (!disjoint && !gl.getQueryParameter(pending.query, gl.QUERY_RESULT_AVAILABLE)) break;
+      this.pendingQueries.shift();
+
+      // Ignore results for frames that were already overwritten in the ring buffer
+      if (!disjoint && this.frame - pending.frame < this.capacity) {
+        const nanoseconds = gl.getQueryParameter(pending.query, gl.QUERY_RESULT) as number;
+        this.gpuSamples[pending.frame % this.capacity] = nanoseconds / 1e6;
+      }
+      this.freeQueries.push(pending.query);
+    }
+  }
+}
+
+/**
+ * Sort the first `count` values in place and read percentiles
+ */
+function computeStats(values: Float32Array, count: number): PhaseStats {
+  if (count === 0) return { avg: 0, p50: 0, p95: 0, p99: 0, max: 0 };
+  const sorted = values.subarray(0, count).sort();
+  let sum = 0;
+  for (let i = 0; i < count; i++) sum += sorted[i];
+  const at = (p: number) => sorted[Math.min(count - 1, Math.floor(p * count))];
+  return { avg: sum / count, p50: at(0.5), p95: at(0.95), p99: at(0.99), max: sorted[count - 1] };
+}
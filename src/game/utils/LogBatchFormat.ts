@@ -0,0 +1,79 @@
+/**
+ * Log Batch Format - compact binary encoding of log batches sent to /api/save-logs
+ * Shared by the client transport (see LogTransport) and the API route.
+ *
+ * Layout (little-endian):
+ *   u32 magic "DRDL", u8 version, u32 record count, u32 dropped count (records lost to backpressure)
+ *   per record: u8 level, u32 byte length, UTF-8 text (already formatted, timestamp included)
+ */
+
+export const LOG_BATCH_MAGIC = 0x4c445244; // "DRDL" read as little-endian u32
+export const LOG_BATCH_VERSION = 1;
+
+const HEADER_BYTES = 13;
+const RECORD_HEADER_BYTES = 5;
+
+export interface LogRecord {
+  level: number; // LogLevel
+  text: string;
+}
+
+export interface LogBatch {
+  records: LogRecord[];
+  dropped: number;
+}
+
+/**
+ * Encode a batch of log records
+ */
+export function encodeLogBatch(records: LogRecord[], dropped: number = 0): Uint8Array {
+  const encoder = new TextEncoder();
+  const texts = records.map(record => encoder.encode(record.text));
+  const size = texts.reduce((total, text) => total + RECORD_HEADER_BYTES + text.byteLength, HEADER_BYTES);
+
+  const bytes = new Uint8Array(size);
+  const view = new DataView(bytes.buffer);
+  view.setUint32(0, LOG_BATCH_MAGIC, true);
+  view.setUint8(4, LOG_BATCH_VERSION);
+  view.setUint32(5, records.length, true);
+  view.setUint32(9, dropped, true);
+
+  let offset = HEADER_BYTES;
+  records.forEach((record, i) => {
+    view.setUint8(offset, record.level);
+    view.setUint32(offset + 1, texts[i].byteLength, true);
+    bytes.set(texts[i], offset + RECORD_HEADER_BYTES);
+    offset += RECORD_HEADER_BYTES + texts[i].byteLength;
+  });
+  return bytes;
+}
+
+/**
+ * Decode a batch written by encodeLogBatch (throws on malformed input)
+ */
+export function decodeLogBatch(bytes: Uint8Array): LogBatch {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  if (bytes.byteLength < HEADER_BYTES || view.getUint32(0, true) !== LOG_BATCH_MAGIC) {
+    throw new Error('Not a log batch');
+  }
+  const version = view.getUint8(4);
+  if (version > LOG_BATCH_VERSION) {
+    throw new Error(`Unsupported log batch version ${version}`);
+  }
+
+  const decoder = new TextDecoder();
+  const count = view.getUint32(5, true);
+  const dropped = view.getUint32(9, true);
+  const records: LogRecord[] = new Array(count);
+  let offset = HEADER_BYTES;
+  for (let i = 0; i < count; i++) {
+    if (offset + RECORD_HEADER_BYTES > bytes.byteLength) throw new Error('Truncated log batch');
+    const level = view.getUint8(offset);
+    const length = view.getUint32(offset + 1, true);
+    offset += RECORD_HEADER_BYTES;
+    if (offset + length > bytes.byteLength) throw new Error('Truncated log batch');
+    records[i] = { level, text: decoder.decode(bytes.subarray(offset, offset + length)) };
+    offset += length;
+  }
+  return { records, dropped };
+}
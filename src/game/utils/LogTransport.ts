@@ -0,0 +1,223 @@
+import { LogLevel } from './debug';
+import { encodeLogBatch, type LogRecord } from './LogBatchFormat';
+import { compressBytes } from '../ecs/storage/compression';
+
+export interface LogTransportOptions {
+  endpoint?: string;
+  session: string; // One log file per session
+  capacity?: number; // Ring buffer size (records)
+  flushRecords?: number; // Flush as soon as this many records are waiting
+  flushIntervalMs?: number; // Otherwise flush this long after the first waiting record
+  compress?: boolean;
+}
+
+export interface LogFlushResult {
+  filename: string;
+  path: string;
+  logCount: number;
+}
+
+const DEFAULT_CAPACITY = 4096;
+const DEFAULT_FLUSH_RECORDS = 512;
+const DEFAULT_FLUSH_INTERVAL_MS = 1000;
+const MAX_RETRY_INTERVAL_MS = 30000;
+const BACKPRESSURE_FILL = 0.75; // Above this fill, only warnings and errors are buffered
+const BEACON_MAX_BYTES = 60000; // sendBeacon payload limit is 64 KB
+
+/**
+ * Log Transport - batches log records to /api/save-logs
+ * Records wait in a fixed-size ring buffer and are sent as compact binary batches (gzip when
+ * available) when enough are waiting or the flush interval passes. One request is in flight at
+ * a time; while it is, records accumulate, and past 75% fill trace/debug/info records are
+ * dropped (counted and reported in the next batch). A full buffer overwrites its oldest record.
+ * A batch the server did not take goes back to the front of the buffer (as far as there is room)
+ * and is resent with exponential backoff.
+ */
+export class LogTransport {
+  private readonly endpoint: string;
+  private readonly session: string;
+  private readonly capacity: number;
+  private readonly flushRecords: number;
+  private readonly flushIntervalMs: number;
+  private readonly compress: boolean;
+
+  private levels: Uint8Array;
+  private texts: Array<string | null>;
+  private head = 0; // Oldest record
+  private count = 0;
+  private dropped = 0;
+
+  private timer: ReturnType<typeof setTimeout> | null = null;
+  private inFlight: Promise<LogFlushResult | null> | null = null;
+  private retryIntervalMs: number;
+
+  constructor(options: LogTransportOptions) {
+    this.endpoint = options.endpoint || '/api/save-logs';
+    this.session = options.session;
+    this.capacity = options.capacity || DEFAULT_CAPACITY;
+    this.flushRecords = Math.min(options.flushRecords || DEFAULT_FLUSH_RECORDS, this.capacity);
+    this.flushIntervalMs = options.flushIntervalMs || DEFAULT_FLUSH_INTERVAL_MS;
+    this.compress = options.compress ?? true;
+    this.retryIntervalMs = this.flushIntervalMs;
+    this.levels = new Uint8Array(this.capacity);
+    this.texts = new Array(this.capacity).fill(null);
+  }
+
+  /**
+   * Buffer one formatted record (never blocks; may drop under backpressure)
+   */
+  push(level: number, text: string): void {
+    if (level < LogLevel.WARN && this.count >= this.capacity * BACKPRESSURE_FILL) {
+      this.dropped++;
+      return;
+    }
+    if (this.count === this.capacity) {
+      this.texts[this.head] = null;
+      this.head = (this.head + 1) % this.capacity;
+      this.count--;
+      this.dropped++;
+    }
+
+    const index = (this.head + this.count) % this.capacity;
+    this.levels[index] = level;
+    this.texts[index] = text;
+    this.count++;
+
+    if (this.count >= this.flushRecords && !this.backingOff) {
+      this.schedule(0);
+    } else {
+      this.schedule(this.retryIntervalMs);
+    }
+  }
+
+  /**
+   * Number of records waiting to be sent
+   */
+  get pending(): number {
+    return this.count;
+  }
+
+  /**
+   * Send the waiting records now (joins the request in flight, if any)
+   */
+  async flush(): Promise<LogFlushResult | null> {
+    while (this.inFlight) {
+      await this.inFlight;
+    }
+    if (this.count === 0 && this.dropped === 0) return null;
+
+    this.clearTimer();
+    this.inFlight = this.send().finally(() => {
+      this.inFlight = null;
+      if (this.count > 0) this.schedule(this.count >= this.flushRecords && !this.backingOff ? 0 : this.retryIntervalMs);
+    });
+    return this.inFlight;
+  }
+
+  /**
+   * Send what fits in one beacon, synchronously (page unload - async compression would not finish)
+   */
+  flushOnUnload(): void {
+    this.clearTimer();
+    if (this.count === 0 || typeof navigator === 'undefined' || !navigator.sendBeacon) return;
+
+    const records: LogRecord[] = [];
+    let bytes = 0;
+    while (this.count > 0 && bytes < BEACON_MAX_BYTES) {
+      const record = this.take();
+      bytes += record.text.length * 3 + 5; // Worst case UTF-8 size
+      records.push(record);
+    }
+    const batch = encodeLogBatch(records, this.dropped);
+    this.dropped = 0;
+    navigator.sendBeacon(this.url(null), new Blob([batch], { type: 'application/octet-stream' }));
+  }
+
+  dispose(): void {
+    this.clearTimer();
+  }
+
+  private async send(): Promise<LogFlushResult | null> {
+    const records: LogRecord[] = [];
+    const batchSize = Math.min(this.count, this.capacity);
+    for (let i = 0; i < batchSize; i++) {
+      records.push(this.take());
+    }
+    const dropped = this.dropped;
+    this.dropped = 0;
+
+    try {
+      const encoded = encodeLogBatch(records, dropped);
+      const { bytes, format } = this.compress ? await compressBytes(encoded) : { bytes: encoded, format: null };
+      const response = await fetch(this.url(format), {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/octet-stream' },
+        body: bytes,
+      });
+      if (!response.ok) {
+        throw new Error(`HTTP ${response.status}`);
+      }
+
+      this.retryIntervalMs = this.flushIntervalMs;
+      return await response.json();
+    } catch {
+      // Keep the batch for the next attempt; back off while the server is unreachable
+      this.requeue(records, dropped);
+      this.retryIntervalMs = Math.min(this.retryIntervalMs * 2, MAX_RETRY_INTERVAL_MS);
+      return null;
+    }
+  }
+
+  /**
+   * Put unsent records back in front of the newer ones (the oldest are dropped when there is no room)
+   */
+  private requeue(records: LogRecord[], dropped: number): void {
+    const kept = Math.min(records.length, this.capacity - this.count);
+    this.dropped += dropped + records.length - kept;
+    for (let i = records.length - 1; i >= records.length - kept; i--) {
+      this.head = (this.head - 1 + this.capacity) % this.capacity;
+      this.levels[this.head] = records[i].level;
+      this.texts[this.head] = records[i].text;
+      this.count++;
+    }
+  }
+
+  private get backingOff(): boolean {
+    return this.retryIntervalMs > this.flushIntervalMs;
+  }
+
+  private take(): LogRecord {
+    const record = { level: this.levels[this.head], text: this.texts[this.head] || '' };
+    this.texts[this.head] = null;
+    this.head = (this.head + 1) % this.capacity;
+    this.count--;
+    return record;
+  }
+
+  private schedule(delayMs: number): void {
+    if (this.inFlight) return; // Rescheduled when the request completes
+    if (this.timer !== null) {
+      if (delayMs > 0) return;
+      clearTimeout(this.timer);
+    }
+    this.timer = setTimeout(() => {
+      this.timer = null;
+      this.flush().catch(() => {
+        // Failed batches are requeued by send()
+      });
+    }, delayMs);
+  }
+
+  private clearTimer(): void {
+    if (this.timer !== null) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+
+  private url(encoding: string | null): string {
+    const params = new URLSearchParams({ session: this.session });
+    if (encoding) params.set('encoding', encoding);
+    return `${this.endpoint}?${params.toString()}`;
+  }
+}
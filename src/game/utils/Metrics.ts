@@ -0,0 +1,270 @@
+/**
+ * Metrics - runtime counters, gauges and histograms
+ * Handles are created once (usually at module level) and recorded into directly: recording is a
+ * field update, with no allocation or lookup. Values that are cheaper to read on demand (entity
+ * counts, renderer.info, ...) come from collectors, which run when a snapshot is taken.
+ */
+
+// Histogram buckets (HDR-style, log-linear): values below 16 units get one bucket each, then
+// every power of two is split into 8 linear sub-buckets (relative error <= 12.5%)
+const LINEAR_BUCKETS = 16;
+const SUB_BUCKET_BITS = 3;
+const SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+const MAX_UNITS = 0x7fffffff;
+const BUCKET_COUNT = LINEAR_BUCKETS + (30 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+const DEFAULT_EXPORT_INTERVAL_MS = 10000;
+
+export interface HistogramSnapshot {
+  count: number;
+  sum: number;
+  min: number;
+  max: number;
+  mean: number;
+  p50: number;
+  p90: number;
+  p99: number;
+}
+
+export interface MetricsSnapshot {
+  timestamp: number; // Epoch ms
+  counters: Record<string, number>;
+  gauges: Record<string, number>;
+  histograms: Record<string, HistogramSnapshot>;
+  help: Record<string, string>;
+}
+
+export type MetricsCollector = () => void;
+
+export class Counter {
+  value = 0;
+
+  inc(amount: number = 1): void {
+    this.value += amount;
+  }
+}
+
+export class Gauge {
+  value = 0;
+
+  set(value: number): void {
+    this.value = value;
+  }
+}
+
+/**
+ * Fixed-bucket histogram of non-negative values
+ * Values are stored as integer units of 1/resolution (e.g. resolution 1000 for ms -> µs buckets)
+ */
+export class Histogram {
+  private readonly counts = new Uint32Array(BUCKET_COUNT);
+  private readonly resolution: number;
+  count = 0;
+  sum = 0;
+  min = Infinity;
+  max = 0;
+
+  constructor(resolution: number = 1) {
+    this.resolution = resolution;
+  }
+
+  record(value: number): void {
+    const units = Math.min(Math.max(Math.round(value * this.resolution), 0), MAX_UNITS);
+    this.counts[bucketIndex(units)]++;
+    this.count++;
+    this.sum += value;
+    if (value < this.min) this.min = value;
+    if (value > this.max) this.max = value;
+  }
+
+  /**
+   * Value below which the given fraction of recorded values fall (bucket upper bound, capped at max)
+   */
+  percentile(fraction: number): number {
+    if (this.count === 0) return 0;
+    const rank = Math.max(1, Math.ceil(this.count * fraction));
+    let seen = 0;
+    for (let i = 0; i < BUCKET_COUNT; i++) {
+      seen += this.counts[i];
+      if (seen >= rank) {
+        return Math.min(bucketUpperBound(i) / this.resolution, this.max);
+      }
+    }
+    return this.max;
+  }
+
+  reset(): void {
+    this.counts.fill(0);
+    this.count = 0;
+    this.sum = 0;
+    this.min = Infinity;
+    this.max = 0;
+  }
+
+  snapshot(): HistogramSnapshot {
+    return {
+      count: this.count,
+      sum: this.sum,
+      min: this.count > 0 ? this.min : 0,
+      max: this.max,
+      mean: this.count > 0 ? this.sum / this.count : 0,
+      p50: this.percentile(0.5),
+      p90: this.percentile(0.9),
+      p99: this.percentile(0.99),
+    };
+  }
+}
+
+function bucketIndex(units: number): number {
+  if (units < LINEAR_BUCKETS) return units;
+  const exponent = 31 - Math.clz32(units); // >= 4
+  const shift = exponent - SUB_BUCKET_BITS;
+  return LINEAR_BUCKETS + (exponent - 4) * SUB_BUCKETS + ((units >>> shift) - SUB_BUCKETS);
+}
+
+function bucketUpperBound(index: number): number {
+  if (index < LINEAR_BUCKETS) return index;
+  const exponent = 4 + Math.floor((index - LINEAR_BUCKETS) / SUB_BUCKETS);
+  const top = SUB_BUCKETS + ((index - LINEAR_BUCKETS) % SUB_BUCKETS);
+  return (top + 1) * 2 ** (exponent - SUB_BUCKET_BITS) - 1;
+}
+
+/**
+ * Metrics registry (names use dots: 'ecs.entities', 'idb.transaction_ms')
+ */
+export class Metrics {
+  private static counters: Map<string, Counter> = new Map();
+  private static gauges: Map<string, Gauge> = new Map();
+  private static histograms: Map<string, Histogram> = new Map();
+  private static help: Map<string, string> = new Map();
+  private static collectors: Set<MetricsCollector> = new Set();
+  private static exportTimer: ReturnType<typeof setInterval> | null = null;
+
+  /**
+   * Get or create a counter (monotonic total)
+   */
+  static counter(name: string, help?: string): Counter {
+    return this.getOrCreate(this.counters, name, help, () => new Counter());
+  }
+
+  /**
+   * Get or create a gauge (current value)
+   */
+  static gauge(name: string, help?: string): Gauge {
+    return this.getOrCreate(this.gauges, name, help, () => new Gauge());
+  }
+
+  /**
+   * Get or create a histogram (resolution: buckets per unit, e.g. 1000 for µs precision of ms values)
+   */
+  static histogram(name: string, help?: string, resolution: number = 1000): Histogram {
+    return this.getOrCreate(this.histograms, name, help, () => new Histogram(resolution));
+  }
+
+  /**
+   * Register a function that updates gauges right before each snapshot
+   * @returns Function to unregister it
+   */
+  static addCollector(collector: MetricsCollector): () => void {
+    this.collectors.add(collector);
+    return () => {
+      this.collectors.delete(collector);
+    };
+  }
+
+  /**
+   * Run the collectors and copy every metric's current value
+   */
+  static snapshot(): MetricsSnapshot {
+    this.collectors.forEach((collector) => {
+      try {
+        collector();
+      } catch (error) {
+        console.error('[Metrics] Collector failed:', error);
+      }
+    });
+
+    const snapshot: MetricsSnapshot = { timestamp: Date.now(), counters: {}, gauges: {}, histograms: {}, help: {} };
+    this.counters.forEach((counter, name) => { snapshot.counters[name] = counter.value; });
+    this.gauges.forEach((gauge, name) => { snapshot.gauges[name] = gauge.value; });
+    this.histograms.forEach((histogram, name) => { snapshot.histograms[name] = histogram.snapshot(); });
+    this.help.forEach((text, name) => { snapshot.help[name] = text; });
+    return snapshot;
+  }
+
+  /**
+   * Human-readable snapshot (optionally only metrics whose name starts with a prefix)
+   */
+  static format(prefix: string = ''): string {
+    const snapshot = this.snapshot();
+    const lines: string[] = [];
+    const matches = (name: string) => name.startsWith(prefix);
+
+    Object.keys(snapshot.counters).filter(matches).sort().forEach((name) => {
+      lines.push(`${name} = ${snapshot.counters[name]}`);
+    });
+    Object.keys(snapshot.gauges).filter(matches).sort().forEach((name) => {
+      lines.push(`${name} = ${round(snapshot.gauges[name])}`);
+    });
+    Object.keys(snapshot.histograms).filter(matches).sort().forEach((name) => {
+      const h = snapshot.histograms[name];
+      lines.push(`${name}: n=${h.count} mean=${round(h.mean)} p50=${round(h.p50)} p90=${round(h.p90)} p99=${round(h.p99)} max=${round(h.max)}`);
+    });
+    return lines.join('\n');
+  }
+
+  /**
+   * Reset counters and histograms (gauges keep their current value)
+   */
+  static reset(): void {
+    this.counters.forEach(counter => { counter.value = 0; });
+    this.histograms.forEach(histogram => histogram.reset());
+  }
+
+  /**
+   * Send a snapshot to /api/metrics (served there as JSON or Prometheus text)
+   */
+  static async push(session: string): Promise<void> {
+    const response = await fetch(`/api/metrics?session=${encodeURIComponent(session)}`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify(this.snapshot()),
+    });
+    if (!response.ok) {
+      throw new Error(`Failed to export metrics (HTTP ${response.status})`);
+    }
+  }
+
+  /**
+   * Push a snapshot periodically
+   */
+  static startExport(session: string, intervalMs: number = DEFAULT_EXPORT_INTERVAL_MS): void {
+    if (this.exportTimer) return;
+    this.exportTimer = setInterval(() => {
+      this.push(session).catch(() => {
+        // Dev server unreachable - the next interval retries
+      });
+    }, intervalMs);
+  }
+
+  static stopExport(): void {
+    if (this.exportTimer) {
+      clearInterval(this.exportTimer);
+      this.exportTimer = null;
+    }
+  }
+
+  private static getOrCreate<T>(map: Map<string, T>, name: string, help: string | undefined, create: () => T): T {
+    let metric = map.get(name);
+    if (!metric) {
+      metric = create();
+      map.set(name, metric);
+    }
+    if (help) this.help.set(name, help);
+    return metric;
+  }
+}
+
+function round(value: number): number {
+  return Math.round(value * 100) / 100;
+}
@@ -0,0 +1,242 @@
+/**
+ * Chrome trace event (https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU)
+ * Loads in chrome://tracing, Perfetto (ui.perfetto.dev) and speedscope
+ */
+export interface ChromeTraceEvent {
+  name: string;
+  cat: string;
+  ph: string;
+  ts: number; // Microseconds since the page started (performance.now)
+  pid: number;
+  tid: number;
+  dur?: number;
+  id?: number;
+  args?: Record<string, number>;
+}
+
+export interface ChromeTrace {
+  traceEvents: ChromeTraceEvent[];
+  displayTimeUnit: 'ms';
+  otherData: Record<string, string | number>;
+}
+
+// Event phases (index = code stored in the buffer)
+const PHASES = ['B', 'E', 'X', 'C', 'b', 'e', 'i'] as const;
+const PHASE_BEGIN = 0;
+const PHASE_END = 1;
+const PHASE_COMPLETE = 2;
+const PHASE_COUNTER = 3;
+const PHASE_ASYNC_BEGIN = 4;
+const PHASE_ASYNC_END = 5;
+const PHASE_INSTANT = 6;
+
+const DEFAULT_CAPACITY = 65536; // Events (~2.4 MB of typed arrays)
+const PID = 1;
+const TID = 1;
+
+/**
+ * Tracer - timeline events (scopes, counters, async spans) for chrome://tracing / Perfetto
+ * Events are recorded into preallocated typed arrays used as a ring buffer (the oldest events are
+ * overwritten when full), so recording allocates nothing. Names are interned in a string table.
+ * Records by default in development builds; start()/stop() control it at runtime.
+ */
+export class Tracer {
+  private static recording = process.env.NODE_ENV === 'development';
+  private static capacity = DEFAULT_CAPACITY;
+  private static phases: Uint8Array | null = null;
+  private static timestamps: Float64Array; // Microseconds
+  private static values: Float64Array; // Duration (X, microseconds) or counter value (C)
+  private static names: Uint32Array;
+  private static categories: Uint32Array;
+  private static ids: Uint32Array;
+  private static next = 0; // Events written so far (index = next % capacity)
+
+  private static strings: string[] = [];
+  private static stringIds: Map<string, number> = new Map();
+  private static nextAsyncId = 1;
+  private static openSpans: Map<number, { name: number; category: number }> = new Map();
+
+  /**
+   * Check if events are being recorded (guard expensive event arguments with it)
+   */
+  static get isRecording(): boolean {
+    return this.recording;
+  }
+
+  /**
+   * Start recording (a new capacity clears the buffer)
+   */
+  static start(capacity: number = this.capacity): void {
+    if (capacity !== this.capacity) {
+      this.capacity = capacity;
+      this.phases = null;
+      this.next = 0;
+    }
+    this.recording = true;
+  }
+
+  static stop(): void {
+    this.recording = false;
+  }
+
+  /**
+   * Drop all recorded events
+   */
+  static clear(): void {
+    this.next = 0;
+    this.openSpans.clear();
+  }
+
+  /**
+   * Number of events in the buffer
+   */
+  static get eventCount(): number {
+    return Math.min(this.next, this.capacity);
+  }
+
+  /**
+   * Begin a synchronous scope (close it with end() - scopes must nest)
+   */
+  static begin(name: string, category: string = 'game'): void {
+    if (this.recording) this.record(PHASE_BEGIN, name, category, 0, 0);
+  }
+
+  static end(name: string, category: string = 'game'): void {
+    if (this.recording) this.record(PHASE_END, name, category, 0, 0);
+  }
+
+  /**
+   * Run a function inside a scope
+   */
+  static scope<T>(name: string, category: string, fn: () => T): T {
+    if (!this.recording) return fn();
+    this.record(PHASE_BEGIN, name, category, 0, 0);
+    try {
+      return fn();
+    } finally {
+      this.record(PHASE_END, name, category, 0, 0);
+    }
+  }
+
+  /**
+   * Record a finished span (times from performance.now(), ms)
+   */
+  static complete(name: string, category: string, startMs: number, durationMs: number): void {
+    if (this.recording) this.record(PHASE_COMPLETE, name, category, durationMs * 1000, 0, startMs);
+  }
+
+  /**
+   * Record a counter value (drawn as a graph track)
+   */
+  static counter(name: string, value: number, category: string = 'game'): void {
+    if (this.recording) this.record(PHASE_COUNTER, name, category, value, 0);
+  }
+
+  static instant(name: string, category: string = 'game'): void {
+    if (this.recording) this.record(PHASE_INSTANT, name, category, 0, 0);
+  }
+
+  /**
+   * Begin an async span (may overlap other spans, e.g. across awaits)
+   * @returns Span ID for asyncEnd (0 when not recording)
+   */
+  static asyncBegin(name: string, category: string = 'game'): number {
+    if (!this.recording) return 0;
+    const id = this.nextAsyncId++;
+    this.openSpans.set(id, { name: this.intern(name), category: this.intern(category) });
+    this.record(PHASE_ASYNC_BEGIN, name, category, 0, id);
+    return id;
+  }
+
+  static asyncEnd(id: number): void {
+    const span = this.openSpans.get(id);
+    if (!span) return;
+    this.openSpans.delete(id);
+    if (this.recording) this.recordIds(PHASE_ASYNC_END, span.name, span.category, 0, id, performance.now());
+  }
+
+  /**
+   * Export the buffer as Chrome trace-event JSON (oldest event first)
+   */
+  static toChromeTrace(): ChromeTrace {
+    const traceEvents: ChromeTraceEvent[] = [];
+    const count = this.eventCount;
+    const first = this.next - count;
+
+    for (let n = first; n < this.next; n++) {
+      const i = n % this.capacity;
+      const phase = this.phases![i];
+      const event: ChromeTraceEvent = {
+        name: this.strings[this.names[i]],
+        cat: this.strings[this.categories[i]],
+        ph: PHASES[phase],
+        ts: this.timestamps[i],
+        pid: PID,
+        tid: TID,
+      };
+      if (phase === PHASE_COMPLETE) event.dur = this.values[i];
+      if (phase === PHASE_COUNTER) event.args = { value: this.values[i] };
+      if (phase === PHASE_ASYNC_BEGIN || phase === PHASE_ASYNC_END) event.id = this.ids[i];
+      traceEvents.push(event);
+    }
+
+    return {
+      traceEvents,
+      displayTimeUnit: 'ms',
+      otherData: {
+        timeOrigin: performance.timeOrigin, // Epoch ms of ts 0
+        droppedEvents: Math.max(0, this.next - this.capacity),
+      },
+    };
+  }
+
+  /**
+   * Write the trace to logs/ through the save-logs route (open the file in ui.perfetto.dev)
+   */
+  static async save(session: string): Promise<{ filename: string; path: string; eventCount: number }> {
+    const response = await fetch(`/api/save-logs?kind=trace&session=${encodeURIComponent(session)}`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify(this.toChromeTrace()),
+    });
+    if (!response.ok) {
+      throw new Error(`Failed to save trace (HTTP ${response.status})`);
+    }
+    return response.json();
+  }
+
+  private static record(phase: number, name: string, category: string, value: number, id: number, startMs?: number): void {
+    this.recordIds(phase, this.intern(name), this.intern(category), value, id, startMs ?? performance.now());
+  }
+
+  private static recordIds(phase: number, name: number, category: number, value: number, id: number, timeMs: number): void {
+    if (!this.phases) this.allocate();
+    const i = this.next % this.capacity;
+    this.phases![i] = phase;
+    this.timestamps[i] = timeMs * 1000;
+    this.values[i] = value;
+    this.names[i] = name;
+    this.categories[i] = category;
+    this.ids[i] = id;
+    this.next++;
+  }
+
+  private static intern(text: string): number {
+    let id = this.stringIds.get(text);
+    if (id === undefined) {
+      id = this.strings.length;
+      this.strings.push(text);
+      this.stringIds.set(text, id);
+    }
+    return id;
+  }
+
+  private static allocate(): void {
+    this.phases = new Uint8Array(this.capacity);
+    this.timestamps = new Float64Array(this.capacity);
+    this.values = new Float64Array(this.capacity);
+    this.names = new Uint32Array(this.capacity);
+    this.categories = new Uint32Array(this.capacity);
+    this.ids = new Uint32Array(this.capacity);
+  }
+}
@@ -1,14 +1,64 @@
+import { LogTransport, type LogFlushResult } from './LogTransport';
+import { Tracer } from './Tracer';
+
 /**
  * Debug utility for logging and performance monitoring
- * Captures all console output and provides file download functionality
+ * Captures all console output and streams it to a log file (see LogTransport)
+ */
+
+declare const __DRD_LOG_LEVEL__: number | undefined; // Defined by next.config.js (DRD_LOG_LEVEL)
+declare const __DRD_LOG_CATEGORIES__: string | undefined; // Defined by next.config.js (DRD_LOG_CATEGORIES)
+
+export const LogLevel = {
+  TRACE: 0,
+  DEBUG: 1,
+  INFO: 2,
+  WARN: 3,
+  ERROR: 4,
+  OFF: 5,
+} as const;
+export type LogLevel = typeof LogLevel[keyof typeof LogLevel];
+
+export type LogMessage = string | (() => string); // Pass a function to build the text only when it is logged
+
+const LEVEL_LABELS = ['TRACE', '', 'INFO', 'WARN', 'ERROR', ''];
+const LOG_TRIM_CHUNK = 1000;
+
+/**
+ * Lowest level compiled into this build: debug in development, warn in production (override with DRD_LOG_LEVEL)
  */
+export const BUILD_LOG_LEVEL: number = typeof __DRD_LOG_LEVEL__ === 'number'
+  ? __DRD_LOG_LEVEL__
+  : process.env.NODE_ENV === 'development' ? LogLevel.DEBUG : LogLevel.WARN;
 
-const DEBUG_ENABLED = process.env.NODE_ENV === 'development';
+// Build-time constants - guard hot call sites with them (`if (LOG_TRACE) Debug.trace(...)`)
+// so the minifier removes the call and its arguments from builds that leave the level out
+export const LOG_TRACE = BUILD_LOG_LEVEL <= LogLevel.TRACE;
+export const LOG_DEBUG = BUILD_LOG_LEVEL <= LogLevel.DEBUG;
+export const LOG_INFO = BUILD_LOG_LEVEL <= LogLevel.INFO;
+
+/**
+ * Per-category levels from the build configuration ("Physics=warn,EntityManager=trace")
+ */
+function parseCategoryLevels(config: string): Map<string, LogLevel> {
+  const levels = new Map<string, LogLevel>();
+  config.split(',').forEach((entry) => {
+    const [category, name] = entry.split('=').map(part => part.trim());
+    const level = LogLevel[(name || '').toUpperCase() as keyof typeof LogLevel];
+    if (category && level !== undefined) levels.set(category, level);
+  });
+  return levels;
+}
 
 export class Debug {
+  private static level: LogLevel = BUILD_LOG_LEVEL as LogLevel;
+  private static categoryLevels: Map<string, LogLevel> = parseCategoryLevels(
+    typeof __DRD_LOG_CATEGORIES__ === 'string' ? __DRD_LOG_CATEGORIES__ : ''
+  );
   private static logs: string[] = [];
   private static maxLogs = 10000; // Increased to capture more logs
   private static performanceMetrics: Map<string, number[]> = new Map();
+  private static measureStarts: Map<string, number> = new Map(); // Open measurements (label -> start time)
   private static consoleIntercepted = false;
   private static originalConsole: {
     log: typeof console.log;
@@ -16,7 +66,8 @@ export class Debug {
     warn: typeof console.warn;
     info: typeof console.info;
   } | null = null;
-  private static lastSavedIndex = 0; // Track how many logs have been saved
+  private static transport: LogTransport | null = null;
+  private static historyStreamed = false; // Entries from before the stream started were sent
   private static sessionStartTime = new Date().toISOString().replace(/[:.]/g, '-'); // Session-based filename
 
   /**
@@ -68,7 +119,7 @@ export class Debug {
   /**
    * Add a log entry with proper formatting
    */
-  private static addLog(level: string, args: unknown[]): void {
+  private static addLog(level: keyof typeof LogLevel | 'LOG', args: unknown[]): void {
     const timestamp = new Date().toISOString();
     
     // Format arguments into a string
@@ -87,75 +138,96 @@ export class Debug {
     }).join(' ');
 
     const logMessage = `[${timestamp}] [${level}] ${formattedArgs}`;
-    
-    this.logs.push(logMessage);
-    if (this.logs.length > this.maxLogs) {
-      this.logs.shift();
+    this.store(level === 'LOG' ? LogLevel.DEBUG : LogLevel[level], logMessage);
+  }
+
+  /**
+   * Keep a formatted entry in the history and hand it to the log stream
+   */
+  private static store(level: LogLevel, message: string): void {
+    this.logs.push(message);
+    // Trimmed in chunks - shifting a full history on every entry is O(n)
+    if (this.logs.length > this.maxLogs + LOG_TRIM_CHUNK) {
+      this.logs.splice(0, this.logs.length - this.maxLogs);
     }
+    this.transport?.push(level, message);
   }
 
   /**
-   * Log a debug message
+   * Set the runtime log level (levels compiled out of the build stay off)
    */
-  static log(category: string, message: string, ...args: unknown[]): void {
-    if (!DEBUG_ENABLED) return;
+  static setLevel(level: LogLevel): void {
+    this.level = level;
+  }
 
-    const timestamp = new Date().toISOString();
-    
-    // Format all arguments into a string
-    const formattedArgs = args.length > 0 ? ' ' + args.map(arg => {
-      if (arg instanceof Error) {
-        return `${arg.message}\n${arg.stack || ''}`;
-      }
-      if (typeof arg === 'object' && arg !== null) {
-        try {
-          return JSON.stringify(arg, null, 2);
-        } catch {
-          return String(arg);
-        }
-      }
-      return String(arg);
-    }).join(' ') : '';
-    
-    const logMessage = `[${timestamp}] [${category}] ${message}${formattedArgs}`;
-    
-    if (this.originalConsole) {
-      this.originalConsole.log(`[${timestamp}] [${category}] ${message}`, ...args);
+  static getLevel(): LogLevel {
+    return this.level;
+  }
+
+  /**
+   * Override the level of one category (null goes back to the global level)
+   */
+  static setCategoryLevel(category: string, level: LogLevel | null): void {
+    if (level === null) {
+      this.categoryLevels.delete(category);
     } else {
-      console.log(`[${timestamp}] [${category}] ${message}`, ...args);
-    }
-    
-    this.logs.push(logMessage);
-    if (this.logs.length > this.maxLogs) {
-      this.logs.shift();
+      this.categoryLevels.set(category, level);
     }
   }
 
+  /**
+   * Check if a message would be logged (use to skip building expensive log arguments)
+   */
+  static isEnabled(level: LogLevel, category: string): boolean {
+    return level >= BUILD_LOG_LEVEL && level >= (this.categoryLevels.get(category) ?? this.level);
+  }
+
+  /**
+   * Log a trace message (per-frame and per-component detail)
+   */
+  static trace(category: string, message: LogMessage, ...args: unknown[]): void {
+    if (LOG_TRACE) this.write(LogLevel.TRACE, category, message, args);
+  }
+
+  /**
+   * Log a debug message
+   */
+  static log(category: string, message: LogMessage, ...args: unknown[]): void {
+    if (LOG_DEBUG) this.write(LogLevel.DEBUG, category, message, args);
+  }
+
+  /**
+   * Log an informational message
+   */
+  static info(category: string, message: LogMessage, ...args: unknown[]): void {
+    if (LOG_INFO) this.write(LogLevel.INFO, category, message, args);
+  }
+
   /**
    * Log an error
    */
-  static error(category: string, message: string, error?: Error): void {
-    const timestamp = new Date().toISOString();
-    const logMessage = `[${timestamp}] [ERROR] [${category}] ${message}${error ? `\n${error.message}\n${error.stack || ''}` : ''}`;
-    
-    if (this.originalConsole) {
-      this.originalConsole.error(logMessage, error);
-    } else {
-      console.error(logMessage, error);
-    }
-    
-    this.logs.push(logMessage);
-    if (this.logs.length > this.maxLogs) {
-      this.logs.shift();
-    }
+  static error(category: string, message: LogMessage, error?: Error): void {
+    this.write(LogLevel.ERROR, category, message, error ? [error] : []);
   }
 
   /**
    * Log a warning
    */
-  static warn(category: string, message: string, ...args: unknown[]): void {
+  static warn(category: string, message: LogMessage, ...args: unknown[]): void {
+    this.write(LogLevel.WARN, category, message, args);
+  }
+
+  /**
+   * Format, print and store one message (nothing is formatted when the level or category is filtered out)
+   */
+  private static write(level: LogLevel, category: string, message: LogMessage, args: unknown[]): void {
+    if (!this.isEnabled(level, category)) return;
+
     const timestamp = new Date().toISOString();
-    
+    const text = typeof message === 'function' ? message() : message;
+    const label = LEVEL_LABELS[level];
+    const prefix = label ? `[${timestamp}] [${label}] [${category}] ${text}` : `[${timestamp}] [${category}] ${text}`;
+
     // Format all arguments into a string
     const formattedArgs = args.length > 0 ? ' ' + args.map(arg => {
       if (arg instanceof Error) {
@@ -170,59 +242,56 @@ export class Debug {
       }
       return String(arg);
     }).join(' ') : '';
-    
-    const logMessage = `[${timestamp}] [WARN] [${category}] ${message}${formattedArgs}`;
-    
-    if (this.originalConsole) {
-      this.originalConsole.warn(`[${timestamp}] [WARN] [${category}] ${message}`, ...args);
+
+    const output = this.originalConsole || console;
+    if (level >= LogLevel.ERROR) {
+      output.error(prefix, ...args);
+    } else if (level === LogLevel.WARN) {
+      output.warn(prefix, ...args);
     } else {
-      console.warn(`[${timestamp}] [WARN] [${category}] ${message}`, ...args);
-    }
-    
-    this.logs.push(logMessage);
-    if (this.logs.length > this.maxLogs) {
-      this.logs.shift();
+      output.log(prefix, ...args);
     }
+
+    this.store(level, prefix + formattedArgs);
   }
 
   /**
    * Start performance measurement
    */
   static startMeasure(label: string): void {
-    if (!DEBUG_ENABLED) return;
-    performance.mark(`${label}-start`);
+    if (!LOG_DEBUG) return;
+    this.measureStarts.set(label, performance.now());
   }
 
   /**
-   * End performance measurement and log
+   * End performance measurement and log (also recorded as a trace span, see Tracer)
    */
   static endMeasure(label: string): void {
-    if (!DEBUG_ENABLED) return;
-    
-    try {
-      performance.mark(`${label}-end`);
-      performance.measure(label, `${label}-start`, `${label}-end`);
-      
-      const measure = performance.getEntriesByName(label)[0];
-      const duration = measure.duration;
-      
-      if (!this.performanceMetrics.has(label)) {
-        this.performanceMetrics.set(label, []);
-      }
-      const metrics = this.performanceMetrics.get(label)!;
-      metrics.push(duration);
-      
-      // Keep only last 60 measurements
-      if (metrics.length > 60) {
-        metrics.shift();
-      }
-      
-      // Log if duration is significant
-      if (duration > 16) { // More than one frame at 60fps
-        this.warn('Performance', `${label} took ${duration.toFixed(2)}ms`);
-      }
-    } catch (error) {
-      this.error('Performance', `Failed to measure ${label}`, error as Error);
+    if (!LOG_DEBUG) return;
+
+    const start = this.measureStarts.get(label);
+    if (start === undefined) {
+      this.warn('Performance', `endMeasure(${label}) without startMeasure`);
+      return;
+    }
+    this.measureStarts.delete(label);
+    const duration = performance.now() - start;
+    Tracer.complete(label, 'measure', start, duration);
+
+    if (!this.performanceMetrics.has(label)) {
+      this.performanceMetrics.set(label, []);
+    }
+    const metrics = this.performanceMetrics.get(label)!;
+    metrics.push(duration);
+
+    // Keep only last 60 measurements
+    if (metrics.length > 60) {
+      metrics.shift();
+    }
+
+    // Log if duration is significant
+    if (duration > 16) { // More than one frame at 60fps
+      this.warn('Performance', `${label} took ${duration.toFixed(2)}ms`);
     }
   }
 
@@ -241,7 +310,7 @@ export class Debug {
    * Get all logs
    */
   static getLogs(): string[] {
-    return [...this.logs];
+    return this.logs.slice(-this.maxLogs);
   }
 
   /**
@@ -249,90 +318,66 @@ export class Debug {
    */
   static clearLogs(): void {
     this.logs = [];
+    this.historyStreamed = false;
     this.performanceMetrics.clear();
-    this.lastSavedIndex = 0;
     this.sessionStartTime = new Date().toISOString().replace(/[:.]/g, '-');
   }
 
   /**
-   * Get new logs since last save
+   * Get session start time for consistent filename
    */
-  static getNewLogs(): string[] {
-    return this.logs.slice(this.lastSavedIndex);
+  static getSessionStartTime(): string {
+    return this.sessionStartTime;
   }
 
   /**
-   * Mark logs as saved (used internally after successful save)
+   * Start streaming logs to a file in the project folder (logs/game-logs-<session>.txt)
+   * Entries logged so far are sent with the first batch.
    */
-  static markLogsAsSaved(count: number): void {
-    this.lastSavedIndex = Math.min(this.lastSavedIndex + count, this.logs.length);
+  static startLogStream(): void {
+    if (this.transport) return;
+    this.transport = new LogTransport({ session: this.sessionStartTime });
+    if (!this.historyStreamed) {
+      this.historyStreamed = true;
+      this.getLogs().forEach(message => this.transport!.push(LogLevel.INFO, message));
+    }
   }
 
   /**
-   * Get session start time for consistent filename
+   * Stop streaming logs (remaining entries are sent with a beacon)
    */
-  static getSessionStartTime(): string {
-    return this.sessionStartTime;
+  static stopLogStream(): void {
+    this.transport?.flushOnUnload();
+    this.transport?.dispose();
+    this.transport = null;
   }
 
   /**
-   * Save logs to a file in the project folder
-   * Sends logs to the API endpoint which writes them to logs/ directory
-   * @param append - If true, only saves new logs and appends to existing file
+   * Send buffered entries now, as one beacon (for page unload, where async requests may not complete)
    */
-  static async saveLogs(append: boolean = false): Promise<void> {
-    const logsToSave = append ? this.getNewLogs() : this.logs;
-    
-    if (logsToSave.length === 0) {
-      return; // Silently return if no new logs
-    }
-
-    try {
-      const response = await fetch('/api/save-logs', {
-        method: 'POST',
-        headers: {
-          'Content-Type': 'application/json',
-        },
-        body: JSON.stringify({
-          logs: logsToSave,
-          append,
-          sessionStartTime: this.sessionStartTime,
-        }),
-      });
-
-      if (!response.ok) {
-        const errorData = await response.json();
-        throw new Error(errorData.message || 'Failed to save logs');
-      }
+  static flushLogsOnUnload(): void {
+    this.transport?.flushOnUnload();
+  }
 
-      const result = await response.json();
-      
-      // Mark logs as saved
-      if (append) {
-        this.markLogsAsSaved(logsToSave.length);
-      } else {
-        this.lastSavedIndex = this.logs.length;
-      }
-      
-      if (this.originalConsole && !append) {
-        // Only log when doing full save (not periodic appends)
-        this.originalConsole.log(`[Debug] Saved ${result.logCount} log entries to ${result.filename}`);
-        this.originalConsole.log(`[Debug] File location: ${result.path}`);
-      }
-    } catch (error) {
-      if (this.originalConsole) {
-        this.originalConsole.error('[Debug] Failed to save logs', error);
-      } else {
-        console.error('[Debug] Failed to save logs', error);
-      }
+  /**
+   * Save logs to a file in the project folder
+   * Flushes the log stream (started if needed) and reports where the file is
+   */
+  static async saveLogs(): Promise<LogFlushResult | null> {
+    this.startLogStream();
+    const result = await this.transport!.flush();
+    if (result && this.originalConsole) {
+      this.originalConsole.log(`[Debug] Saved ${result.logCount} log entries to ${result.filename}`);
+      this.originalConsole.log(`[Debug] File location: ${result.path}`);
     }
+    return result;
   }
 
   /**
    * Get logs as a string (for programmatic access)
    */
   static getLogsAsString(): string {
-    return this.logs.join('\n');
+    return this.getLogs().join('\n');
   }
 
   /**
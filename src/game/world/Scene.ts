@@ -6,7 +6,7 @@ import { CharacterController } from '../physics/CharacterController';
 import { SouffranceHealthSystem } from '../character/SouffranceHealthSystem';
 import { Souffrance, getSouffranceName, getResistanceCompetenceName } from '../character/data/SouffranceData';
 import { Competence, getCompetenceName } from '../character/data/CompetenceData';
-import { Debug } from '../utils/debug';
+import { Debug, LOG_DEBUG, LOG_TRACE } from '../utils/debug';
 import { getEventLog, EventType } from '../utils/EventLog';
 
 /**
@@ -348,11 +348,13 @@ export class Scene {
     const body = this.physicsBodies.get(mesh);
     if (!body) {
       // No physics body for this mesh - that's fine for editor-created objects
-      Debug.log('Scene', `No physics body found for mesh: ${mesh.name || '(unnamed)'}`, {
-        meshName: mesh.name || '(unnamed)',
-        meshType: mesh.type,
-        physicsBodiesCount: this.physicsBodies.size,
-      });
+      if (LOG_TRACE) {
+        Debug.trace('Scene', () => `No physics body found for mesh: ${mesh.name || '(unnamed)'}`, {
+          meshName: mesh.name || '(unnamed)',
+          meshType: mesh.type,
+          physicsBodiesCount: this.physicsBodies.size,
+        });
+      }
       return;
     }
 
@@ -369,13 +371,15 @@ export class Scene {
         true // wake up the body
       );
 
-      Debug.log('Scene', `Updated physics body for mesh: ${mesh.name || '(unnamed)'}`, {
-        meshName: mesh.name || '(unnamed)',
-        newPosition: { x: mesh.position.x, y: mesh.position.y, z: mesh.position.z },
-        newRotation: { x: mesh.quaternion.x, y: mesh.quaternion.y, z: mesh.quaternion.z, w: mesh.quaternion.w },
-        bodyType: body.bodyType(),
-        hasPhysicsBody: true,
-      });
+      if (LOG_TRACE) {
+        Debug.trace('Scene', () => `Updated physics body for mesh: ${mesh.name || '(unnamed)'}`, {
+          meshName: mesh.name || '(unnamed)',
+          newPosition: { x: mesh.position.x, y: mesh.position.y, z: mesh.position.z },
+          newRotation: { x: mesh.quaternion.x, y: mesh.quaternion.y, z: mesh.quaternion.z, w: mesh.quaternion.w },
+          bodyType: body.bodyType(),
+          hasPhysicsBody: true,
+        });
+      }
     } catch (error) {
       Debug.error('Scene', `Failed to update physics body for mesh: ${mesh.name || '(unnamed)'}`, error as Error);
     }
@@ -480,17 +484,18 @@ export class Scene {
           
           // Note: Events are now logged in SouffranceHealthSystem.applySouffranceFromFailure
           // No need to duplicate them here
-          const souffranceName = getSouffranceName(platform.souffrance);
-          Debug.log('Scene', `Character on ${souffranceName} platform - applied ${applied.toFixed(1)} DS (total: ${afterDegree.toFixed(1)} DS)`);
+          if (LOG_DEBUG) {
+            Debug.log('Scene', () => `Character on ${getSouffranceName(platform.souffrance)} platform - applied ${applied.toFixed(1)} DS (total: ${afterDegree.toFixed(1)} DS)`);
+          }
         }
-      } else if (horizontalDistance < 3.0) {
+      } else if (LOG_TRACE && horizontalDistance < 3.0) {
           // Debug log occasionally to help troubleshoot when very close
           // Only log once per 2 seconds max per platform to avoid spam
           const debugKey = platform.souffrance;
           const lastDebugTime = this.lastDebugLogTime.get(debugKey) || 0;
           if (currentTime - lastDebugTime >= 2000) {
             const souffranceName = getSouffranceName(platform.souffrance);
-            Debug.log('Scene', `Near ${souffranceName} platform: hDist=${horizontalDistance.toFixed(2)}, charY=${characterPos.y.toFixed(2)}, feetY=${capsuleBottomY.toFixed(2)}, platY=${platformPos.y.toFixed(2)}, platTop=${platformTopY.toFixed(2)}, platBot=${platformBottomY.toFixed(2)}, inBounds=${isWithinBounds}, onHeight=${isOnPlatformHeight}, isOn=${isOnPlatform}`);
+            Debug.trace('Scene', `Near ${souffranceName} platform: hDist=${horizontalDistance.toFixed(2)}, charY=${characterPos.y.toFixed(2)}, feetY=${capsuleBottomY.toFixed(2)}, platY=${platformPos.y.toFixed(2)}, platTop=${platformTopY.toFixed(2)}, platBot=${platformBottomY.toFixed(2)}, inBounds=${isWithinBounds}, onHeight=${isOnPlatformHeight}, isOn=${isOnPlatform}`);
             this.lastDebugLogTime.set(debugKey, currentTime);
           }
         }
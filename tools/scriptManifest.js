@@ -0,0 +1,74 @@
+/**
+ * Script manifest generator
+ * Lists every script module under src/game/scripts/<folder>/ in src/game/scripts/manifest.ts, so
+ * ScriptLoader imports scripts through static loaders (one chunk per script) instead of a
+ * template-literal import that bundles all of src/game as one dynamic context.
+ * Runs from next.config.js on every dev/build start; `npm run scripts:manifest` regenerates it
+ * after adding a script while the dev server is running.
+ */
+const fs = require('fs');
+const path = require('path');
+
+const SCRIPTS_DIR = path.join(__dirname, '..', 'src', 'game', 'scripts');
+const MANIFEST_FILE = path.join(SCRIPTS_DIR, 'manifest.ts');
+const SCRIPT_EXTENSIONS = ['.ts', '.tsx'];
+
+/**
+ * Script paths ("scripts/triggers/door") of the modules in the script folders, sorted
+ */
+function findScripts() {
+  const scripts = [];
+  const visit = (dir) => {
+    fs.readdirSync(dir, { withFileTypes: true }).forEach((entry) => {
+      const file = path.join(dir, entry.name);
+      if (entry.isDirectory()) {
+        visit(file);
+      } else if (SCRIPT_EXTENSIONS.includes(path.extname(entry.name)) && !entry.name.endsWith('.d.ts')) {
+        const relative = path.relative(SCRIPTS_DIR, file).split(path.sep).join('/');
+        scripts.push(relative.slice(0, -path.extname(relative).length));
+      }
+    });
+  };
+  // Only subfolders hold scripts - the top level is the script runtime itself
+  fs.readdirSync(SCRIPTS_DIR, { withFileTypes: true })
+    .filter(entry => entry.isDirectory())
+    .forEach(entry => visit(path.join(SCRIPTS_DIR, entry.name)));
+  return scripts.sort();
+}
+
+function renderManifest(scripts) {
+  const entries = scripts.map(script => `  'scripts/${script}': () => import('./${script}'),`);
+  return [
+    '// Generated by tools/scriptManifest.js - do not edit',
+    "import type { ScriptModule } from './types';",
+    '',
+    '/**',
+    ' * Loaders for every script module, keyed by script path (relative to src/game/)',
+    ' */',
+    'export const SCRIPT_MANIFEST: Record<string, () => Promise<ScriptModule>> = {',
+    ...entries,
+    '};',
+    '',
+  ].join('\n');
+}
+
+/**
+ * Write the manifest when its contents changed (an unchanged file keeps the dev server from rebuilding)
+ * @returns Number of scripts listed
+ */
+function writeScriptManifest() {
+  const scripts = findScripts();
+  const contents = renderManifest(scripts);
+  const current = fs.existsSync(MANIFEST_FILE) ? fs.readFileSync(MANIFEST_FILE, 'utf-8') : null;
+  if (current !== contents) {
+    fs.writeFileSync(MANIFEST_FILE, contents);
+  }
+  return scripts.length;
+}
+
+module.exports = { writeScriptManifest };
+
+if (require.main === module) {
+  const count = writeScriptManifest();
+  console.log(`Script manifest: ${count} scripts -> ${path.relative(process.cwd(), MANIFEST_FILE)}`);
+}